@@ -40,6 +40,10 @@ METRIC_DEFINE_histogram(
 METRIC_DEFINE_histogram(
     server, handler_latency_yb_client_read_local, "yb.client.Read local call time",
     yb::MetricUnit::kMicroseconds, "Microseconds spent in the local Read call ", 60000000LU, 2);
+METRIC_DEFINE_histogram(
+    server, handler_latency_yb_client_multi_read_remote, "yb.client.MultiRead remote call time",
+    yb::MetricUnit::kMicroseconds, "Microseconds spent in the remote MultiRead call ", 60000000LU,
+    2);
 METRIC_DEFINE_histogram(
     server, handler_latency_yb_client_time_to_send,
     "Time taken for a Write/Read rpc to be sent to the server", yb::MetricUnit::kMicroseconds,
@@ -74,6 +78,8 @@ AsyncRpcMetrics::AsyncRpcMetrics(const scoped_refptr<yb::MetricEntity>& entity)
       remote_read_rpc_time(METRIC_handler_latency_yb_client_read_remote.Instantiate(entity)),
       local_write_rpc_time(METRIC_handler_latency_yb_client_write_local.Instantiate(entity)),
       local_read_rpc_time(METRIC_handler_latency_yb_client_read_local.Instantiate(entity)),
+      remote_multi_read_rpc_time(
+          METRIC_handler_latency_yb_client_multi_read_remote.Instantiate(entity)),
       time_to_send(METRIC_handler_latency_yb_client_time_to_send.Instantiate(entity)) {
 }
 
@@ -217,18 +223,21 @@ AsyncRpcBase<Req, Resp>::AsyncRpcBase(
     : AsyncRpc(batcher, tablet, allow_local_calls_in_curr_thread, ops, consistency_level) {
   req_.set_tablet_id(tablet_invoker_.tablet()->tablet_id());
   req_.set_include_trace(IsTracingEnabled());
+  auto& transaction_metadata = batcher_->transaction_metadata();
   const ConsistentReadPoint* read_point = batcher_->read_point();
   if (read_point) {
     req_.set_propagated_hybrid_time(read_point->Now().ToUint64());
     // Set read time for consistent read only if the table is transaction-enabled.
-    if (table()->InternalSchema().table_properties().is_transactional()) {
+    // Single shard write of transaction is applied as regular write, so tablet picks its own
+    // read time for it.
+    if (table()->InternalSchema().table_properties().is_transactional() &&
+        !(batcher_->transaction() && transaction_metadata.transaction_id.is_nil())) {
       auto read_time = read_point->GetReadTime(tablet_invoker_.tablet()->tablet_id());
       if (read_time) {
         read_time.AddToPB(&req_);
       }
     }
   }
-  auto& transaction_metadata = batcher_->transaction_metadata();
   if (!transaction_metadata.transaction_id.is_nil()) {
     SetTransactionMetadata(transaction_metadata, &req_);
   }
@@ -578,7 +587,7 @@ void ReadRpc::ProcessResponseFromTserver(const Status& status) {
         const auto& ql_response = ql_op->response();
         if (ql_response.has_rows_data_sidecar()) {
           Slice rows_data;
-          CHECK_OK(retrier().controller().GetSidecar(
+          CHECK_OK(ResponseController().GetSidecar(
               ql_response.rows_data_sidecar(), &rows_data));
           ql_op->mutable_rows_data()->assign(util::to_char_ptr(rows_data.data()), rows_data.size());
         }
@@ -597,7 +606,7 @@ void ReadRpc::ProcessResponseFromTserver(const Status& status) {
         const auto& pgsql_response = pgsql_op->response();
         if (pgsql_response.has_rows_data_sidecar()) {
           Slice rows_data;
-          CHECK_OK(retrier().controller().GetSidecar(
+          CHECK_OK(ResponseController().GetSidecar(
               pgsql_response.rows_data_sidecar(), &rows_data));
           down_cast<YBPgsqlReadOp*>(yb_op)->mutable_rows_data()->assign(
               util::to_char_ptr(rows_data.data()), rows_data.size());
@@ -628,6 +637,96 @@ void ReadRpc::ProcessResponseFromTserver(const Status& status) {
   }
 }
 
+void ReadRpc::FinishedAsPartOfMultiRead(const rpc::RpcController& multi_read_controller) {
+  TRACE_TO(trace_, "Received as part of MultiRead");
+  multi_read_controller_ = &multi_read_controller;
+  ProcessResponseFromTserver(Status::OK());
+  multi_read_controller_ = nullptr;
+  batcher_->RemoveInFlightOpsAfterFlushing(ops_, Status::OK(), PropagatedHybridTime());
+  batcher_->CheckForFinishedFlush();
+}
+
+const rpc::RpcController& ReadRpc::ResponseController() const {
+  return multi_read_controller_ ? *multi_read_controller_ : retrier().controller();
+}
+
+MultiReadRpc::MultiReadRpc(
+    const scoped_refptr<Batcher>& batcher, RemoteTabletServer* tserver,
+    std::vector<std::shared_ptr<ReadRpc>> reads)
+    : Rpc(batcher->deadline(), batcher->messenger(), &batcher->proxy_cache()),
+      batcher_(batcher),
+      tserver_(tserver),
+      reads_(std::move(reads)) {
+  // Move the read requests into the MultiRead request. Will restore in Finished.
+  for (auto& read : reads_) {
+    req_.add_reads()->Swap(read->mutable_req());
+  }
+}
+
+MultiReadRpc::~MultiReadRpc() {
+  const auto& async_rpc_metrics = batcher_->async_rpc_metrics();
+  if (async_rpc_metrics && start_.Initialized()) {
+    async_rpc_metrics->remote_multi_read_rpc_time->Increment(
+        MonoTime::Now().GetDeltaSince(start_).ToMicroseconds());
+  }
+}
+
+void MultiReadRpc::SendRpc() {
+  retained_self_ = shared_from_this();
+
+  auto status = tserver_->InitProxy(batcher_->client_);
+  if (!status.ok()) {
+    Finished(status);
+    return;
+  }
+
+  start_ = MonoTime::Now();
+  tserver_->RpcStarted();
+  tserver_->proxy()->MultiReadAsync(
+      req_, &resp_, PrepareController(),
+      std::bind(&MultiReadRpc::Finished, this, Status::OK()));
+}
+
+std::string MultiReadRpc::ToString() const {
+  return Format("MultiRead(tserver: $0, num_reads: $1, num_attempts: $2)",
+                tserver_->permanent_uuid(), reads_.size(), num_attempts());
+}
+
+void MultiReadRpc::Finished(const Status& status) {
+  Status new_status = status;
+  if (new_status.ok()) {
+    tserver_->RpcFinished(MonoTime::Now().GetDeltaSince(start_));
+    new_status = retrier().controller().status();
+  }
+  if (new_status.ok() && resp_.has_error()) {
+    new_status = StatusFromPB(resp_.error().status());
+  }
+  if (new_status.ok() && static_cast<size_t>(resp_.reads_size()) != reads_.size()) {
+    new_status = STATUS_FORMAT(IllegalState, "MultiRead response count mismatch: $0 vs $1",
+                               resp_.reads_size(), reads_.size());
+  }
+  if (!new_status.ok()) {
+    YB_LOG_EVERY_N_SECS(INFO, 10) << ToString() << " failed, sending the reads separately: "
+                                  << new_status;
+  }
+
+  for (size_t i = 0; i != reads_.size(); ++i) {
+    auto& read = reads_[i];
+    read->mutable_req()->Swap(req_.mutable_reads(i));
+    if (new_status.ok() && !resp_.reads(i).has_error()) {
+      read->resp().Swap(resp_.mutable_reads(i));
+      read->FinishedAsPartOfMultiRead(retrier().controller());
+    } else {
+      VLOG(2) << read->ToString() << " is sent separately: "
+              << (new_status.ok() ? resp_.reads(i).error().ShortDebugString()
+                                  : new_status.ToString());
+      read->SendRpc();
+    }
+  }
+  reads_.clear();
+  retained_self_.reset();
+}
+
 }  // namespace internal
 }  // namespace client
 }  // namespace yb
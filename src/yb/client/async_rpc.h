@@ -41,6 +41,7 @@ struct AsyncRpcMetrics {
   scoped_refptr<Histogram> remote_read_rpc_time;
   scoped_refptr<Histogram> local_write_rpc_time;
   scoped_refptr<Histogram> local_read_rpc_time;
+  scoped_refptr<Histogram> remote_multi_read_rpc_time;
   scoped_refptr<Histogram> time_to_send;
 };
 
@@ -116,6 +117,8 @@ class AsyncRpcBase : public AsyncRpc {
   const Resp& resp() const { return resp_; }
   Resp& resp() { return resp_; }
 
+  Req* mutable_req() { return &req_; }
+
  protected:
   // Returns `true` if caller should continue processing response, `false` otherwise.
   bool CommonResponseCheck(const Status& status);
@@ -155,9 +158,49 @@ class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadRespons
 
   virtual ~ReadRpc();
 
+  // Completes this read with the response received as part of the multi-tablet read sent with
+  // the given controller, instead of sending the read on its own.
+  void FinishedAsPartOfMultiRead(const rpc::RpcController& multi_read_controller);
+
  private:
   void CallRemoteMethod() override;
   void ProcessResponseFromTserver(const Status& status) override;
+
+  // Controller of the call that received the response, used to get the sidecars of the response.
+  const rpc::RpcController& ResponseController() const;
+
+  // Set if the response was received as part of a multi-tablet read.
+  const rpc::RpcController* multi_read_controller_ = nullptr;
+};
+
+// Reads from several tablets whose leaders are on the same tablet server, with a single MultiRead
+// call to that server instead of one Read call per tablet.
+//
+// The requests of the reads are moved into the MultiRead request, and back once the response
+// arrives. Every read that succeeded is completed with its part of the response. Reads that failed,
+// e.g. because the leader has moved, and all the reads if the whole call failed, are sent again on
+// their own, which retries them in the regular way.
+class MultiReadRpc : public rpc::Rpc {
+ public:
+  MultiReadRpc(
+      const scoped_refptr<Batcher>& batcher, RemoteTabletServer* tserver,
+      std::vector<std::shared_ptr<ReadRpc>> reads);
+
+  virtual ~MultiReadRpc();
+
+  void SendRpc() override;
+  std::string ToString() const override;
+
+ private:
+  void Finished(const Status& status) override;
+
+  scoped_refptr<Batcher> batcher_;
+  RemoteTabletServer* const tserver_;
+  std::vector<std::shared_ptr<ReadRpc>> reads_;
+  tserver::MultiReadRequestPB req_;
+  tserver::MultiReadResponsePB resp_;
+  MonoTime start_;
+  rpc::RpcCommandPtr retained_self_;
 };
 
 }  // namespace internal
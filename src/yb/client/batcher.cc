@@ -58,6 +58,8 @@
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 
+#include "yb/rpc/outbound_call.h"
+
 #include "yb/util/debug-util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
@@ -68,6 +70,13 @@ DEFINE_bool(redis_allow_reads_from_followers, false,
 TAG_FLAG(redis_allow_reads_from_followers, evolving);
 TAG_FLAG(redis_allow_reads_from_followers, runtime);
 
+DEFINE_bool(client_multi_tablet_read, true,
+            "If true, leader reads of a batch from several tablets whose leaders are on the same "
+            "remote tablet server are sent to it with a single MultiRead call, instead of a "
+            "separate Read call per tablet.");
+TAG_FLAG(client_multi_tablet_read, advanced);
+TAG_FLAG(client_multi_tablet_read, runtime);
+
 using std::pair;
 using std::set;
 using std::unique_ptr;
@@ -472,19 +481,63 @@ void Batcher::FlushBuffersIfReady() {
   });
 
   // Now flush the ops for each tablet.
+  MultiReads multi_reads;
+  auto* multi_reads_ptr = FLAGS_client_multi_tablet_read ? &multi_reads : nullptr;
   auto start = ops.begin();
   auto start_group = GetOpGroup(*start);
   for (auto it = start; it != ops.end(); ++it) {
     auto it_group = GetOpGroup(*it);
     if ((**it).tablet.get() != (**start).tablet.get() || start_group != it_group) {
       FlushBuffer(
-          start->get()->tablet.get(), start, it, /* allow_local_calls_in_curr_thread */ false);
+          start->get()->tablet.get(), start, it, /* allow_local_calls_in_curr_thread */ false,
+          multi_reads_ptr);
       start = it;
       start_group = it_group;
     }
   }
 
-  FlushBuffer(start->get()->tablet.get(), start, ops.end(), allow_local_calls_in_curr_thread_);
+  FlushBuffer(start->get()->tablet.get(), start, ops.end(), allow_local_calls_in_curr_thread_,
+              multi_reads_ptr);
+
+  SendMultiReads(&multi_reads);
+}
+
+void Batcher::SendMultiReads(MultiReads* multi_reads) {
+  // Every QL and PGSQL read returns its rows in a sidecar, and the number of sidecars in a
+  // response is limited.
+  auto num_sidecars = [](const ReadRpc& read) -> size_t {
+    return std::count_if(read.ops().begin(), read.ops().end(), [](const InFlightOpPtr& op) {
+      return op->yb_op->type() != YBOperation::Type::REDIS_READ;
+    });
+  };
+  constexpr size_t kMaxSidecars = rpc::CallResponse::kMaxSidecarSlices;
+
+  for (auto& tserver_and_reads : *multi_reads) {
+    auto& reads = tserver_and_reads.second;
+    auto it = reads.begin();
+    while (it != reads.end()) {
+      auto begin = it;
+      size_t sidecars = 0;
+      while (it != reads.end()) {
+        const size_t read_sidecars = num_sidecars(**it);
+        if (it != begin && sidecars + read_sidecars > kMaxSidecars) {
+          break;
+        }
+        sidecars += read_sidecars;
+        ++it;
+      }
+      // A read that does not fit in a MultiRead with others is sent on its own.
+      if (it - begin == 1) {
+        (**begin).SendRpc();
+        continue;
+      }
+      VLOG(3) << "Sending " << it - begin << " reads with MultiRead to "
+              << tserver_and_reads.first->ToString();
+      std::make_shared<MultiReadRpc>(
+          this, tserver_and_reads.first, std::vector<std::shared_ptr<ReadRpc>>(begin, it))
+          ->SendRpc();
+    }
+  }
 }
 
 const std::shared_ptr<rpc::Messenger>& Batcher::messenger() const {
@@ -501,7 +554,7 @@ YBTransactionPtr Batcher::transaction() const {
 
 void Batcher::FlushBuffer(
     RemoteTablet* tablet, InFlightOps::const_iterator begin, InFlightOps::const_iterator end,
-    const bool allow_local_calls_in_curr_thread) {
+    const bool allow_local_calls_in_curr_thread, MultiReads* multi_reads) {
   VLOG(3) << "FlushBuffersIfReady: already in flushing state, immediately flushing to "
           << tablet->tablet_id();
 
@@ -523,10 +576,19 @@ void Batcher::FlushBuffer(
       rpc = std::make_shared<WriteRpc>(
           this, tablet, allow_local_calls_in_curr_thread, std::move(ops));
       break;
-    case OpGroup::kLeaderRead:
-      rpc =
+    case OpGroup::kLeaderRead: {
+      auto read =
           std::make_shared<ReadRpc>(this, tablet, allow_local_calls_in_curr_thread, std::move(ops));
+      if (multi_reads && !read->table()->name().is_system()) {
+        auto* leader = tablet->LeaderTServer();
+        if (leader && !leader->IsLocal()) {
+          (*multi_reads)[leader].push_back(std::move(read));
+          return;
+        }
+      }
+      rpc = std::move(read);
       break;
+    }
     case OpGroup::kConsistentPrefixRead:
       rpc = std::make_shared<ReadRpc>(
           this, tablet, allow_local_calls_in_curr_thread, std::move(ops),
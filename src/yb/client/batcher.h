@@ -157,6 +157,7 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   friend class AsyncRpc;
   friend class WriteRpc;
   friend class ReadRpc;
+  friend class MultiReadRpc;
 
   ~Batcher();
 
@@ -182,9 +183,20 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
 
   void CheckForFinishedFlush();
   void FlushBuffersIfReady();
+
+  // Reads to be sent with MultiRead calls, grouped by the tablet server of the tablet leaders.
+  typedef std::unordered_map<RemoteTabletServer*, std::vector<std::shared_ptr<ReadRpc>>>
+      MultiReads;
+
+  // Sends the given ops of the tablet. If multi_reads is specified, leader reads that could be
+  // sent as part of a MultiRead call are added there instead.
   void FlushBuffer(
       RemoteTablet* tablet, InFlightOps::const_iterator begin, InFlightOps::const_iterator end,
-      const bool allow_local_calls_in_curr_thread);
+      const bool allow_local_calls_in_curr_thread, MultiReads* multi_reads = nullptr);
+
+  // Sends the reads collected by FlushBuffer, reads from several tablets of the same tablet
+  // server together.
+  void SendMultiReads(MultiReads* multi_reads);
 
   // Calls/Schedules flush_callback_ and resets it to free resources.
   void RunCallback(const Status& s);
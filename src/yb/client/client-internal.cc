@@ -60,6 +60,7 @@
 #include "yb/master/master.pb.h"
 #include "yb/master/master.proxy.h"
 #include "yb/yql/redis/redisserver/redis_constants.h"
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/tserver/tserver_flags.h"
@@ -68,6 +69,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/thread_restrictions.h"
 
 DEFINE_test_flag(bool, assert_local_tablet_server_selected, false, "Verify that SelectTServer "
@@ -77,8 +79,38 @@ DEFINE_test_flag(bool, assert_local_tablet_server_selected, false, "Verify that
 DEFINE_test_flag(string, assert_tablet_server_select_is_in_zone, "", "Verify that SelectTServer "
                  "selected a talet server in the AZ specified by this flag.");
 
+DEFINE_bool(client_latency_aware_replica_selection, true,
+            "When several replicas of a tablet are equally close to the client, read from the "
+            "less loaded of two random ones, based on their observed RPC latency and number of "
+            "RPCs in flight, instead of a random one.");
+TAG_FLAG(client_latency_aware_replica_selection, advanced);
+TAG_FLAG(client_latency_aware_replica_selection, runtime);
+
 DECLARE_string(flagfile);
 
+METRIC_DEFINE_counter(
+    server, yb_client_replica_selection_local_tserver,
+    "Closest replica selections of the local tablet server", yb::MetricUnit::kRequests,
+    "Number of times the YB client picked the replica on the local tablet server");
+METRIC_DEFINE_counter(
+    server, yb_client_replica_selection_same_zone,
+    "Closest replica selections in the same zone", yb::MetricUnit::kRequests,
+    "Number of times the YB client picked a replica in its own placement zone");
+METRIC_DEFINE_counter(
+    server, yb_client_replica_selection_same_region,
+    "Closest replica selections in the same region", yb::MetricUnit::kRequests,
+    "Number of times the YB client picked a replica in its own placement region but in "
+    "another zone");
+METRIC_DEFINE_counter(
+    server, yb_client_replica_selection_remote,
+    "Closest replica selections outside of the region", yb::MetricUnit::kRequests,
+    "Number of times the YB client picked a replica outside of its own placement region");
+METRIC_DEFINE_counter(
+    server, yb_client_replica_selection_less_loaded,
+    "Closest replica selections of a less loaded replica", yb::MetricUnit::kRequests,
+    "Number of times the YB client picked the less loaded of two equally close replicas "
+    "over its first random choice");
+
 namespace yb {
 
 using std::set;
@@ -324,34 +356,7 @@ RemoteTabletServer* YBClient::Data::SelectTServer(RemoteTablet* rt,
           ret = filtered[0];
         }
       } else if (selection == CLOSEST_REPLICA) {
-        // Choose the closest replica.
-        bool local_zone_ts = false;
-        for (RemoteTabletServer* rts : filtered) {
-          if (IsTabletServerLocal(*rts)) {
-            ret = rts;
-            // If the tserver is local, we are done here.
-            break;
-          } else if (cloud_info_pb_.has_placement_zone() && rts->cloud_info().has_placement_zone()
-              && cloud_info_pb_.placement_zone() == rts->cloud_info().placement_zone()) {
-            // Note down that we have found a zone local tserver and continue looking for node
-            // local tserver.
-            ret = rts;
-            local_zone_ts = true;
-          } else if (cloud_info_pb_.has_placement_region() &&
-              rts->cloud_info().has_placement_region() &&
-              cloud_info_pb_.placement_region() == rts->cloud_info().placement_region() &&
-              !local_zone_ts) {
-            // Look for a region local tserver only if we haven't found a zone local tserver yet.
-            ret = rts;
-          }
-        }
-
-        // If ret is not null here, it should point to the closest replica from the client.
-
-        // Fallback to a random replica if none are local.
-        if (ret == nullptr && !filtered.empty()) {
-          ret = filtered[rand() % filtered.size()];
-        }
+        ret = SelectClosestTServer(filtered);
       }
       break;
     }
@@ -380,6 +385,83 @@ RemoteTabletServer* YBClient::Data::SelectTServer(RemoteTablet* rt,
   return ret;
 }
 
+namespace {
+
+void IncrementCounter(const scoped_refptr<Counter>& counter) {
+  if (counter) {
+    counter->Increment();
+  }
+}
+
+} // namespace
+
+RemoteTabletServer* YBClient::Data::SelectClosestTServer(
+    const vector<RemoteTabletServer*>& replicas) {
+  // Group the replicas by distance from the client. If the tserver is local, we are done here.
+  vector<RemoteTabletServer*> same_zone;
+  vector<RemoteTabletServer*> same_region;
+  for (RemoteTabletServer* rts : replicas) {
+    if (IsTabletServerLocal(*rts)) {
+      IncrementCounter(replica_selection_local_);
+      return rts;
+    }
+    if (cloud_info_pb_.has_placement_zone() && rts->cloud_info().has_placement_zone() &&
+        cloud_info_pb_.placement_zone() == rts->cloud_info().placement_zone()) {
+      same_zone.push_back(rts);
+    } else if (cloud_info_pb_.has_placement_region() &&
+               rts->cloud_info().has_placement_region() &&
+               cloud_info_pb_.placement_region() == rts->cloud_info().placement_region()) {
+      same_region.push_back(rts);
+    }
+  }
+
+  const vector<RemoteTabletServer*>* closest;
+  if (!same_zone.empty()) {
+    closest = &same_zone;
+    IncrementCounter(replica_selection_same_zone_);
+  } else if (!same_region.empty()) {
+    closest = &same_region;
+    IncrementCounter(replica_selection_same_region_);
+  } else if (!replicas.empty()) {
+    closest = &replicas;
+    IncrementCounter(replica_selection_remote_);
+  } else {
+    return nullptr;
+  }
+
+  // Power of two choices: compare the load of two distinct random replicas and take the less
+  // loaded one. This spreads the reads among equally close replicas while steering them away from
+  // a slow or busy tablet server, without the herding of always picking the least loaded one.
+  const size_t size = closest->size();
+  const size_t first = RandomUniformInt<size_t>(0, size - 1);
+  if (size == 1 || !FLAGS_client_latency_aware_replica_selection) {
+    return (*closest)[first];
+  }
+  const size_t second = (first + RandomUniformInt<size_t>(1, size - 1)) % size;
+  if ((*closest)[second]->LoadScore() < (*closest)[first]->LoadScore()) {
+    IncrementCounter(replica_selection_less_loaded_);
+    return (*closest)[second];
+  }
+  return (*closest)[first];
+}
+
+void YBClient::Data::InitMetrics() {
+  const auto& metric_entity = messenger_->metric_entity();
+  if (!metric_entity) {
+    return;
+  }
+  replica_selection_local_ =
+      METRIC_yb_client_replica_selection_local_tserver.Instantiate(metric_entity);
+  replica_selection_same_zone_ =
+      METRIC_yb_client_replica_selection_same_zone.Instantiate(metric_entity);
+  replica_selection_same_region_ =
+      METRIC_yb_client_replica_selection_same_region.Instantiate(metric_entity);
+  replica_selection_remote_ =
+      METRIC_yb_client_replica_selection_remote.Instantiate(metric_entity);
+  replica_selection_less_loaded_ =
+      METRIC_yb_client_replica_selection_less_loaded.Instantiate(metric_entity);
+}
+
 Status YBClient::Data::GetTabletServer(YBClient* client,
                                          const scoped_refptr<RemoteTablet>& rt,
                                          ReplicaSelection selection,
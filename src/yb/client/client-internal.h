@@ -46,6 +46,7 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/util/atomic.h"
 #include "yb/util/locks.h"
+#include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/threadpool.h"
@@ -170,6 +171,15 @@ class YBClient::Data {
       const std::set<std::string>& blacklist,
       std::vector<internal::RemoteTabletServer*>* candidates);
 
+  // Picks the closest of the given replicas: the local tablet server if there is one, otherwise
+  // one in the same zone, then in the same region, then any. When several replicas are equally
+  // close, the less loaded of two random ones is picked (see RemoteTabletServer::LoadScore).
+  internal::RemoteTabletServer* SelectClosestTServer(
+      const std::vector<internal::RemoteTabletServer*>& replicas);
+
+  // Instantiates the metrics of the client in the metric entity of its messenger, if any.
+  void InitMetrics();
+
   // Sets 'master_proxy_' from the address specified by
   // 'leader_master_hostport_'.  Called by
   // GetLeaderMasterRpc::Finished() upon successful completion.
@@ -300,6 +310,14 @@ class YBClient::Data {
 
   std::unique_ptr<ThreadPool> cb_threadpool_;
 
+  // Number of replicas selected by SelectClosestTServer by locality, and number of times the
+  // less loaded of two equally close replicas was picked over the first random choice.
+  scoped_refptr<Counter> replica_selection_local_;
+  scoped_refptr<Counter> replica_selection_same_zone_;
+  scoped_refptr<Counter> replica_selection_same_region_;
+  scoped_refptr<Counter> replica_selection_remote_;
+  scoped_refptr<Counter> replica_selection_less_loaded_;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Data);
 };
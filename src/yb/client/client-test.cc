@@ -79,9 +79,12 @@
 #include "yb/util/thread.h"
 #include "yb/util/tostring.h"
 
+DECLARE_bool(client_latency_aware_replica_selection);
+DECLARE_bool(client_multi_tablet_read);
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_bool(log_inject_latency);
 DECLARE_double(leader_failure_max_missed_heartbeat_periods);
+DECLARE_int32(client_replica_latency_stale_ms);
 DECLARE_int32(heartbeat_interval_ms);
 DECLARE_int32(log_inject_latency_ms_mean);
 DECLARE_int32(log_inject_latency_ms_stddev);
@@ -98,6 +101,7 @@ DECLARE_int32(min_backoff_ms_exponent);
 DECLARE_int32(max_backoff_ms_exponent);
 
 METRIC_DECLARE_counter(rpcs_queue_overflow);
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_MultiRead);
 
 using namespace std::literals; // NOLINT
 using namespace std::placeholders;
@@ -609,6 +613,71 @@ TEST_F(ClientTest, TestScanMultiTablet) {
   CheckCounts(table, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
 }
 
+// Point reads of rows from many tablets in every batch, with and without coalescing the reads from
+// the tablets of the same tablet server into a single MultiRead call.
+TEST_F(ClientTest, MultiTabletReadBenchmark) {
+  constexpr int kNumTablets = 24;
+  constexpr int kNumRows = 480;
+  constexpr int kRowsPerBatch = 24;
+  constexpr int kNumBatches = 200;
+
+  TableHandle table;
+  ASSERT_NO_FATALS(CreateTable(YBTableName("MultiTabletReadBenchmark"), kNumTablets, &table));
+  ASSERT_NO_FATALS(InsertTestRows(table, kNumRows));
+
+  auto num_multi_reads = [this] {
+    uint64_t result = 0;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      result += METRIC_handler_latency_yb_tserver_TabletServerService_MultiRead.Instantiate(
+          cluster_->mini_tablet_server(i)->server()->metric_entity())->TotalCount();
+    }
+    return result;
+  };
+
+  for (bool multi_tablet_read : {false, true}) {
+    FLAGS_client_multi_tablet_read = multi_tablet_read;
+    const auto multi_reads_before = num_multi_reads();
+    auto session = CreateSession();
+    auto start = MonoTime::Now();
+    for (int batch = 0; batch != kNumBatches; ++batch) {
+      std::vector<std::pair<int32_t, std::shared_ptr<YBqlReadOp>>> ops;
+      for (int i = 0; i != kRowsPerBatch; ++i) {
+        int32_t key = (batch * kRowsPerBatch + i) % kNumRows;
+        auto op = table.NewReadOp();
+        auto* const req = op->mutable_request();
+        QLAddInt32HashValue(req, key);
+        table.AddColumns({"key", "int_val"}, req);
+        ASSERT_OK(session->Apply(op));
+        ops.emplace_back(key, op);
+      }
+      ASSERT_OK(session->Flush());
+      for (const auto& key_and_op : ops) {
+        auto* op = key_and_op.second.get();
+        ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, op->response().status());
+        auto rowblock = ql::RowsResult(op).GetRowBlock();
+        ASSERT_EQ(1, rowblock->row_count());
+        ASSERT_EQ(key_and_op.first, rowblock->row(0).column(0).int32_value());
+        ASSERT_EQ(key_and_op.first * 2, rowblock->row(0).column(1).int32_value());
+      }
+    }
+    auto elapsed = MonoTime::Now().GetDeltaSince(start);
+    LOG(INFO) << "Multi tablet read: " << multi_tablet_read << ", " << kNumBatches
+              << " batches of " << kRowsPerBatch << " reads from " << kNumTablets
+              << " tablets took " << elapsed << ", "
+              << elapsed.ToMicroseconds() / kNumBatches << "us per batch";
+
+    const auto multi_reads = num_multi_reads() - multi_reads_before;
+    LOG(INFO) << "MultiRead calls: " << multi_reads;
+    if (multi_tablet_read) {
+      // Every batch reads several tablets of each tablet server.
+      ASSERT_GE(multi_reads, kNumBatches);
+      ASSERT_LT(multi_reads, kNumBatches * kRowsPerBatch);
+    } else {
+      ASSERT_EQ(0, multi_reads);
+    }
+  }
+}
+
 TEST_F(ClientTest, TestScanEmptyTable) {
   TableIteratorOptions options;
   options.columns = std::vector<std::string>();
@@ -742,6 +811,61 @@ TEST_F(ClientTest, TestGetTabletServerBlacklist) {
   }
 }
 
+TEST_F(ClientTest, TestClosestReplicaPrefersLessLoaded) {
+  // Replicas on remote hosts outside of the client's zone and region, so they are equally close.
+  std::vector<std::unique_ptr<internal::RemoteTabletServer>> tservers;
+  vector<internal::RemoteTabletServer*> replicas;
+  for (int i = 0; i != 3; ++i) {
+    master::TSInfoPB pb;
+    pb.set_permanent_uuid(Format("ts-$0", i));
+    auto* addr = pb.add_rpc_addresses();
+    addr->set_host(Format("replica-host-$0.invalid", i));
+    addr->set_port(9100);
+    tservers.emplace_back(new internal::RemoteTabletServer(pb));
+    replicas.push_back(tservers.back().get());
+  }
+
+  // The first replica is much slower than the others.
+  for (int i = 0; i != 3; ++i) {
+    replicas[i]->RpcStarted();
+    replicas[i]->RpcFinished(MonoDelta::FromMilliseconds(i == 0 ? 1000 : 1));
+  }
+  ASSERT_GT(replicas[0]->LoadScore(), replicas[1]->LoadScore());
+
+  constexpr int kSelections = 1000;
+  std::map<internal::RemoteTabletServer*, int> counts;
+  for (int i = 0; i != kSelections; ++i) {
+    ++counts[client_->data_->SelectClosestTServer(replicas)];
+  }
+  // With two distinct random choices out of three, the slow replica always loses.
+  ASSERT_EQ(0, counts[replicas[0]]);
+  ASSERT_GT(counts[replicas[1]], 0);
+  ASSERT_GT(counts[replicas[2]], 0);
+
+  // An RPC in flight makes a replica look busier.
+  for (int i = 0; i != 10; ++i) {
+    replicas[1]->RpcStarted();
+  }
+  ASSERT_GT(replicas[1]->LoadScore(), replicas[2]->LoadScore());
+
+  // Also when latency estimates are stale.
+  FLAGS_client_replica_latency_stale_ms = -1;
+  ASSERT_GT(replicas[1]->LoadScore(), replicas[2]->LoadScore());
+  ASSERT_EQ(replicas[0]->LoadScore(), replicas[2]->LoadScore());
+  FLAGS_client_replica_latency_stale_ms = 10000;
+
+  for (int i = 0; i != 10; ++i) {
+    replicas[1]->RpcFinished(MonoDelta());
+  }
+
+  FLAGS_client_latency_aware_replica_selection = false;
+  counts.clear();
+  for (int i = 0; i != kSelections; ++i) {
+    ++counts[client_->data_->SelectClosestTServer(replicas)];
+  }
+  ASSERT_GT(counts[replicas[0]], 0);
+}
+
 TEST_F(ClientTest, TestScanWithEncodedRangePredicate) {
   TableHandle table;
   ASSERT_NO_FATALS(CreateTable(YBTableName("split-table"),
@@ -327,6 +327,7 @@ Status YBClientBuilder::Build(shared_ptr<YBClient>* client) {
   builder.set_metric_entity(data_->metric_entity_);
   c->data_->messenger_ = VERIFY_RESULT(builder.Build());
   c->data_->proxy_cache_ = std::make_unique<rpc::ProxyCache>(c->data_->messenger_);
+  c->data_->InitMetrics();
 
   c->data_->master_server_endpoint_ = data_->master_server_endpoint_;
   c->data_->master_server_addrs_ = data_->master_server_addrs_;
@@ -501,6 +501,7 @@ class YBClient : public std::enable_shared_from_this<YBClient> {
   friend class internal::TabletInvoker;
   friend class PlacementInfoTest;
 
+  FRIEND_TEST(ClientTest, TestClosestReplicaPrefersLessLoaded);
   FRIEND_TEST(ClientTest, TestGetTabletServerBlacklist);
   FRIEND_TEST(ClientTest, TestMasterDown);
   FRIEND_TEST(ClientTest, TestMasterLookupPermits);
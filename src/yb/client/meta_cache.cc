@@ -60,6 +60,15 @@ using strings::Substitute;
 DEFINE_int32(max_concurrent_master_lookups, 500,
              "Maximum number of concurrent tablet location lookups from YB client to master");
 
+DEFINE_double(client_replica_latency_ewma_weight, 0.2,
+              "Weight of the latest RPC latency in the moving average latency of a tablet server, "
+              "used by the YB client to pick the least loaded replica.");
+
+DEFINE_int32(client_replica_latency_stale_ms, 10000,
+             "Time after which the moving average RPC latency of a tablet server is no longer "
+             "trusted by the YB client, so that a tablet server that was slow once gets probed "
+             "again.");
+
 METRIC_DEFINE_histogram(
   server, dns_resolve_latency_during_init_proxy,
   "yb.client.MetaCache.InitProxy DNS Resolve",
@@ -163,6 +172,38 @@ const CloudInfoPB& RemoteTabletServer::cloud_info() const {
   return cloud_info_pb_;
 }
 
+void RemoteTabletServer::RpcStarted() {
+  rpcs_in_flight_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void RemoteTabletServer::RpcFinished(MonoDelta latency) {
+  rpcs_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+  if (!latency.Initialized()) {
+    return;
+  }
+
+  const double sample = latency.ToMicroseconds();
+  const double weight = FLAGS_client_replica_latency_ewma_weight;
+  double old_value = latency_ewma_us_.load(std::memory_order_acquire);
+  double new_value;
+  do {
+    new_value = old_value == 0 ? sample : old_value + weight * (sample - old_value);
+  } while (!latency_ewma_us_.compare_exchange_weak(old_value, new_value));
+  last_latency_update_us_.store(MonoTime::Now().ToUint64() / MonoTime::kNanosecondsPerMicrosecond,
+                                std::memory_order_release);
+}
+
+double RemoteTabletServer::LoadScore() const {
+  const int64_t now_us = MonoTime::Now().ToUint64() / MonoTime::kNanosecondsPerMicrosecond;
+  const int64_t last_update_us = last_latency_update_us_.load(std::memory_order_acquire);
+  // Stale latency is replaced with the smallest possible one, so the tablet server is probed,
+  // while the number of RPCs in flight still tells apart busy tablet servers.
+  const double latency_us =
+      now_us - last_update_us > FLAGS_client_replica_latency_stale_ms * 1000LL
+          ? 1.0 : latency_ewma_us();
+  return latency_us * (std::max<int64_t>(rpcs_in_flight(), 0) + 1);
+}
+
 shared_ptr<TabletServerServiceProxy> RemoteTabletServer::proxy() const {
   std::lock_guard<simple_spinlock> l(lock_);
   return proxy_;
@@ -33,6 +33,7 @@
 #ifndef YB_CLIENT_META_CACHE_H
 #define YB_CLIENT_META_CACHE_H
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <memory>
@@ -127,6 +128,26 @@ class RemoteTabletServer {
 
   const CloudInfoPB& cloud_info() const;
 
+  // Record that an RPC was sent to this tablet server, and that it completed after the given
+  // latency. An uninitialized latency means that the RPC completion time is unknown. Used to
+  // estimate the load of the tablet server when selecting a replica.
+  void RpcStarted();
+  void RpcFinished(MonoDelta latency);
+
+  // Returns the estimated time in microseconds for this tablet server to serve one more RPC, i.e.
+  // its moving average RPC latency scaled by the number of RPCs in flight. A tablet server without
+  // a recent latency estimate is assumed to have a latency of 1 microsecond, so that it is probed.
+  double LoadScore() const;
+
+  // Moving average of the RPC latency in microseconds. 0 if there is no estimate yet.
+  double latency_ewma_us() const {
+    return latency_ewma_us_.load(std::memory_order_acquire);
+  }
+
+  int64_t rpcs_in_flight() const {
+    return rpcs_in_flight_.load(std::memory_order_acquire);
+  }
+
  private:
   mutable simple_spinlock lock_;
   const std::string uuid_;
@@ -136,6 +157,11 @@ class RemoteTabletServer {
   std::shared_ptr<tserver::TabletServerServiceProxy> proxy_;
   scoped_refptr<Histogram> dns_resolve_histogram_;
 
+  std::atomic<double> latency_ewma_us_{0};
+  std::atomic<int64_t> rpcs_in_flight_{0};
+  // Time of the last latency sample, in MonoTime microseconds.
+  std::atomic<int64_t> last_latency_update_us_{0};
+
   DISALLOW_COPY_AND_ASSIGN(RemoteTabletServer);
 };
 
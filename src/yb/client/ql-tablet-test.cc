@@ -48,6 +48,7 @@ DECLARE_uint64(initial_seqno);
 DECLARE_int32(leader_lease_duration_ms);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_string(time_source);
+DECLARE_bool(tablet_compaction_drop_keys_out_of_partition);
 
 namespace yb {
 namespace client {
@@ -443,6 +444,31 @@ TEST_F(QLTabletTest, GCLogWithRestartWithoutWrites) {
   VerifyLogIndicies(cluster_.get());
 }
 
+// Compactions that drop keys out of the tablet partition keep all rows of a regular multi tablet
+// table.
+TEST_F(QLTabletTest, CompactionKeepsRowsOfAllTablets) {
+  FLAGS_tablet_compaction_drop_keys_out_of_partition = true;
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 9);
+
+  FillTable(0, kTotalKeys, &table);
+  ASSERT_OK(cluster_->FlushTablets());
+
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    std::vector<tablet::TabletPeerPtr> peers;
+    cluster_->mini_tablet_server(i)->server()->tablet_manager()->GetTabletPeers(&peers);
+    for (const auto& peer : peers) {
+      auto tablet = peer->shared_tablet();
+      if (tablet) {
+        tablet->ForceRocksDBCompactInTest();
+      }
+    }
+  }
+
+  VerifyTable(0, kTotalKeys, &table);
+  ASSERT_OK(WaitSync(0, kTotalKeys, &table));
+}
+
 TEST_F(QLTabletTest, LeaderLease) {
   google::FlagSaver saver;
 
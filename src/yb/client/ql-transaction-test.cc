@@ -27,17 +27,22 @@
 #include "yb/yql/cql/ql/util/errcodes.h"
 #include "yb/yql/cql/ql/util/statement_result.h"
 
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/table_properties.h"
+
 #include "yb/rpc/rpc.h"
 
 #include "yb/server/hybrid_clock.h"
 #include "yb/server/skewed_clock.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/transaction_coordinator.h"
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 
 using namespace std::literals; // NOLINT
@@ -58,6 +63,11 @@ DECLARE_uint64(transaction_delay_status_reply_usec_in_tests);
 DECLARE_string(time_source);
 DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_int32(intents_flush_max_delay_ms);
+DECLARE_bool(transaction_single_shard_fast_path);
+DECLARE_bool(apply_intents_with_regular_delete);
+DECLARE_bool(transaction_cleanup_aborted_intents);
+
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_UpdateTransaction);
 
 namespace yb {
 namespace client {
@@ -247,6 +257,56 @@ class QLTransactionTest : public KeyValueTableTest {
     }
   }
 
+  // Calls action for intents DB of each tablet peer of the cluster.
+  template <class F>
+  void ForEachIntentsDB(const F& action) {
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto* tablet_manager = cluster_->mini_tablet_server(i)->server()->tablet_manager();
+      for (const auto& peer : tablet_manager->GetTabletPeers()) {
+        auto* db = peer->tablet()->TEST_intents_db();
+        if (db) {
+          action(db);
+        }
+      }
+    }
+  }
+
+  size_t CountIntents() {
+    size_t result = 0;
+    ForEachIntentsDB([&result](rocksdb::DB* db) {
+      std::unique_ptr<rocksdb::Iterator> iter(db->NewIterator(rocksdb::ReadOptions()));
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+        ++result;
+      }
+    });
+    return result;
+  }
+
+  // Returns number of records, including tombstones, in SST files of intents DBs.
+  size_t CountFlushedIntentRecords() {
+    size_t result = 0;
+    ForEachIntentsDB([&result](rocksdb::DB* db) {
+      rocksdb::TablePropertiesCollection props;
+      CHECK_OK(db->GetPropertiesOfAllTables(&props));
+      for (const auto& entry : props) {
+        result += entry.second->num_entries;
+      }
+    });
+    return result;
+  }
+
+  // Returns number of intents of aborted transactions removed by all tablet peers.
+  size_t CountRemovedIntents() {
+    size_t result = 0;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto* tablet_manager = cluster_->mini_tablet_server(i)->server()->tablet_manager();
+      for (const auto& peer : tablet_manager->GetTabletPeers()) {
+        result += peer->tablet()->metrics()->aborted_transaction_intents_removed->value();
+      }
+    }
+    return result;
+  }
+
   size_t CountTransactions() {
     size_t result = 0;
     for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
@@ -548,6 +608,41 @@ TEST_F(QLTransactionTest, Cleanup) {
   ASSERT_OK(cluster_->RestartSync());
 }
 
+// Measures latency of transactions writing a single row, with and without single shard fast path.
+TEST_F(QLTransactionTest, SingleShardFastPath) {
+  constexpr size_t kTransactions = 100;
+
+  for (bool fast_path : {true, false}) {
+    FLAGS_transaction_single_shard_fast_path = fast_path;
+    // Transactions of fast path should use separate keys.
+    const size_t transaction_offset = fast_path ? 0 : kTransactions;
+    auto start = MonoTime::Now();
+    for (size_t i = 0; i != kTransactions; ++i) {
+      auto txn = CreateTransaction();
+      auto session = CreateSession(txn);
+      txn->ExpectCommitAfterNextFlush();
+      ASSERT_OK(WriteRow(
+          session,
+          KeyForTransactionAndIndex(transaction_offset + i, 0),
+          ValueForTransactionAndIndex(transaction_offset + i, 0, WriteOpType::INSERT)));
+      ASSERT_OK(txn->CommitFuture().get());
+    }
+    auto passed = MonoTime::Now().GetDeltaSince(start);
+    LOG(INFO) << "Fast path: " << fast_path << ", transactions: " << kTransactions
+              << ", avg latency: " << passed.ToMicroseconds() / kTransactions << "us";
+    if (fast_path) {
+      // Status tablet should not know about single shard transactions.
+      ASSERT_EQ(0, CountTransactions());
+    }
+  }
+
+  auto session = CreateSession();
+  for (size_t i = 0; i != kTransactions * 2; ++i) {
+    VERIFY_ROW(session, KeyForTransactionAndIndex(i, 0),
+               ValueForTransactionAndIndex(i, 0, WriteOpType::INSERT));
+  }
+}
+
 TEST_F(QLTransactionTest, Heartbeat) {
   auto txn = CreateTransaction();
   auto session = CreateSession(txn);
@@ -562,6 +657,42 @@ TEST_F(QLTransactionTest, Heartbeat) {
   VerifyData();
 }
 
+// All transactions use the same status tablet, so their heartbeats are sent in shared requests.
+TEST_F(QLTransactionTest, HeartbeatOfManyTransactions) {
+  constexpr size_t kTransactions = 20;
+
+  std::vector<YBTransactionPtr> transactions;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    transactions.push_back(CreateTransaction());
+    ASSERT_NO_FATALS(WriteRows(CreateSession(transactions.back()), i));
+  }
+
+  auto num_update_transaction_rpcs = [this] {
+    uint64_t result = 0;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      result += METRIC_handler_latency_yb_tserver_TabletServerService_UpdateTransaction.Instantiate(
+          cluster_->mini_tablet_server(i)->server()->metric_entity())->TotalCount();
+    }
+    return result;
+  };
+  const auto rpcs_before = num_update_transaction_rpcs();
+  const auto sleep_time = GetTransactionTimeout() * 2;
+  std::this_thread::sleep_for(sleep_time);
+  const auto heartbeat_rpcs = num_update_transaction_rpcs() - rpcs_before;
+  const uint64_t heartbeat_rounds =
+      sleep_time / std::chrono::microseconds(FLAGS_transaction_heartbeat_usec) + 1;
+  LOG(INFO) << "Heartbeat RPCs: " << heartbeat_rpcs << ", rounds: " << heartbeat_rounds;
+  // Without batching every transaction would send its own heartbeat RPC in every round.
+  ASSERT_GT(heartbeat_rpcs, 0);
+  ASSERT_LE(heartbeat_rpcs, heartbeat_rounds * 2);
+  ASSERT_LT(heartbeat_rpcs, heartbeat_rounds * kTransactions / 2);
+
+  for (auto& txn : transactions) {
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+  VerifyData(kTransactions);
+}
+
 TEST_F(QLTransactionTest, Expire) {
   google::FlagSaver flag_saver;
   SetDisableHeartbeatInTests(true);
@@ -1018,6 +1149,49 @@ TEST_F(QLTransactionTest, CorrectStatusRequestBatching) {
   cluster_.reset();
 }
 
+// Status of transactions that use the same status tablet is requested by shared RPCs.
+TEST_F(QLTransactionTest, StatusRequestsOfManyTransactionsCoalesced) {
+  constexpr size_t kTransactions = 20;
+  DisableTransactionTimeout();
+
+  // Pending transactions, each with intents of its own rows.
+  std::vector<YBTransactionPtr> transactions;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    transactions.push_back(CreateTransaction());
+    ASSERT_NO_FATALS(WriteRows(CreateSession(transactions.back()), i));
+  }
+
+  // A single batch writing the rows of all of them resolves its conflicts with all of them at
+  // once, so status of these transactions is requested concurrently.
+  auto session = CreateSession(CreateTransaction());
+  ASSERT_OK(session->SetFlushMode(YBSession::MANUAL_FLUSH));
+  for (size_t i = 0; i != kTransactions; ++i) {
+    for (size_t r = 0; r != kNumRows; ++r) {
+      const auto op = table_.NewWriteOp(QLWriteRequestPB::QL_STMT_INSERT);
+      auto* const req = op->mutable_request();
+      QLAddInt32HashValue(req, KeyForTransactionAndIndex(i, r));
+      table_.AddInt32ColumnValue(req, kValueColumn, 0);
+      ASSERT_OK(session->Apply(op));
+    }
+  }
+  // Either side of a conflict could be aborted, so the result of the write does not matter.
+  WARN_NOT_OK(session->Flush(), "Conflicting write failed");
+
+  uint64_t max_batch_size = 0;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    auto* tablet_manager = cluster_->mini_tablet_server(i)->server()->tablet_manager();
+    for (const auto& peer : tablet_manager->GetTabletPeers()) {
+      if (peer->tablet() && peer->tablet()->metrics()) {
+        max_batch_size = std::max(
+            max_batch_size,
+            peer->tablet()->metrics()->transaction_status_batch_size->MaxValueForTests());
+      }
+    }
+  }
+  LOG(INFO) << "Max transaction status batch size: " << max_batch_size;
+  ASSERT_GT(max_batch_size, 1);
+}
+
 struct TransactionState {
   YBTransactionPtr transaction;
   std::shared_future<TransactionMetadata> metadata_future;
@@ -1032,29 +1206,31 @@ struct TransactionState {
     ASSERT_EQ(status_future.wait_for(NonTsanVsTsan(1s, 5s)), std::future_status::ready);
     auto resp = status_future.get();
     ASSERT_OK(resp);
+    ASSERT_EQ(1, resp->status_size());
+    ASSERT_EQ(1, resp->status_hybrid_time_size());
 
-    if (resp->status() == TransactionStatus::ABORTED) {
+    if (resp->status(0) == TransactionStatus::ABORTED) {
       ASSERT_TRUE(commit_future.valid());
       transaction = nullptr;
       return;
     }
 
-    auto new_time = HybridTime(resp->status_hybrid_time());
+    auto new_time = HybridTime(resp->status_hybrid_time(0));
     if (last_status == TransactionStatus::PENDING) {
-      if (resp->status() == TransactionStatus::PENDING) {
+      if (resp->status(0) == TransactionStatus::PENDING) {
         ASSERT_GE(new_time, status_time);
       } else {
-        ASSERT_EQ(TransactionStatus::COMMITTED, resp->status());
+        ASSERT_EQ(TransactionStatus::COMMITTED, resp->status(0));
         ASSERT_GT(new_time, status_time);
       }
     } else {
       ASSERT_EQ(last_status, TransactionStatus::COMMITTED);
-      ASSERT_EQ(resp->status(), TransactionStatus::COMMITTED)
-          << "Bad transaction status: " << TransactionStatus_Name(resp->status());
+      ASSERT_EQ(resp->status(0), TransactionStatus::COMMITTED)
+          << "Bad transaction status: " << TransactionStatus_Name(resp->status(0));
       ASSERT_EQ(status_time, new_time);
     }
     status_time = new_time;
-    last_status = resp->status();
+    last_status = resp->status(0);
   }
 };
 
@@ -1116,7 +1292,7 @@ TEST_F(QLTransactionTest, StatusEvolution) {
       }
       tserver::GetTransactionStatusRequestPB req;
       req.set_tablet_id(state.metadata.status_tablet);
-      req.set_transaction_id(state.metadata.transaction_id.data,
+      req.add_transaction_id(state.metadata.transaction_id.data,
                              state.metadata.transaction_id.size());
       state.status_future = rpc::WrapRpcFuture<tserver::GetTransactionStatusResponsePB>(
           GetTransactionStatus, &rpcs)(
@@ -1383,6 +1559,183 @@ TEST_F_EX(QLTransactionTest, RemoteBootstrap, RemoteBootstrapTest) {
   }
 }
 
+// Intents of transactions that were applied before flush should not reach disk.
+// Regular delete of applied intents is used as a baseline.
+TEST_F(QLTransactionTest, AppliedIntentsNotFlushed) {
+  constexpr size_t kTransactions = 20;
+
+  // Writes transactions with indexes in [begin, begin + kTransactions), waits until they are
+  // applied, flushes tablets and returns number of intent records added to SST files.
+  auto write_and_flush = [this](size_t begin) -> size_t {
+    auto flushed_before = CountFlushedIntentRecords();
+    auto start = MonoTime::Now();
+    for (size_t i = begin; i != begin + kTransactions; ++i) {
+      WriteData(WriteOpType::INSERT, i);
+    }
+    auto passed = MonoTime::Now().GetDeltaSince(start);
+    LOG(INFO) << "Transactions: " << kTransactions << ", avg latency: "
+              << passed.ToMicroseconds() / kTransactions << "us";
+
+    EXPECT_OK(WaitFor([this] { return CountIntents() == 0; }, kTransactionApplyTime,
+                      "Intents applied"));
+    EXPECT_OK(cluster_->FlushTablets());
+
+    auto flushed_after = CountFlushedIntentRecords();
+    EXPECT_GE(flushed_after, flushed_before);
+    return flushed_after - flushed_before;
+  };
+
+  FLAGS_apply_intents_with_regular_delete = true;
+  auto baseline_records = write_and_flush(0);
+  ASSERT_FALSE(HasFailure());
+  LOG(INFO) << "Flushed intent records with regular delete: " << baseline_records;
+
+  FLAGS_apply_intents_with_regular_delete = false;
+  auto flushed_records = write_and_flush(kTransactions);
+  ASSERT_FALSE(HasFailure());
+  LOG(INFO) << "Flushed intent records with single delete: " << flushed_records;
+
+  // Regular delete leaves a tombstone for each intent and reverse index record of each replica.
+  ASSERT_GE(baseline_records, 2 * kTransactions * kNumRows * cluster_->num_tablet_servers());
+  // Only tombstones of transaction metadata, one per involved tablet replica, are flushed.
+  ASSERT_LE(flushed_records, kTransactions * kNumRows * cluster_->num_tablet_servers());
+  ASSERT_LT(flushed_records, baseline_records);
+
+  VerifyData(2 * kTransactions);
+}
+
+TEST_F(QLTransactionTest, RemoveIntentsOfAbortedTransaction) {
+  FLAGS_transaction_cleanup_aborted_intents = true;
+
+  {
+    auto txn = CreateTransaction();
+    WriteRows(CreateSession(txn));
+    txn->Abort();
+  }
+
+  // Reads find intents of the aborted transaction and resolve its status. After that tablet leaders
+  // replicate cleanup of the transaction, and its intents are removed by all replicas.
+  ASSERT_OK(WaitFor([this] {
+    auto session = CreateSession();
+    for (size_t r = 0; r != kNumRows; ++r) {
+      auto row = SelectRow(session, KeyForTransactionAndIndex(0, r));
+      CHECK(!row.ok() && row.status().IsNotFound()) << "Bad row: " << row;
+    }
+    return CountRemovedIntents() >= kNumRows;
+  }, kTransactionApplyTime, "Intents removed"));
+
+  auto session = CreateSession();
+  for (size_t r = 0; r != kNumRows; ++r) {
+    auto row = SelectRow(session, KeyForTransactionAndIndex(0, r));
+    ASSERT_TRUE(!row.ok() && row.status().IsNotFound()) << "Bad row: " << row;
+  }
+
+  WriteData();
+  VerifyData();
+}
+
+// Status tablet notifies involved tablets about abort, so intents are removed without reads.
+TEST_F(QLTransactionTest, RemoveIntentsOfAbortedTransactionWithoutReads) {
+  FLAGS_transaction_cleanup_aborted_intents = true;
+
+  {
+    auto txn = CreateTransaction();
+    WriteRows(CreateSession(txn));
+    txn->Abort();
+  }
+
+  ASSERT_OK(WaitFor([this] {
+    return CountRemovedIntents() >= kNumRows;
+  }, kTransactionApplyTime, "Intents removed"));
+
+  WriteData();
+  VerifyData();
+}
+
+// Status tablet reports both aborted and forgotten transactions as ABORTED, but only abort is
+// reported as known. Intents of forgotten transactions, that could be committed, are not removed.
+TEST_F(QLTransactionTest, AbortedTransactionStatusKnown) {
+  auto committed_txn = CreateTransaction();
+  WriteRows(CreateSession(committed_txn), 1);
+  auto committed_metadata = committed_txn->TEST_GetMetadata().get();
+  ASSERT_OK(committed_txn->CommitFuture().get());
+  // Applied transaction is forgotten by status tablet.
+  ASSERT_OK(WaitFor(
+      [this] { return CountTransactions() == 0; }, kTransactionApplyTime, "Transactions cleaned"));
+
+  auto aborted_txn = CreateTransaction();
+  WriteRows(CreateSession(aborted_txn), 0);
+  auto aborted_metadata = aborted_txn->TEST_GetMetadata().get();
+  aborted_txn->Abort();
+
+  ASSERT_EQ(aborted_metadata.status_tablet, committed_metadata.status_tablet);
+  tserver::GetTransactionStatusRequestPB req;
+  req.set_tablet_id(aborted_metadata.status_tablet);
+  req.add_transaction_id(aborted_metadata.transaction_id.data,
+                         aborted_metadata.transaction_id.size());
+  req.add_transaction_id(committed_metadata.transaction_id.data,
+                         committed_metadata.transaction_id.size());
+  auto unknown_id = GenerateTransactionId();
+  req.add_transaction_id(unknown_id.data, unknown_id.size());
+
+  rpc::Rpcs rpcs;
+  tserver::GetTransactionStatusResponsePB resp;
+  ASSERT_OK(WaitFor([&] {
+    auto result = rpc::WrapRpcFuture<tserver::GetTransactionStatusResponsePB>(
+        GetTransactionStatus, &rpcs)(
+            TransactionRpcDeadline(), nullptr /* tablet */, client_.get(), &req).get();
+    if (!result.ok()) {
+      return false;
+    }
+    resp = *result;
+    return resp.status(0) == TransactionStatus::ABORTED;
+  }, kTransactionApplyTime, "Transaction aborted"));
+
+  ASSERT_EQ(3, resp.status_size());
+  ASSERT_EQ(3, resp.status_known_size());
+  ASSERT_TRUE(resp.status_known(0));
+  for (int i = 1; i != resp.status_size(); ++i) {
+    ASSERT_EQ(TransactionStatus::ABORTED, resp.status(i));
+    ASSERT_FALSE(resp.status_known(i));
+  }
+
+  VerifyRows(CreateSession(), 1);
+}
+
+// Writes transaction with 100k keys and checks that it is applied in bounded time.
+TEST_F(QLTransactionTest, LargeTransactionApply) {
+  constexpr int32_t kKeys = 100000;
+  constexpr int32_t kKeysPerBatch = 1000;
+
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  ASSERT_OK(session->SetFlushMode(YBSession::MANUAL_FLUSH));
+  for (int32_t key = 0; key != kKeys;) {
+    for (auto batch_end = key + kKeysPerBatch; key != batch_end; ++key) {
+      const auto op = table_.NewWriteOp(QLWriteRequestPB::QL_STMT_INSERT);
+      auto* const req = op->mutable_request();
+      QLAddInt32HashValue(req, key);
+      table_.AddInt32ColumnValue(req, kValueColumn, -key);
+      ASSERT_OK(session->Apply(op));
+    }
+    ASSERT_OK(session->Flush());
+  }
+
+  auto start = MonoTime::Now();
+  ASSERT_OK(txn->CommitFuture().get());
+  auto committed = MonoTime::Now();
+  ASSERT_OK(WaitFor([this] { return CountIntents() == 0; }, NonTsanVsTsan(60s, 300s),
+                    "Intents applied"));
+  auto applied = MonoTime::Now();
+  LOG(INFO) << "Keys: " << kKeys << ", commit time: " << committed.GetDeltaSince(start)
+            << ", apply time: " << applied.GetDeltaSince(committed);
+
+  session = CreateSession();
+  for (int32_t key = 0; key < kKeys; key += kKeys / 100) {
+    VERIFY_ROW(session, key, -key);
+  }
+}
+
 TEST_F(QLTransactionTest, FlushIntents) {
   FLAGS_flush_rocksdb_on_shutdown = false;
 
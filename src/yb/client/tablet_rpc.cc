@@ -43,7 +43,11 @@ TabletInvoker::TabletInvoker(bool consistent_prefix,
         trace_(trace),
         consistent_prefix_(consistent_prefix) {}
 
-TabletInvoker::~TabletInvoker() {}
+TabletInvoker::~TabletInvoker() {
+  if (rpc_ts_ != nullptr) {
+    rpc_ts_->RpcFinished(MonoDelta());
+  }
+}
 
 void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   std::vector<RemoteTabletServer*> candidates;
@@ -160,6 +164,15 @@ void TabletInvoker::Execute(const std::string& tablet_id, bool leader_only) {
   VLOG(2) << "Tablet " << tablet_id_ << ": Writing batch to replica "
           << current_ts_->ToString();
 
+  // Track the RPC on the tablet server it is sent to, since current_ts_ may change before the
+  // response arrives.
+  if (rpc_ts_ != nullptr) {
+    rpc_ts_->RpcFinished(MonoDelta());
+  }
+  rpc_ts_ = current_ts_;
+  rpc_start_ = MonoTime::Now();
+  rpc_ts_->RpcStarted();
+
   rpc_->SendRpcToTserver();
 }
 
@@ -185,6 +198,11 @@ bool TabletInvoker::Done(Status* status) {
   TRACE_TO(trace_, "Done($0)", status->ToString(false));
   ADOPT_TRACE(trace_);
 
+  if (rpc_ts_ != nullptr) {
+    rpc_ts_->RpcFinished(status->IsAborted() ? MonoDelta() : MonoTime::Now() - rpc_start_);
+    rpc_ts_ = nullptr;
+  }
+
   if (status->IsAborted() || retrier_->finished()) {
     return true;
   }
@@ -126,6 +126,11 @@ class TabletInvoker {
   // RemoteTabletServer is taken from YBClient cache, so it is guaranteed that those objects are
   // alive while YBClient is alive. Because we don't delete them, but only add and update.
   RemoteTabletServer* current_ts_ = nullptr;
+
+  // The TS that the RPC in flight, if any, was sent to, and the time it was sent. Used to update
+  // the load estimate of the TS for replica selection.
+  RemoteTabletServer* rpc_ts_ = nullptr;
+  MonoTime rpc_start_;
 };
 
 CHECKED_STATUS ErrorStatus(const tserver::TabletServerErrorPB* error);
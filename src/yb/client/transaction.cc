@@ -32,6 +32,7 @@
 #include "yb/rpc/rpc.h"
 #include "yb/rpc/scheduler.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/random_util.h"
 #include "yb/util/result.h"
@@ -39,8 +40,12 @@
 
 using namespace std::placeholders;
 
-DEFINE_uint64(transaction_heartbeat_usec, 500000, "Interval of transaction heartbeat in usec.");
-DEFINE_bool(transaction_disable_heartbeat_in_tests, false, "Disable heartbeat during test.");
+DEFINE_bool(transaction_single_shard_fast_path, true,
+            "Send transactions, whose only writes are flushed right before commit and go to a "
+            "single tablet, as one atomic non-transactional write. Such transactions never touch "
+            "the status tablet and write no intents.");
+TAG_FLAG(transaction_single_shard_fast_path, runtime);
+TAG_FLAG(transaction_single_shard_fast_path, advanced);
 DECLARE_uint64(max_clock_skew_usec);
 
 namespace yb {
@@ -101,6 +106,7 @@ class YBTransaction::Impl final {
   }
 
   ~Impl() {
+    UnregisterHeartbeats();
     manager_->rpcs().Abort({&heartbeat_handle_, &commit_handle_, &abort_handle_});
   }
 
@@ -136,6 +142,23 @@ class YBTransaction::Impl final {
     bool has_tablets_without_parameters = false;
     {
       std::unique_lock<std::mutex> lock(mutex_);
+      const bool expect_commit = expect_commit_after_next_flush_;
+      expect_commit_after_next_flush_ = false;
+      if (single_shard_.load(std::memory_order_acquire)) {
+        LOG_WITH_PREFIX(DFATAL) << "Flush after single shard write";
+        if (error_.ok()) {
+          error_ = STATUS(IllegalState, "Flush after single shard write");
+          state_.store(TransactionState::kAborted, std::memory_order_release);
+        }
+      } else if (expect_commit && IsSingleShardWrite(ops)) {
+        // The whole transaction is one batch of writes to a single tablet, so the tablet could
+        // apply it atomically as a regular write, without intents and status tablet.
+        VLOG_WITH_PREFIX(1) << "Prepare, single shard write";
+        single_shard_.store(true, std::memory_order_release);
+        tablets_.emplace((*ops.begin())->tablet->tablet_id(), TabletState());
+        *metadata = TransactionMetadata();
+        return true;
+      }
       if (!ready_) {
         waiters_.push_back(std::move(waiter));
         lock.unlock();
@@ -180,7 +203,9 @@ class YBTransaction::Impl final {
           }
         }
       }
-    } else if (status.IsTryAgain()) {
+    } else if (status.IsTryAgain() || single_shard_.load(std::memory_order_acquire)) {
+      // Single shard write is the whole transaction, so once it failed, the transaction could
+      // not be committed.
       SetError(status);
     }
     // We should not handle other errors, because it is just notification that batch was failed.
@@ -206,6 +231,13 @@ class YBTransaction::Impl final {
         return;
       }
       state_.store(TransactionState::kCommitted, std::memory_order_release);
+      if (single_shard_.load(std::memory_order_acquire)) {
+        // Writes were already applied by the tablet.
+        lock.unlock();
+        VLOG_WITH_PREFIX(1) << "Committed single shard write";
+        callback(Status::OK());
+        return;
+      }
       commit_callback_ = std::move(callback);
       if (!ready_) {
         waiters_.emplace_back(std::bind(&Impl::DoCommit, this, _1, transaction));
@@ -231,6 +263,10 @@ class YBTransaction::Impl final {
         return;
       }
       state_.store(TransactionState::kAborted, std::memory_order_release);
+      if (single_shard_.load(std::memory_order_acquire)) {
+        LOG_WITH_PREFIX(WARNING) << "Abort of single shard write, that was already applied";
+        return;
+      }
       if (!ready_) {
         waiters_.emplace_back(std::bind(&Impl::DoAbort, this, _1, transaction));
         lock.unlock();
@@ -339,6 +375,11 @@ class YBTransaction::Impl final {
     return read_point_;
   }
 
+  void ExpectCommitAfterNextFlush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    expect_commit_after_next_flush_ = true;
+  }
+
  private:
   void Init() {
     log_prefix_ = Format("$0: ", to_string(metadata_.transaction_id));
@@ -347,6 +388,49 @@ class YBTransaction::Impl final {
     abort_handle_ = manager_->rpcs().InvalidHandle();
   }
 
+  // Whether ops could be sent as a single shard write, i.e. they are the first and only ops of
+  // this transaction, and they are unconditional blind writes to the same tablet.
+  bool IsSingleShardWrite(const std::unordered_set<internal::InFlightOpPtr>& ops) const {
+    if (!GetAtomicFlag(&FLAGS_transaction_single_shard_fast_path) || child_ || ops.empty() ||
+        !tablets_.empty() || requested_status_tablet_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    const internal::RemoteTablet* tablet = (*ops.begin())->tablet.get();
+    for (const auto& op : ops) {
+      if (op->tablet.get() != tablet || op->yb_op->type() != YBOperation::QL_WRITE) {
+        return false;
+      }
+      const auto* write_op = down_cast<YBqlWriteOp*>(op->yb_op.get());
+      // Conditional writes could return rows read at the transaction read time, and index
+      // updates go to other tablets.
+      if (write_op->request().has_if_expr() || !write_op->table()->index_map().empty()) {
+        return false;
+      }
+      // A write that could fail at the tablet on its own, e.g. an update of a list element past
+      // the end of the list, would not roll back the other writes of the batch.
+      if (!IsBlindWrite(write_op->request())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Whether the write does not depend on the current row, so it could only fail along with the
+  // whole batch.
+  static bool IsBlindWrite(const QLWriteRequestPB& request) {
+    if (request.has_where_expr() || request.column_refs().ids_size() != 0 ||
+        request.column_refs().static_ids_size() != 0) {
+      return false;
+    }
+    for (const auto& column_value : request.column_values()) {
+      if (column_value.subscript_args_size() != 0 || column_value.json_args_size() != 0 ||
+          !column_value.expr().has_value()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   CHECKED_STATUS CheckRunning(std::unique_lock<std::mutex>* lock) {
     if (state_.load(std::memory_order_acquire) != TransactionState::kRunning) {
       auto status = error_;
@@ -362,6 +446,8 @@ class YBTransaction::Impl final {
   void DoCommit(const Status& status, const YBTransactionPtr& transaction) {
     VLOG_WITH_PREFIX(1) << Format("Commit, tablets: $0, status: $1", tablets_, status);
 
+    UnregisterHeartbeats();
+
     if (!status.ok()) {
       commit_callback_(status);
       return;
@@ -404,10 +490,15 @@ class YBTransaction::Impl final {
       return;
     }
 
+    UnregisterHeartbeats();
+
     tserver::AbortTransactionRequestPB req;
     req.set_tablet_id(status_tablet_->tablet_id());
     req.set_propagated_hybrid_time(manager_->Now().ToUint64());
     req.set_transaction_id(metadata_.transaction_id.begin(), metadata_.transaction_id.size());
+    for (const auto& tablet : tablets_) {
+      req.add_involved_tablets(tablet.first);
+    }
 
     manager_->rpcs().RegisterAndStart(
         AbortTransaction(
@@ -476,6 +567,8 @@ class YBTransaction::Impl final {
     SendHeartbeat(TransactionStatus::CREATED, transaction_->shared_from_this());
   }
 
+  // Sends CREATED heartbeat, further heartbeats are sent by transaction manager together with
+  // heartbeats of other transactions that use the same status tablet.
   void SendHeartbeat(TransactionStatus status,
                      std::weak_ptr<YBTransaction> weak_transaction) {
     auto transaction = weak_transaction.lock();
@@ -483,12 +576,6 @@ class YBTransaction::Impl final {
       return;
     }
 
-    if (status != TransactionStatus::CREATED &&
-        GetAtomicFlag(&FLAGS_transaction_disable_heartbeat_in_tests)) {
-      HeartbeatDone(Status::OK(), HybridTime::kInvalid, status, transaction);
-      return;
-    }
-
     tserver::UpdateTransactionRequestPB req;
     req.set_tablet_id(status_tablet_->tablet_id());
     req.set_propagated_hybrid_time(manager_->Now().ToUint64());
@@ -526,10 +613,12 @@ class YBTransaction::Impl final {
           waiter(Status::OK());
         }
       }
-      std::weak_ptr<YBTransaction> weak_transaction(transaction);
-      manager_->client()->messenger()->scheduler().Schedule(
-          std::bind(&Impl::SendHeartbeat, this, TransactionStatus::PENDING, weak_transaction),
-          std::chrono::microseconds(FLAGS_transaction_heartbeat_usec));
+      if (state_.load(std::memory_order_acquire) == TransactionState::kRunning) {
+        std::weak_ptr<YBTransaction> weak_transaction(transaction);
+        manager_->RegisterHeartbeats(
+            status_tablet_, metadata_.transaction_id,
+            std::bind(&Impl::PendingHeartbeatDone, this, _1, weak_transaction));
+      }
     } else {
       LOG_WITH_PREFIX(WARNING) << "Send heartbeat failed: " << status;
       if (status.IsExpired()) {
@@ -542,6 +631,33 @@ class YBTransaction::Impl final {
     }
   }
 
+  // Invoked by transaction manager with result of PENDING heartbeat. Returns whether heartbeats
+  // should be continued.
+  bool PendingHeartbeatDone(const Status& status,
+                            const std::weak_ptr<YBTransaction>& weak_transaction) {
+    auto transaction = weak_transaction.lock();
+    if (!transaction || state_.load(std::memory_order_acquire) != TransactionState::kRunning) {
+      return false;
+    }
+    if (status.ok()) {
+      return true;
+    }
+    LOG_WITH_PREFIX(WARNING) << "Send heartbeat failed: " << status;
+    if (status.IsExpired()) {
+      SetError(status);
+      return false;
+    }
+    // Other errors could have different causes, but we should just retry sending heartbeat
+    // in this case.
+    return true;
+  }
+
+  void UnregisterHeartbeats() {
+    if (status_tablet_) {
+      manager_->UnregisterHeartbeats(status_tablet_->tablet_id(), metadata_.transaction_id);
+    }
+  }
+
   void SetError(const Status& status) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (error_.ok()) {
@@ -586,6 +702,10 @@ class YBTransaction::Impl final {
   // Transaction is successfully initialized and ready to process intents.
   const bool child_;
   bool ready_ = false;
+  // Next flush is the last one before commit.
+  bool expect_commit_after_next_flush_ = false;
+  // All writes of this transaction were sent as a single shard write.
+  std::atomic<bool> single_shard_{false};
   CommitCallback commit_callback_;
   Status error_;
   rpc::Rpcs::Handle heartbeat_handle_;
@@ -663,6 +783,10 @@ void YBTransaction::Abort() {
   impl_->Abort();
 }
 
+void YBTransaction::ExpectCommitAfterNextFlush() {
+  impl_->ExpectCommitAfterNextFlush();
+}
+
 bool YBTransaction::IsRestartRequired() const {
   return impl_->IsRestartRequired();
 }
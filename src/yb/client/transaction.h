@@ -85,6 +85,11 @@ class YBTransaction : public std::enable_shared_from_this<YBTransaction> {
   // Aborts this transaction.
   void Abort();
 
+  // Notifies transaction that commit follows the next flush, without other operations in between.
+  // So if this flush is the only one and all its writes go to a single tablet, the flush is sent
+  // as a regular atomic write, that does not require status tablet and intents.
+  void ExpectCommitAfterNextFlush();
+
   // Returns transaction ID.
   const TransactionId& id() const;
 
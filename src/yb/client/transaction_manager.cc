@@ -15,19 +15,46 @@
 
 #include "yb/client/transaction_manager.h"
 
+#include <condition_variable>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/scope_exit.hpp>
+
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc.h"
+#include "yb/rpc/scheduler.h"
 #include "yb/rpc/thread_pool.h"
 #include "yb/rpc/tasks_pool.h"
 
+#include "yb/common/wire_protocol.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/random_util.h"
 #include "yb/util/thread_restrictions.h"
 
 #include "yb/client/client.h"
+#include "yb/client/meta_cache.h"
+#include "yb/client/transaction_rpc.h"
+
+using namespace std::literals;
+using namespace std::placeholders;
 
 DEFINE_uint64(transaction_table_num_tablets, 24,
               "Automatically create transaction table with specified number of tablets if missing. "
               "0 to disable.");
 
+DEFINE_int32(transaction_heartbeat_max_batch_size, 1000,
+             "Max number of transaction heartbeats sent to a status tablet in one request.");
+TAG_FLAG(transaction_heartbeat_max_batch_size, runtime);
+TAG_FLAG(transaction_heartbeat_max_batch_size, advanced);
+
+DEFINE_uint64(transaction_heartbeat_usec, 500000, "Interval of transaction heartbeat in usec.");
+DEFINE_bool(transaction_disable_heartbeat_in_tests, false, "Disable heartbeat during test.");
+
 namespace yb {
 namespace client {
 
@@ -181,6 +208,259 @@ class InvokeCallbackTask {
 constexpr size_t kQueueLimit = 150;
 constexpr size_t kMaxWorkers = 50;
 
+// For how long to send heartbeats of single transactions after a status tablet was found to not
+// support batches, e.g. during a rolling upgrade.
+constexpr auto kSingleTransactionHeartbeatsTime = 60s;
+
+// Sends heartbeats of registered transactions every transaction_heartbeat_usec.
+// Heartbeats of all transactions that use the same status tablet are sent in one request,
+// instead of a separate request per transaction.
+class HeartbeatBatcher {
+ public:
+  HeartbeatBatcher(const YBClientPtr& client, const scoped_refptr<ClockBase>& clock,
+                   rpc::Rpcs* rpcs)
+      : client_(client), clock_(clock), rpcs_(*rpcs) {
+  }
+
+  void Register(const internal::RemoteTabletPtr& status_tablet,
+                const TransactionId& transaction_id,
+                HeartbeatCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closing_) {
+      return;
+    }
+    auto& tablet = tablets_[status_tablet->tablet_id()];
+    tablet.tablet = status_tablet;
+    tablet.transactions[transaction_id] = std::move(callback);
+    if (task_id_ == rpc::kUninitializedScheduledTaskId && running_sends_ == 0) {
+      ScheduleSend();
+    }
+  }
+
+  void Unregister(const TabletId& status_tablet, const TransactionId& transaction_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tablets_.find(status_tablet);
+    if (it != tablets_.end()) {
+      it->second.transactions.erase(transaction_id);
+    }
+  }
+
+  void Shutdown() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!closing_) {
+      closing_ = true;
+      if (task_id_ != rpc::kUninitializedScheduledTaskId) {
+        client_->messenger()->scheduler().Abort(task_id_);
+      }
+    }
+    cond_.wait(lock, [this] { return task_id_ == rpc::kUninitializedScheduledTaskId; });
+    // Send could be executed outside of mutex, so we should wait that it also completed.
+    while (running_sends_ != 0) {
+      lock.unlock();
+      std::this_thread::sleep_for(10ms);
+      lock.lock();
+    }
+  }
+
+ private:
+  struct StatusTabletHeartbeats {
+    internal::RemoteTabletPtr tablet;
+    std::unordered_map<TransactionId, HeartbeatCallback, TransactionIdHash> transactions;
+    // Number of heartbeat requests to this tablet that are not completed yet.
+    size_t in_flight = 0;
+    // Until this time, every request carries heartbeat of a single transaction, because the status
+    // tablet runs a version that does not support batches.
+    MonoTime single_transaction_until;
+  };
+
+  struct Batch {
+    internal::RemoteTabletPtr tablet;
+    std::vector<TransactionId> ids;
+    std::vector<HeartbeatCallback> callbacks;
+    bool single_transaction = false;
+  };
+
+  void ScheduleSend() {
+    task_id_ = client_->messenger()->scheduler().Schedule(
+        std::bind(&HeartbeatBatcher::Send, this, _1),
+        std::chrono::microseconds(FLAGS_transaction_heartbeat_usec));
+  }
+
+  void Send(const Status& status) {
+    std::vector<Batch> batches;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_id_ = rpc::kUninitializedScheduledTaskId;
+      if (!status.ok() || closing_) {
+        cond_.notify_one();
+        return;
+      }
+      if (!GetAtomicFlag(&FLAGS_transaction_disable_heartbeat_in_tests)) {
+        batches = PrepareBatches();
+      }
+      ++running_sends_;
+    }
+    BOOST_SCOPE_EXIT(this_) {
+      std::lock_guard<std::mutex> lock(this_->mutex_);
+      --this_->running_sends_;
+      if (!this_->closing_ && !this_->tablets_.empty() &&
+          this_->task_id_ == rpc::kUninitializedScheduledTaskId) {
+        this_->ScheduleSend();
+      }
+    } BOOST_SCOPE_EXIT_END;
+
+    for (auto& batch : batches) {
+      SendBatch(&batch);
+    }
+  }
+
+  // Splits registered transactions to batches, skipping tablets whose previous heartbeats are
+  // still in flight. Also drops tablets that don't have registered transactions.
+  std::vector<Batch> PrepareBatches() {
+    const size_t max_batch_size = std::max(FLAGS_transaction_heartbeat_max_batch_size, 1);
+    const auto now = MonoTime::Now();
+    std::vector<Batch> result;
+    for (auto it = tablets_.begin(); it != tablets_.end();) {
+      auto& tablet = it->second;
+      if (tablet.transactions.empty() && tablet.in_flight == 0) {
+        it = tablets_.erase(it);
+        continue;
+      }
+      if (tablet.in_flight == 0) {
+        const bool single_transaction = tablet.single_transaction_until.Initialized() &&
+                                        now < tablet.single_transaction_until;
+        const size_t batch_size = single_transaction ? 1 : max_batch_size;
+        for (const auto& transaction : tablet.transactions) {
+          if (result.empty() || result.back().tablet.get() != tablet.tablet.get() ||
+              result.back().ids.size() >= batch_size) {
+            result.emplace_back();
+            result.back().tablet = tablet.tablet;
+            result.back().single_transaction = single_transaction;
+            ++tablet.in_flight;
+          }
+          result.back().ids.push_back(transaction.first);
+          result.back().callbacks.push_back(transaction.second);
+        }
+      }
+      ++it;
+    }
+    return result;
+  }
+
+  void SendBatch(Batch* batch) {
+    tserver::UpdateTransactionRequestPB req;
+    req.set_tablet_id(batch->tablet->tablet_id());
+    req.set_propagated_hybrid_time(clock_->Now().ToUint64());
+    // A status tablet that does not support batches ignores heartbeat_transaction_ids and handles
+    // only the heartbeat of the first transaction, passed as state.
+    auto& state = *req.mutable_state();
+    state.set_transaction_id(batch->ids.front().begin(), batch->ids.front().size());
+    state.set_status(TransactionStatus::PENDING);
+    if (!batch->single_transaction) {
+      for (const auto& id : batch->ids) {
+        req.add_heartbeat_transaction_ids(id.begin(), id.size());
+      }
+    }
+
+    auto handle = rpcs_.Prepare();
+    if (handle == rpcs_.InvalidHandle()) {
+      BatchDone(*batch);
+      return;
+    }
+    auto tablet = batch->tablet.get();
+    *handle = SendHeartbeats(
+        TransactionRpcDeadline(),
+        tablet,
+        client_.get(),
+        &req,
+        [this, handle, batch = std::move(*batch)](
+            const Status& status, const tserver::UpdateTransactionResponsePB& response) {
+          if (response.has_propagated_hybrid_time()) {
+            clock_->Update(HybridTime(response.propagated_hybrid_time()));
+          }
+          rpcs_.Unregister(handle);
+          HeartbeatsDone(batch, status, response);
+        });
+    (**handle).SendRpc();
+  }
+
+  void HeartbeatsDone(const Batch& batch,
+                      Status status,
+                      const tserver::UpdateTransactionResponsePB& response) {
+    // A status tablet that does not support batches responds only to the heartbeat passed as state,
+    // so heartbeats are sent one by one for a while.
+    const bool batch_not_supported = status.ok() && response.heartbeat_status_size() == 0;
+    if (batch_not_supported && !batch.single_transaction) {
+      YB_LOG_EVERY_N_SECS(INFO, 10) << "Status tablet " << batch.tablet->tablet_id()
+                                    << " does not support batches, sending heartbeats of "
+                                    << batch.ids.size() << " transactions one by one";
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = tablets_.find(batch.tablet->tablet_id());
+      if (it != tablets_.end()) {
+        it->second.single_transaction_until = MonoTime::Now() + kSingleTransactionHeartbeatsTime;
+      }
+      // Heartbeats of this batch are sent again during next send.
+      DoBatchDone(batch);
+      return;
+    }
+    if (status.ok() && !batch_not_supported &&
+        static_cast<size_t>(response.heartbeat_status_size()) != batch.ids.size()) {
+      status = STATUS_FORMAT(
+          IllegalState, "Wrong number of heartbeat statuses: $0, expected: $1",
+          response.heartbeat_status_size(), batch.ids.size());
+    }
+    if (!status.ok() && !batch.single_transaction) {
+      // Heartbeats of this batch are retried during next send.
+      LOG(WARNING) << "Send heartbeats to " << batch.tablet->tablet_id() << " failed: " << status;
+      BatchDone(batch);
+      return;
+    }
+
+    std::vector<size_t> stopped;
+    for (size_t i = 0; i != batch.ids.size(); ++i) {
+      // Result of a single heartbeat passed as state is the status of the whole request.
+      const auto heartbeat_status = batch_not_supported || !status.ok()
+          ? status : StatusFromPB(response.heartbeat_status(i));
+      if (!batch.callbacks[i](heartbeat_status)) {
+        stopped.push_back(i);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tablets_.find(batch.tablet->tablet_id());
+    if (it != tablets_.end()) {
+      for (auto idx : stopped) {
+        it->second.transactions.erase(batch.ids[idx]);
+      }
+    }
+    DoBatchDone(batch);
+  }
+
+  void BatchDone(const Batch& batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DoBatchDone(batch);
+  }
+
+  void DoBatchDone(const Batch& batch) {
+    auto it = tablets_.find(batch.tablet->tablet_id());
+    if (it != tablets_.end()) {
+      --it->second.in_flight;
+    }
+  }
+
+  YBClientPtr client_;
+  scoped_refptr<ClockBase> clock_;
+  rpc::Rpcs& rpcs_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool closing_ = false;
+  rpc::ScheduledTaskId task_id_ = rpc::kUninitializedScheduledTaskId;
+  size_t running_sends_ = 0;
+  // Registered transactions by status tablet.
+  std::unordered_map<TabletId, StatusTabletHeartbeats> tablets_;
+};
+
 } // namespace
 
 class TransactionManager::Impl {
@@ -192,7 +472,8 @@ class TransactionManager::Impl {
         table_state_{std::move(local_tablet_filter)},
         thread_pool_("TransactionManager", kQueueLimit, kMaxWorkers),
         tasks_pool_(kQueueLimit),
-        invoke_callback_tasks_(kQueueLimit) {
+        invoke_callback_tasks_(kQueueLimit),
+        heartbeat_batcher_(client, clock, &rpcs_) {
     CHECK(clock);
   }
 
@@ -211,6 +492,16 @@ class TransactionManager::Impl {
     }
   }
 
+  void RegisterHeartbeats(const internal::RemoteTabletPtr& status_tablet,
+                          const TransactionId& transaction_id,
+                          HeartbeatCallback callback) {
+    heartbeat_batcher_.Register(status_tablet, transaction_id, std::move(callback));
+  }
+
+  void UnregisterHeartbeats(const TabletId& status_tablet, const TransactionId& transaction_id) {
+    heartbeat_batcher_.Unregister(status_tablet, transaction_id);
+  }
+
   const scoped_refptr<ClockBase>& clock() const {
     return clock_;
   }
@@ -236,6 +527,7 @@ class TransactionManager::Impl {
   }
 
   void Shutdown() {
+    heartbeat_batcher_.Shutdown();
     rpcs_.Shutdown();
   }
 
@@ -248,6 +540,7 @@ class TransactionManager::Impl {
   yb::rpc::TasksPool<PickStatusTabletTask> tasks_pool_;
   yb::rpc::TasksPool<InvokeCallbackTask> invoke_callback_tasks_;
   yb::rpc::Rpcs rpcs_;
+  HeartbeatBatcher heartbeat_batcher_;
 };
 
 TransactionManager::TransactionManager(
@@ -263,6 +556,17 @@ void TransactionManager::PickStatusTablet(PickStatusTabletCallback callback) {
   impl_->PickStatusTablet(std::move(callback));
 }
 
+void TransactionManager::RegisterHeartbeats(const internal::RemoteTabletPtr& status_tablet,
+                                            const TransactionId& transaction_id,
+                                            HeartbeatCallback callback) {
+  impl_->RegisterHeartbeats(status_tablet, transaction_id, std::move(callback));
+}
+
+void TransactionManager::UnregisterHeartbeats(const TabletId& status_tablet,
+                                              const TransactionId& transaction_id) {
+  impl_->UnregisterHeartbeats(status_tablet, transaction_id);
+}
+
 const YBClientPtr& TransactionManager::client() const {
   return impl_->client();
 }
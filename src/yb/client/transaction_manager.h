@@ -23,6 +23,7 @@
 
 #include "yb/common/clock.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
 
 #include "yb/rpc/rpc_fwd.h"
 
@@ -33,6 +34,10 @@ namespace client {
 
 typedef std::function<void(const Result<std::string>&)> PickStatusTabletCallback;
 
+// Invoked with result of transaction heartbeat. Returns false when heartbeats of this transaction
+// should be stopped.
+typedef std::function<bool(const Status&)> HeartbeatCallback;
+
 // TransactionManager manages multiple transactions. It lives at the YQL engine layer.
 class TransactionManager {
  public:
@@ -42,6 +47,15 @@ class TransactionManager {
 
   void PickStatusTablet(PickStatusTabletCallback callback);
 
+  // Starts periodic heartbeats of specified transaction.
+  // Heartbeats of all transactions that use the same status tablet are sent in one request.
+  void RegisterHeartbeats(const internal::RemoteTabletPtr& status_tablet,
+                          const TransactionId& transaction_id,
+                          HeartbeatCallback callback);
+
+  // Stops heartbeats of specified transaction.
+  void UnregisterHeartbeats(const TabletId& status_tablet, const TransactionId& transaction_id);
+
   rpc::Rpcs& rpcs();
   const YBClientPtr& client() const;
 
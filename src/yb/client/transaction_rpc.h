@@ -36,6 +36,7 @@ class AbortTransactionResponsePB;
 class GetTransactionStatusRequestPB;
 class GetTransactionStatusResponsePB;
 class UpdateTransactionRequestPB;
+class UpdateTransactionResponsePB;
 
 }
 
@@ -58,6 +59,17 @@ MUST_USE_RESULT rpc::RpcCommandPtr UpdateTransaction(
     tserver::UpdateTransactionRequestPB* req,
     UpdateTransactionCallback callback);
 
+typedef std::function<void(const Status&, const tserver::UpdateTransactionResponsePB&)>
+    SendHeartbeatsCallback;
+
+// Sends heartbeats of several transactions, listed in heartbeat_transaction_ids of request.
+MUST_USE_RESULT rpc::RpcCommandPtr SendHeartbeats(
+    const MonoTime& deadline,
+    internal::RemoteTablet* tablet,
+    YBClient* client,
+    tserver::UpdateTransactionRequestPB* req,
+    SendHeartbeatsCallback callback);
+
 typedef std::function<void(const Status&, const tserver::GetTransactionStatusResponsePB&)>
     GetTransactionStatusCallback;
 
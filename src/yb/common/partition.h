@@ -195,6 +195,12 @@ class PartitionSchema {
     return hash_schema_;
   }
 
+  // Returns true if the table is partitioned by the hash of its hash columns (YQL, Redis or PGSQL
+  // hashing), i.e. the partition keys are encoded hash values.
+  bool IsHashPartitioning() const {
+    return hash_bucket_schemas_.empty() && range_schema_.column_ids.empty();
+  }
+
   // Encodes the given uint16 value into a 2 byte string.
   static std::string EncodeMultiColumnHashValue(uint16_t hash_value);
 
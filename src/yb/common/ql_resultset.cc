@@ -66,4 +66,23 @@ CHECKED_STATUS QLResultSet::CQLSerialize(const QLClient& client,
   return Status::OK();
 }
 
+CHECKED_STATUS QLResultSet::CQLSerialize(const QLClient& client,
+                                         const QLRSRowDesc& rsrow_desc,
+                                         RefCntBufferChain* buffer) const {
+  // Rows are serialized into a small scratch buffer that is appended to the chain whenever it
+  // fills up, so the whole result set is never copied into one contiguous buffer.
+  static constexpr size_t kFlushSize = 4096;
+  faststring scratch;
+  CQLEncodeLength(rsrows_.size(), &scratch);
+  for (const auto& rsrow : rsrows_) {
+    RETURN_NOT_OK(rsrow.CQLSerialize(client, rsrow_desc, &scratch));
+    if (scratch.size() >= kFlushSize) {
+      buffer->Append(scratch);
+      scratch.clear();
+    }
+  }
+  buffer->Append(scratch);
+  return Status::OK();
+}
+
 } // namespace yb
@@ -19,6 +19,7 @@
 #define YB_COMMON_QL_RESULTSET_H_
 
 #include "yb/common/ql_value.h"
+#include "yb/util/ref_cnt_buffer.h"
 
 namespace yb {
 
@@ -109,6 +110,12 @@ class QLResultSet {
                               const QLRSRowDesc& rsrow_desc,
                               faststring* buffer) const;
 
+  // Same as above but serializes into a chain of buffers, which can be sent as an RPC sidecar
+  // without copying the serialized rows again.
+  CHECKED_STATUS CQLSerialize(const QLClient& client,
+                              const QLRSRowDesc& rsrow_desc,
+                              RefCntBufferChain* buffer) const;
+
  private:
   std::vector<QLRSRow> rsrows_;
 };
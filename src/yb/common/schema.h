@@ -364,19 +364,22 @@ class TableProperties {
       : default_time_to_live_(kNoDefaultTtl),
         contain_counters_(false),
         is_transactional_(false),
-        copartition_table_id_(kNoCopartitionTableId) {}
+        copartition_table_id_(kNoCopartitionTableId),
+        compression_(TableCompressionType::DEFAULT_COMPRESSION) {}
 
   TableProperties(const TableProperties& other) {
     default_time_to_live_ = other.default_time_to_live_;
     contain_counters_ = other.contain_counters_;
     is_transactional_ = other.is_transactional_;
     copartition_table_id_ = other.copartition_table_id_;
+    compression_ = other.compression_;
   }
 
   // Containing counters is a internal property instead of a user-defined property, so we don't use
   // it when comparing table properties.
   bool operator==(const TableProperties& other) const {
-    return (default_time_to_live_ == other.default_time_to_live_);
+    return (default_time_to_live_ == other.default_time_to_live_ &&
+            compression_ == other.compression_);
   }
 
   bool operator!=(const TableProperties& other) const {
@@ -423,6 +426,15 @@ class TableProperties {
     copartition_table_id_ = copartition_table_id;
   }
 
+  // Compression of the SSTables of the table. DEFAULT_COMPRESSION lets the tablet servers choose.
+  TableCompressionType compression() const {
+    return compression_;
+  }
+
+  void SetCompression(TableCompressionType compression) {
+    compression_ = compression;
+  }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const {
     if (HasDefaultTimeToLive()) {
       pb->set_default_time_to_live(default_time_to_live_);
@@ -432,6 +444,9 @@ class TableProperties {
     if (HasCopartitionTableId()) {
       pb->set_copartition_table_id(copartition_table_id_);
     }
+    if (compression_ != TableCompressionType::DEFAULT_COMPRESSION) {
+      pb->set_compression(compression_);
+    }
   }
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -448,6 +463,9 @@ class TableProperties {
     if (pb.has_copartition_table_id()) {
       table_properties.SetCopartitionTableId(pb.copartition_table_id());
     }
+    if (pb.has_compression()) {
+      table_properties.SetCompression(pb.compression());
+    }
     return table_properties;
   }
 
@@ -461,6 +479,9 @@ class TableProperties {
     if (pb.has_copartition_table_id()) {
       SetCopartitionTableId(pb.copartition_table_id());
     }
+    if (pb.has_compression()) {
+      SetCompression(pb.compression());
+    }
   }
 
   void Reset() {
@@ -468,6 +489,7 @@ class TableProperties {
     contain_counters_ = false;
     is_transactional_ = false;
     copartition_table_id_ = kNoCopartitionTableId;
+    compression_ = TableCompressionType::DEFAULT_COMPRESSION;
   }
 
  private:
@@ -476,6 +498,7 @@ class TableProperties {
   bool contain_counters_;
   bool is_transactional_;
   TableId copartition_table_id_;
+  TableCompressionType compression_;
 };
 
 // The schema for a set of rows.
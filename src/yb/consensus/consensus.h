@@ -518,6 +518,11 @@ class ReplicaOperationFactory {
       const ConsensusRoundPtr& context, HybridTime propagated_safe_time) = 0;
   virtual void SetPropagatedSafeTime(HybridTime ht) = 0;
 
+  // Invoked before and after a run of consecutively committed rounds is notified about
+  // replication, so that the state machine could apply them as a group.
+  virtual void StartApplyGroup() {}
+  virtual void FinishApplyGroup() {}
+
   virtual ~ReplicaOperationFactory() {}
 };
 
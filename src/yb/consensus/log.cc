@@ -42,6 +42,7 @@
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/log_syncer.h"
 #include "yb/consensus/log_util.h"
 #include "yb/fs/fs_manager.h"
 #include "yb/gutil/map-util.h"
@@ -121,6 +122,15 @@ TAG_FLAG(log_inject_latency, unsafe);
 TAG_FLAG(log_inject_latency_ms_mean, unsafe);
 TAG_FLAG(log_inject_latency_ms_stddev, unsafe);
 
+// Group commit flags.
+// -----------------------------
+DEFINE_bool(log_group_commit, false,
+            "Whether the logs of all tablets with the WAL in the same directory should be synced "
+            "together by a group commit thread of the directory, instead of each log syncing its "
+            "own segment. With --durable_wal_write, the segments are then written with O_DIRECT "
+            "but without O_SYNC, and the group commit makes the writes durable.");
+TAG_FLAG(log_group_commit, advanced);
+
 DEFINE_int32(log_inject_append_latency_ms_max, 0,
              "The maximum latency to inject before the log append operation.");
 
@@ -383,6 +393,11 @@ Status Log::Init() {
     active_segment_sequence_number_ = segments.back()->header().sequence_number();
   }
 
+  if (FLAGS_log_group_commit) {
+    // WAL directories have the <wal root>/table-<table id>/tablet-<tablet id> layout.
+    syncer_ = LogSyncer::Get(fs_manager_->env(), DirName(DirName(tablet_wal_path_)));
+  }
+
   if (durable_wal_write_) {
     YB_LOG_FIRST_N(INFO, 1) << "durable_wal_write is turned on.";
   } else if (interval_durable_wal_write_) {
@@ -661,7 +676,13 @@ Status Log::Sync() {
       periodic_sync_needed_.store(false);
       periodic_sync_unsynced_bytes_ = 0;
       LOG_SLOW_EXECUTION(WARNING, 50, "Fsync log took a long time") {
-        RETURN_NOT_OK(active_segment_->Sync());
+        if (syncer_) {
+          // Write out the data in this thread, so only the syncs are serialized by the syncer.
+          RETURN_NOT_OK(active_segment_->Flush());
+          RETURN_NOT_OK(syncer_->Sync(active_segment_->writable_file().get()));
+        } else {
+          RETURN_NOT_OK(active_segment_->Sync());
+        }
 
         if (log_hooks_) {
           RETURN_NOT_OK_PREPEND(log_hooks_->PostSyncIfFsyncEnabled(),
@@ -947,6 +968,8 @@ Status Log::PreAllocateNewSegment() {
   WritableFileOptions opts;
   opts.sync_on_close = durable_wal_write_;
   opts.o_direct = durable_wal_write_;
+  // With group commit, the syncer makes the writes durable, so they do not need O_SYNC.
+  opts.o_direct_sync_writes = syncer_ == nullptr;
   RETURN_NOT_OK(CreatePlaceholderSegment(opts, &next_segment_path_, &next_segment_file_));
 
   if (options_.preallocate_segments) {
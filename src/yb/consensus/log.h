@@ -67,6 +67,7 @@ struct LogMetrics;
 class LogEntryBatch;
 class LogIndex;
 class LogReader;
+class LogSyncer;
 
 // Log interface, inspired by Raft's (logcabin) Log. Provides durability to YugaByte as a normal
 // Write Ahead Log and also plays the role of persistent storage for the consensus state machine.
@@ -416,6 +417,9 @@ class Log : public RefCountedThreadSafe<Log> {
   // For periodic sync, indicates number of bytes which need to be sync'ed.
   size_t periodic_sync_unsynced_bytes_ = 0;
 
+  // Group commit syncer of the WAL root directory, if --log_group_commit is set.
+  std::shared_ptr<LogSyncer> syncer_;
+
   // If true, ignore the 'durable_wal_write_' flags above.  This is used to disable fsync during
   // bootstrap.
   bool sync_disabled_;
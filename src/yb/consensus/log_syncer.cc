@@ -0,0 +1,135 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_syncer.h"
+
+#include <unordered_map>
+
+#include "yb/util/debug/trace_event.h"
+#include "yb/util/env.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/thread.h"
+
+DEFINE_int32(log_group_commit_syncfs_min_logs, 4,
+             "With --log_group_commit, the minimum number of tablet logs waiting to be synced "
+             "for the group commit thread of a WAL directory to sync the whole file system with "
+             "a single syncfs() call instead of syncing the logs one by one. Note that syncfs() "
+             "also writes back any other dirty data of the file system. 0 to never use syncfs(), "
+             "in which case the logs are synced one by one by the group commit thread, which is "
+             "only worth it to limit the number of concurrent fsyncs.");
+TAG_FLAG(log_group_commit_syncfs_min_logs, advanced);
+TAG_FLAG(log_group_commit_syncfs_min_logs, runtime);
+
+namespace yb {
+namespace log {
+
+struct LogSyncer::Request {
+  WritableFile* file;
+  Status status;
+  bool done = false;
+};
+
+std::shared_ptr<LogSyncer> LogSyncer::Get(Env* env, const std::string& wal_root_dir) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::weak_ptr<LogSyncer>> syncers;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& weak_syncer = syncers[wal_root_dir];
+  auto syncer = weak_syncer.lock();
+  if (!syncer) {
+    syncer = std::make_shared<LogSyncer>(env, wal_root_dir);
+    CHECK_OK(syncer->Start());
+    weak_syncer = syncer;
+  }
+  return syncer;
+}
+
+LogSyncer::LogSyncer(Env* env, std::string wal_root_dir)
+    : env_(env), wal_root_dir_(std::move(wal_root_dir)) {
+}
+
+LogSyncer::~LogSyncer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queue_cond_.notify_one();
+  if (thread_) {
+    CHECK_OK(ThreadJoiner(thread_.get()).Join());
+  }
+}
+
+Status LogSyncer::Start() {
+  return Thread::Create("log", "log-sync", &LogSyncer::Run, this, &thread_);
+}
+
+Status LogSyncer::Sync(WritableFile* file) {
+  Request request;
+  request.file = file;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  queue_.push_back(&request);
+  queue_cond_.notify_one();
+  done_cond_.wait(lock, [&request] { return request.done; });
+  return request.status;
+}
+
+void LogSyncer::Run() {
+  std::vector<Request*> group;
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    queue_cond_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      // Logs release the syncer only after they are done with it, so nothing is left to sync.
+      break;
+    }
+    group.swap(queue_);
+    lock.unlock();
+
+    SyncGroup(group);
+
+    lock.lock();
+    for (auto* request : group) {
+      request->done = true;
+    }
+    group.clear();
+    done_cond_.notify_all();
+  }
+}
+
+void LogSyncer::SyncGroup(const std::vector<Request*>& group) {
+  TRACE_EVENT1("log", "LogSyncer::SyncGroup", "num_files", group.size());
+  num_files_synced_.fetch_add(group.size(), std::memory_order_acq_rel);
+
+  const auto syncfs_min_logs = FLAGS_log_group_commit_syncfs_min_logs;
+  if (syncfs_min_logs > 0 && group.size() >= static_cast<size_t>(syncfs_min_logs)) {
+    Status s = env_->SyncFileSystem(wal_root_dir_);
+    if (!s.IsNotSupported()) {
+      num_fsyncs_.fetch_add(1, std::memory_order_acq_rel);
+      for (auto* request : group) {
+        request->status = s;
+      }
+      return;
+    }
+    YB_LOG_FIRST_N(WARNING, 1) << "Falling back to syncing WAL files one by one: " << s;
+  }
+
+  for (auto* request : group) {
+    request->status = request->file->Sync();
+  }
+  num_fsyncs_.fetch_add(group.size(), std::memory_order_acq_rel);
+}
+
+}  // namespace log
+}  // namespace yb
@@ -0,0 +1,102 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_LOG_SYNCER_H_
+#define YB_CONSENSUS_LOG_SYNCER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/gutil/ref_counted.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+class Env;
+class Thread;
+class WritableFile;
+
+namespace log {
+
+// Group commit of the logs of all tablets that keep their WAL under the same root directory,
+// which normally means on the same disk.
+//
+// Without it, every tablet log syncs its active segment on its own after each group of appends,
+// so a server with many tablets issues a storm of small concurrent fsyncs to each disk. With it, a
+// log hands its segment to the syncer of its WAL root and waits. The syncer thread takes all the
+// segments queued since its previous round and makes them durable together: with a single
+// syncfs() of the whole file system once there are at least --log_group_commit_syncfs_min_logs of
+// them, or one by one otherwise. Logs that queue up while a round is in progress are synced in the
+// next one.
+class LogSyncer {
+ public:
+  // Returns the syncer shared by the logs under the given WAL root directory, starting a new one
+  // if there is none yet. The syncer stops when the last log using it releases it.
+  static std::shared_ptr<LogSyncer> Get(Env* env, const std::string& wal_root_dir);
+
+  LogSyncer(Env* env, std::string wal_root_dir);
+  ~LogSyncer();
+
+  // Makes the data written to the given file durable, coalescing it with the syncs requested by
+  // other logs. Blocks until the file is synced. The caller must not use the file meanwhile.
+  CHECKED_STATUS Sync(WritableFile* file);
+
+  const std::string& wal_root_dir() const {
+    return wal_root_dir_;
+  }
+
+  // Number of files synced through this syncer.
+  uint64_t num_files_synced() const {
+    return num_files_synced_.load(std::memory_order_acquire);
+  }
+
+  // Number of fsync() and syncfs() calls issued by this syncer.
+  uint64_t num_fsyncs() const {
+    return num_fsyncs_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Request;
+
+  CHECKED_STATUS Start();
+
+  void Run();
+
+  // Syncs the files of the given requests and sets their status.
+  void SyncGroup(const std::vector<Request*>& group);
+
+  Env* const env_;
+  const std::string wal_root_dir_;
+
+  scoped_refptr<Thread> thread_;
+
+  std::mutex mutex_;
+  // Signaled when a request is queued or the syncer is stopped.
+  std::condition_variable queue_cond_;
+  // Signaled when a group of requests is done.
+  std::condition_variable done_cond_;
+  std::vector<Request*> queue_;
+  bool stop_ = false;
+
+  std::atomic<uint64_t> num_files_synced_{0};
+  std::atomic<uint64_t> num_fsyncs_{0};
+};
+
+}  // namespace log
+}  // namespace yb
+
+#endif  // YB_CONSENSUS_LOG_SYNCER_H_
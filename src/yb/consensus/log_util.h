@@ -347,6 +347,11 @@ class WritableLogSegment {
     return writable_file_->Sync();
   }
 
+  // Writes out the data buffered by the file without waiting for it to become durable.
+  CHECKED_STATUS Flush() {
+    return writable_file_->Flush(WritableFile::FLUSH_ASYNC);
+  }
+
   // Returns true if the segment header has already been written to disk.
   bool IsHeaderWritten() const {
     return is_header_written_;
@@ -379,12 +384,12 @@ class WritableLogSegment {
     return written_offset_;
   }
 
- private:
-
   const std::shared_ptr<WritableFile>& writable_file() const {
     return writable_file_;
   }
 
+ private:
+
   // The path to the log file.
   const std::string path_;
 
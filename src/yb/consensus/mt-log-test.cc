@@ -32,15 +32,20 @@
 
 #include <algorithm>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include "yb/consensus/log-test-base.h"
 #include "yb/consensus/log_index.h"
+#include "yb/consensus/log_metrics.h"
+#include "yb/consensus/log_syncer.h"
 #include "yb/gutil/algorithm.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/locks.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/thread.h"
 
 // TODO: Semantics of the Log and Appender thread interactions changed and now multi-threaded
@@ -49,6 +54,11 @@
 DEFINE_int32(num_writer_threads, 1, "Number of threads writing to the log");
 DEFINE_int32(num_batches_per_thread, 2000, "Number of batches per thread");
 DEFINE_int32(num_ops_per_batch_avg, 5, "Target average number of ops per batch");
+DEFINE_int32(num_tablet_logs, 16, "Number of tablet logs written to by the multi-log benchmark");
+DEFINE_int32(num_appends_per_tablet_log, 500,
+             "Number of synchronous appends to each log in the multi-log benchmark");
+
+DECLARE_bool(log_group_commit);
 
 namespace yb {
 namespace log {
@@ -142,6 +152,65 @@ class MultiThreadedLogTest : public LogTestBase {
     ASSERT_EQ(0, errors.size());
   }
 
+  // Appends to FLAGS_num_tablet_logs logs in the same WAL root concurrently, one thread per log,
+  // each append waiting for its sync, and reports the appends and syncs per second.
+  void RunMultiLogBenchmark(bool group_commit) {
+    FLAGS_log_group_commit = group_commit;
+    options_.durable_wal_write = true;
+    Schema schema_with_ids = SchemaBuilder(schema_).Build();
+
+    vector<scoped_refptr<Log>> logs(FLAGS_num_tablet_logs);
+    for (int i = 0; i != FLAGS_num_tablet_logs; ++i) {
+      const string tablet_id = strings::Substitute("$0-$1-$2", kTestTablet, group_commit, i);
+      ASSERT_OK(Log::Open(options_,
+                          fs_manager_.get(),
+                          tablet_id,
+                          fs_manager_->GetFirstTabletWalDirOrDie(kTestTable, tablet_id),
+                          schema_with_ids,
+                          0, // schema_version
+                          metric_entity_.get(),
+                          append_pool_.get(),
+                          &logs[i]));
+    }
+    // All the logs share the metrics of the test entity.
+    LogMetrics metrics(metric_entity_);
+    const auto initial_syncs = metrics.sync_latency->TotalCount();
+    std::shared_ptr<LogSyncer> syncer;
+    if (group_commit) {
+      syncer = LogSyncer::Get(env_.get(), fs_manager_->GetWalRootDirs()[0]);
+    }
+
+    vector<std::thread> threads;
+    Stopwatch stopwatch;
+    stopwatch.start();
+    for (auto& log : logs) {
+      threads.emplace_back([this, &log] {
+        OpId op_id = consensus::MakeOpId(1, 1);
+        for (int i = 0; i != FLAGS_num_appends_per_tablet_log; ++i) {
+          ASSERT_OK(AppendNoOpToLogSync(clock_, log.get(), &op_id));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    stopwatch.stop();
+
+    const double seconds = stopwatch.elapsed().wall_seconds();
+    const auto appends = FLAGS_num_tablet_logs * FLAGS_num_appends_per_tablet_log;
+    const auto log_syncs = metrics.sync_latency->TotalCount() - initial_syncs;
+    // Without group commit, each log sync is an O_SYNC write of the log.
+    const auto disk_syncs = syncer ? syncer->num_fsyncs() : log_syncs;
+    LOG(INFO) << strings::Substitute(
+        "Group commit: $0, logs: $1, appends/sec: $2, log syncs/sec: $3, disk syncs/sec: $4",
+        group_commit, FLAGS_num_tablet_logs, appends / seconds, log_syncs / seconds,
+        disk_syncs / seconds);
+
+    for (auto& log : logs) {
+      ASSERT_OK(log->Close());
+    }
+  }
+
   void Run() {
     for (int i = 0; i < FLAGS_num_writer_threads; i++) {
       scoped_refptr<yb::Thread> new_thread;
@@ -186,5 +255,10 @@ TEST_F(MultiThreadedLogTest, TestAppends) {
   ASSERT_TRUE(std::is_sorted(ids.begin(), ids.end()));
 }
 
+TEST_F(MultiThreadedLogTest, BenchmarkGroupCommit) {
+  ASSERT_NO_FATALS(RunMultiLogBenchmark(false /* group_commit */));
+  ASSERT_NO_FATALS(RunMultiLogBenchmark(true /* group_commit */));
+}
+
 } // namespace log
 } // namespace yb
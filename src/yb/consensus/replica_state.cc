@@ -779,6 +779,9 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(IndexToRoundMap::iterator it
     max_allowed_op_id.index = std::numeric_limits<int64_t>::max();
   }
 
+  if (operation_factory_) {
+    operation_factory_->StartApplyGroup();
+  }
   while (iter != end_iter) {
     scoped_refptr<ConsensusRound> round = (*iter).second; // Make a copy.
     DCHECK(round);
@@ -809,6 +812,9 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(IndexToRoundMap::iterator it
     prev_id.CopyFrom(round->id());
     round->NotifyReplicationFinished(Status::OK());
   }
+  if (operation_factory_) {
+    operation_factory_->FinishApplyGroup();
+  }
 
   SetLastCommittedIndexUnlocked(committed_index);
 
@@ -190,6 +190,11 @@ Result<size_t> DocKey::EncodedSize(Slice slice, DocKeyPart part) {
   return slice.cdata() - initial_begin;
 }
 
+Slice DocKey::EncodedHashedPart(Slice slice) {
+  auto size = EncodedSize(slice, DocKeyPart::HASHED_PART_ONLY);
+  return size.ok() ? Slice(slice.data(), *size) : Slice();
+}
+
 class DocKey::DecodeFromCallback {
  public:
   explicit DecodeFromCallback(DocKey* key) : key_(key) {
@@ -354,6 +359,39 @@ KeyBytes DocKey::EncodedFromRedisKey(uint16_t hash, const std::string &key) {
   return result;
 }
 
+// ------------------------------------------------------------------------------------------------
+// KeyBounds
+// ------------------------------------------------------------------------------------------------
+
+namespace {
+
+KeyBytes EncodeHashPartitionBound(const std::string& partition_key) {
+  KeyBytes result;
+  if (!partition_key.empty()) {
+    // Document keys of a hash partitioned table start with the hash, which is what the partition
+    // key consists of.
+    result.AppendValueType(ValueType::kUInt16Hash);
+    result.AppendRawBytes(partition_key);
+  }
+  return result;
+}
+
+} // namespace
+
+KeyBounds KeyBounds::FromHashPartition(const std::string& partition_key_start,
+                                       const std::string& partition_key_end) {
+  KeyBounds result;
+  result.lower = EncodeHashPartitionBound(partition_key_start);
+  result.upper = EncodeHashPartitionBound(partition_key_end);
+  return result;
+}
+
+std::string KeyBounds::ToString() const {
+  return Substitute("[$0, $1)",
+                    lower.empty() ? "-Inf" : lower.AsSlice().ToDebugHexString(),
+                    upper.empty() ? "+Inf" : upper.AsSlice().ToDebugHexString());
+}
+
 // ------------------------------------------------------------------------------------------------
 // SubDocKey
 // ------------------------------------------------------------------------------------------------
@@ -122,6 +122,11 @@ class DocKey {
 
   static Result<size_t> EncodedSize(Slice slice, DocKeyPart part);
 
+  // Returns the prefix of the given encoded document key, or of a key that starts with one, that
+  // consists of the hash and the hashed components. Returns an empty slice if the key has no hash
+  // or could not be decoded.
+  static Slice EncodedHashedPart(Slice slice);
+
   // Decode the current document key from the given slice, but expect all bytes to be consumed, and
   // return an error status if that is not the case.
   CHECKED_STATUS FullyDecodeFrom(const rocksdb::Slice& slice);
@@ -192,6 +197,28 @@ inline std::ostream& operator <<(std::ostream& out, const DocKey& doc_key) {
   return out;
 }
 
+// Range [lower, upper) of encoded document keys that belong to a tablet. An empty bound means
+// that the range is not limited on that side.
+struct KeyBounds {
+  KeyBytes lower;
+  KeyBytes upper;
+
+  // Returns the bounds of the document keys of a hash partition with the given partition keys.
+  static KeyBounds FromHashPartition(const std::string& partition_key_start,
+                                     const std::string& partition_key_end);
+
+  bool IsWithinBounds(const Slice& key) const {
+    return (lower.empty() || key.compare(lower.AsSlice()) >= 0) &&
+           (upper.empty() || key.compare(upper.AsSlice()) < 0);
+  }
+
+  bool IsInitialized() const {
+    return !lower.empty() || !upper.empty();
+  }
+
+  std::string ToString() const;
+};
+
 // ------------------------------------------------------------------------------------------------
 // SubDocKey
 // ------------------------------------------------------------------------------------------------
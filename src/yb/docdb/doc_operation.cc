@@ -29,10 +29,12 @@
 #include "yb/docdb/doc_pgsql_scanspec.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/ql_column_batch.h"
 #include "yb/docdb/subdocument.h"
 
 #include "yb/server/hybrid_clock.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/stol_utils.h"
 #include "yb/util/trace.h"
 
@@ -47,6 +49,11 @@ DEFINE_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_int32(ql_read_batch_size, 1024,
+    "Number of rows read at a time into column vectors when evaluating the WHERE condition and "
+    "COUNT, SUM, MIN and MAX aggregates of a QL read. 0 reads and evaluates one row at a time.");
+TAG_FLAG(ql_read_batch_size, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -2509,6 +2516,18 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
     TRACE("Initialized iterator");
   }
 
+  if (request_.is_aggregate() && !schema.has_statics() && !read_distinct_columns) {
+    const bool aggregated = VERIFY_RESULT(AggregateInBatches(
+        non_static_projection, iter.get(), resultset));
+    if (aggregated) {
+      if (FLAGS_trace_docdb_calls) {
+        TRACE("Aggregated rows in batches");
+      }
+      *restart_read_ht = iter->RestartReadHt();
+      return Status::OK();
+    }
+  }
+
   QLTableRow static_row;
   QLTableRow non_static_row;
   QLTableRow& selected_row = read_distinct_columns ? static_row : non_static_row;
@@ -2658,6 +2677,50 @@ CHECKED_STATUS QLReadOperation::PopulateAggregate(const QLTableRow& table_row,
   return Status::OK();
 }
 
+Result<bool> QLReadOperation::AggregateInBatches(const Schema& projection,
+                                                 common::YQLRowwiseIteratorIf* iter,
+                                                 QLResultSet* resultset) {
+  auto* doc_iter = dynamic_cast<DocRowwiseIterator*>(iter);
+  if (FLAGS_ql_read_batch_size <= 0 || doc_iter == nullptr) {
+    return false;
+  }
+
+  QLColumnBatch batch(FLAGS_ql_read_batch_size);
+  for (const QLExpressionPB& expr : request_.selected_exprs()) {
+    if (!batch.AddAggregateColumns(expr)) {
+      return false;
+    }
+  }
+  const QLConditionPB* condition =
+      request_.has_where_expr() ? &request_.where_expr().condition() : nullptr;
+  if (condition != nullptr && !batch.AddConditionColumns(*condition)) {
+    return false;
+  }
+
+  if (aggr_result_.empty()) {
+    aggr_result_.resize(request_.selected_exprs().size());
+  }
+  size_t match_count = 0;
+  while (iter->HasNext()) {
+    RETURN_NOT_OK(doc_iter->NextBatch(projection, &batch));
+    batch.SelectAll();
+    if (condition != nullptr) {
+      RETURN_NOT_OK(batch.Filter(*condition));
+    }
+    match_count += batch.selection().size();
+    int aggr_index = 0;
+    for (const QLExpressionPB& expr : request_.selected_exprs()) {
+      RETURN_NOT_OK(batch.Aggregate(expr.tscall(), &aggr_result_[aggr_index]));
+      aggr_index++;
+    }
+  }
+
+  if (match_count > 0) {
+    RETURN_NOT_OK(PopulateAggregate(QLTableRow(), resultset));
+  }
+  return true;
+}
+
 CHECKED_STATUS QLReadOperation::AddRowToResult(const std::unique_ptr<common::QLScanSpec>& spec,
                                                const QLTableRow& row,
                                                const size_t row_count_limit,
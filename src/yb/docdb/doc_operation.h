@@ -321,6 +321,12 @@ class QLReadOperation : public DocExprExecutor {
   QLResponsePB& response() { return response_; }
 
  private:
+  // Reads the rows and evaluates the WHERE condition and the aggregates a batch of rows at a time.
+  // Returns false without reading any row if the request cannot be evaluated this way.
+  Result<bool> AggregateInBatches(const Schema& projection,
+                                  common::YQLRowwiseIteratorIf* iter,
+                                  QLResultSet* resultset);
+
   const QLReadRequestPB& request_;
   const TransactionOperationContextOpt txn_op_context_;
   QLResponsePB response_;
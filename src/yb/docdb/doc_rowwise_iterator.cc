@@ -22,10 +22,12 @@
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/ql_column_batch.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksutil/yb_rocksdb.h"
+#include "yb/util/trace.h"
 
 using std::string;
 
@@ -60,6 +62,9 @@ DocRowwiseIterator::DocRowwiseIterator(
 }
 
 DocRowwiseIterator::~DocRowwiseIterator() {
+  if (db_iter_ && db_iter_->readahead_stats().readaheads != 0) {
+    TRACE("Read ahead: $0", db_iter_->readahead_stats().ToString());
+  }
 }
 
 Status DocRowwiseIterator::Init() {
@@ -282,13 +287,12 @@ string DocRowwiseIterator::ToString() const {
 
 namespace {
 
-// Set primary key column values (hashed or range columns) in a QL row value map.
-CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
-                                           const size_t begin_index,
-                                           const size_t column_count,
-                                           const char* column_type,
-                                           const vector<PrimitiveValue>& values,
-                                           QLTableRow* table_row) {
+// Check that primary key column values (hashed or range columns) match the schema.
+CHECKED_STATUS CheckQLPrimaryKeyColumnCount(const Schema& schema,
+                                            const size_t begin_index,
+                                            const size_t column_count,
+                                            const char* column_type,
+                                            const vector<PrimitiveValue>& values) {
   if (values.size() != column_count) {
     return STATUS_SUBSTITUTE(Corruption, "$0 $1 primary key columns found but $2 expected",
                              values.size(), column_type, column_count);
@@ -299,6 +303,18 @@ CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
         "$0 primary key columns between positions $1 and $2 go beyond table columns $3",
         column_type, begin_index, begin_index + column_count - 1, schema.num_columns());
   }
+  return Status::OK();
+}
+
+// Set primary key column values (hashed or range columns) in a QL row value map.
+CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
+                                           const size_t begin_index,
+                                           const size_t column_count,
+                                           const char* column_type,
+                                           const vector<PrimitiveValue>& values,
+                                           QLTableRow* table_row) {
+  RETURN_NOT_OK(CheckQLPrimaryKeyColumnCount(
+      schema, begin_index, column_count, column_type, values));
   for (size_t i = 0, j = begin_index; i < column_count; i++, j++) {
     const auto ql_type = schema.column(j).type();
     QLTableColumn& column = table_row->AllocColumn(schema.column_id(j));
@@ -371,6 +387,64 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+Status DocRowwiseIterator::NextBatch(const Schema& projection, QLColumnBatch* batch) {
+  DCHECK(!schema_.has_statics());
+  batch->Reset();
+
+  // Map the key and projection columns to the batch columns once for the whole batch.
+  std::vector<int> key_column_indexes(schema_.num_key_columns());
+  for (size_t i = 0; i < key_column_indexes.size(); i++) {
+    key_column_indexes[i] = batch->ColumnIndex(schema_.column_id(i));
+  }
+  struct ValueColumn {
+    int index;
+    PrimitiveValue subkey;
+    std::shared_ptr<QLType> ql_type;
+  };
+  std::vector<ValueColumn> value_columns;
+  for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
+    const int index = batch->ColumnIndex(projection.column_id(i));
+    if (index >= 0) {
+      value_columns.push_back(
+          {index, PrimitiveValue(projection.column_id(i)), projection.column(i).type()});
+    }
+  }
+
+  while (!batch->full() && HasNext()) {
+    if (!status_.ok()) {
+      // An error happened in HasNext.
+      return status_;
+    }
+
+    const size_t row = batch->AddRow();
+    const auto& hashed_group = row_key_.hashed_group();
+    const auto& range_group = row_key_.range_group();
+    RETURN_NOT_OK(CheckQLPrimaryKeyColumnCount(
+        schema_, 0, schema_.num_hash_key_columns(), "hash", hashed_group));
+    RETURN_NOT_OK(CheckQLPrimaryKeyColumnCount(
+        schema_, schema_.num_hash_key_columns(), schema_.num_range_key_columns(), "range",
+        range_group));
+    for (size_t i = 0; i < key_column_indexes.size(); i++) {
+      if (key_column_indexes[i] >= 0) {
+        const PrimitiveValue& value = i < hashed_group.size()
+            ? hashed_group[i] : range_group[i - hashed_group.size()];
+        PrimitiveValue::ToQLValuePB(
+            value, schema_.column(i).type(), batch->mutable_value(key_column_indexes[i], row));
+      }
+    }
+
+    for (const auto& column : value_columns) {
+      const SubDocument* column_value = row_.GetChild(column.subkey);
+      if (column_value != nullptr) {
+        SubDocument::ToQLValuePB(
+            *column_value, column.ql_type, batch->mutable_value(column.index, row));
+      }
+    }
+    row_ready_ = false;
+  }
+  return Status::OK();
+}
+
 bool DocRowwiseIterator::LivenessColumnExists() const {
   const SubDocument* subdoc = row_.GetChild(
       PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
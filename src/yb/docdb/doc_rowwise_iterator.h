@@ -35,6 +35,7 @@ namespace yb {
 namespace docdb {
 
 class IntentAwareIterator;
+class QLColumnBatch;
 
 // An SQL-mapped-to-document-DB iterator.
 class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
@@ -98,6 +99,12 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Skip the current row.
   void SkipRow() override;
 
+  // Reads up to batch->capacity() rows into the batch, storing only the key and projection columns
+  // registered with the batch. Unlike NextRow(), no QLTableRow is built, and TTL and write time of
+  // the columns are not read. Should be called after HasNext() has returned true, and cannot be
+  // used for tables with static columns.
+  CHECKED_STATUS NextBatch(const Schema& projection, QLColumnBatch* batch);
+
   HybridTime RestartReadHt() override;
 
  private:
@@ -21,6 +21,7 @@
 #include "yb/rocksdb/util/statistics.h"
 
 #include "yb/common/hybrid_time.h"
+#include "yb/common/partition.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_compaction_filter.h"
 #include "yb/docdb/docdb_test_base.h"
@@ -2343,5 +2344,23 @@ TXN REV 30303030-3030-3030-3030-303030303032 HT{ physical: 5000 w: 1 } -> \
 }
 
 
+TEST_F(DocDBTest, CompactionRemovesKeysOutsideOfBounds) {
+  const HybridTime t0 = 1000_usec_ht;
+  for (const auto& entry : {std::make_pair(0x1000, "h1"), std::make_pair(0x5000, "h2"),
+                            std::make_pair(0x9000, "h3")}) {
+    const DocKey doc_key(entry.first, PrimitiveValues(entry.second));
+    ASSERT_OK(SetPrimitive(DocPath(doc_key.Encode(), PrimitiveValue("c")),
+                           PrimitiveValue("v"), t0));
+  }
+
+  // Bounds of the hash partition [0x4000, 0x8000), as if the tablet was split from a larger one.
+  SetKeyBounds(KeyBounds::FromHashPartition(PartitionSchema::EncodeMultiColumnHashValue(0x4000),
+                                            PartitionSchema::EncodeMultiColumnHashValue(0x8000)));
+  FullyCompactHistoryBefore(t0);
+  AssertDocDbDebugDumpStrEq(R"#(
+SubDocKey(DocKey(0x5000, ["h2"], []), ["c"; HT{ physical: 1000 }]) -> "v"
+      )#");
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -44,6 +44,7 @@
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/date_time.h"
 #include "yb/util/enums.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/status.h"
 #include "yb/util/metrics.h"
@@ -63,6 +64,10 @@ using yb::util::FormatBytesAsStr;
 using yb::FormatRocksDBSliceAsStr;
 using strings::Substitute;
 
+DEFINE_test_flag(bool, apply_intents_with_regular_delete, false,
+                 "Remove applied intents and their reverse index records with regular Delete "
+                 "instead of SingleDelete. Used as a baseline when checking how much of the "
+                 "applied intents reaches disk.");
 
 namespace yb {
 namespace docdb {
@@ -931,10 +936,20 @@ Slice DocHybridTimeBuffer::EncodeWithValueType(const DocHybridTime& doc_ht) {
   return Slice(buffer_.data(), end);
 }
 
-Status PrepareApplyIntentsBatch(
+namespace {
+
+// Walks the reverse index of the transaction, that lists all its intents, and removes intent and
+// reverse index records of the transaction from the intents DB.
+// When regular_batch is not null, the transaction is being applied: its strong intents are written
+// to regular_batch at commit_ht and its metadata is removed as well.
+// Otherwise the transaction was aborted, so its intents are just removed, while its metadata is
+// kept, so that status of the transaction could still be resolved for intents that it could write
+// after abort.
+Status DoPrepareApplyIntentsBatch(
     const TransactionId& transaction_id, HybridTime commit_ht,
     rocksdb::WriteBatch* regular_batch,
-    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
+    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch,
+    size_t* removed_intents) {
   Slice reverse_index_upperbound;
   auto reverse_index_iter = CreateRocksDBIterator(
       intents_db, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none, rocksdb::kDefaultQueryId,
@@ -956,7 +971,7 @@ Status PrepareApplyIntentsBatch(
   DocHybridTimeBuffer doc_ht_buffer;
 
   IntraTxnWriteId write_id = 0;
-  while (reverse_index_iter->Valid()) {
+  for (; reverse_index_iter->Valid(); reverse_index_iter->Next()) {
     rocksdb::Slice key_slice(reverse_index_iter->key());
 
     if (!key_slice.starts_with(txn_reverse_index_prefix.data())) {
@@ -968,14 +983,25 @@ Status PrepareApplyIntentsBatch(
 
     // If the key ends at the transaction id then it is transaction metadata (status tablet,
     // isolation level etc.).
-    if (key_slice.size() > txn_reverse_index_prefix.size()) {
-      // Value of reverse index is a key of original intent record, so seek it and check match.
-      intent_iter->Seek(reverse_index_iter->value());
-      if (!intent_iter->Valid() || intent_iter->key() != reverse_index_iter->value()) {
-        LOG(DFATAL) << "Unable to find intent: " << reverse_index_iter->value().ToDebugString()
-                    << " for " << reverse_index_iter->key().ToDebugString();
-        continue;
+    if (key_slice.size() == txn_reverse_index_prefix.size()) {
+      if (regular_batch) {
+        // Transaction metadata could be stored several times, so it requires regular delete.
+        intents_batch->Delete(reverse_index_iter->key());
       }
+      continue;
+    }
+
+    // Value of reverse index is a key of original intent record, so seek it and check match.
+    intent_iter->Seek(reverse_index_iter->value());
+    if (!intent_iter->Valid() || intent_iter->key() != reverse_index_iter->value()) {
+      LOG_IF(DFATAL, regular_batch)
+          << "Unable to find intent: " << reverse_index_iter->value().ToDebugString()
+          << " for " << reverse_index_iter->key().ToDebugString();
+      intents_batch->SingleDelete(reverse_index_iter->key());
+      continue;
+    }
+
+    if (regular_batch) {
       auto intent = VERIFY_RESULT(ParseIntentKey(intent_iter->key(), transaction_id_slice));
 
       if (IsStrongIntent(intent.type)) {
@@ -1002,17 +1028,46 @@ Status PrepareApplyIntentsBatch(
         regular_batch->Put(key_parts, value_parts);
         ++write_id;
       }
+    }
 
+    // Intent and reverse index keys contain hybrid time and write id, so each of them is written
+    // exactly once. SingleDelete cancels out with its put, so intents of a transaction that was
+    // applied before the memtable flush don't reach disk, not even as tombstones.
+    if (PREDICT_FALSE(FLAGS_apply_intents_with_regular_delete)) {
       intents_batch->Delete(intent_iter->key());
+      intents_batch->Delete(reverse_index_iter->key());
+    } else {
+      intents_batch->SingleDelete(intent_iter->key());
+      intents_batch->SingleDelete(reverse_index_iter->key());
+    }
+    if (removed_intents) {
+      ++*removed_intents;
     }
-
-    intents_batch->Delete(reverse_index_iter->key());
-
-    reverse_index_iter->Next();
   }
 
   return Status::OK();
 }
 
+}  // namespace
+
+Status PrepareApplyIntentsBatch(
+    const TransactionId& transaction_id, HybridTime commit_ht,
+    rocksdb::WriteBatch* regular_batch,
+    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
+  return DoPrepareApplyIntentsBatch(
+      transaction_id, commit_ht, DCHECK_NOTNULL(regular_batch), intents_db, intents_batch,
+      nullptr /* removed_intents */);
+}
+
+Result<size_t> PrepareRemoveIntentsBatch(
+    const TransactionId& transaction_id,
+    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
+  size_t removed_intents = 0;
+  RETURN_NOT_OK(DoPrepareApplyIntentsBatch(
+      transaction_id, HybridTime::kInvalid, nullptr /* regular_batch */, intents_db, intents_batch,
+      &removed_intents));
+  return removed_intents;
+}
+
 }  // namespace docdb
 }  // namespace yb
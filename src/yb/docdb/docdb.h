@@ -41,6 +41,7 @@
 #include "yb/docdb/value.h"
 #include "yb/docdb/subdocument.h"
 
+#include "yb/util/result.h"
 #include "yb/util/status.h"
 #include "yb/util/strongly_typed_bool.h"
 
@@ -163,6 +164,12 @@ CHECKED_STATUS PrepareApplyIntentsBatch(
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch);
 
+// Fills intents_batch with removal of intents of the aborted transaction. Transaction metadata is
+// kept. Returns number of removed intents.
+Result<size_t> PrepareRemoveIntentsBatch(
+    const TransactionId& transaction_id,
+    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch);
+
 // A visitor class that could be overridden to consume results of scanning SubDocuments.
 // See e.g. SubDocumentBuildingVisitor (used in implementing GetSubDocument) as example usage.
 // We can scan any SubDocument from a node in the document tree.
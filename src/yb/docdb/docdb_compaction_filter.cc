@@ -39,13 +39,15 @@ namespace docdb {
 DocDBCompactionFilter::DocDBCompactionFilter(HybridTime history_cutoff,
                                              ColumnIdsPtr deleted_cols,
                                              bool is_major_compaction,
-                                             MonoDelta table_ttl)
+                                             MonoDelta table_ttl,
+                                             const KeyBounds* key_bounds)
     : history_cutoff_(history_cutoff),
       is_major_compaction_(is_major_compaction),
       is_first_key_value_(true),
       filter_usage_logged_(false),
       table_ttl_(table_ttl),
-      deleted_cols_(deleted_cols) {
+      deleted_cols_(deleted_cols),
+      key_bounds_(key_bounds) {
 }
 
 DocDBCompactionFilter::~DocDBCompactionFilter() {
@@ -69,6 +71,12 @@ bool DocDBCompactionFilter::Filter(int level,
     return true;
   }
 
+  // Whole documents of other tablets are removed, so the history of the remaining documents
+  // tracked below is not affected.
+  if (key_bounds_ && !key_bounds_->IsWithinBounds(key)) {
+    return true;
+  }
+
   SubDocKey subdoc_key;
 
   // TODO: Find a better way for handling of data corruption encountered during compactions.
@@ -221,9 +229,9 @@ const char* DocDBCompactionFilter::Name() const {
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilterFactory::DocDBCompactionFilterFactory(
-    shared_ptr<HistoryRetentionPolicy> retention_policy)
-    :
-    retention_policy_(retention_policy) {
+    shared_ptr<HistoryRetentionPolicy> retention_policy, const KeyBounds* key_bounds)
+    : retention_policy_(retention_policy),
+      key_bounds_(key_bounds) {
 }
 
 DocDBCompactionFilterFactory::~DocDBCompactionFilterFactory() {
@@ -234,7 +242,8 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
   return unique_ptr<DocDBCompactionFilter>(
       new DocDBCompactionFilter(retention_policy_->GetHistoryCutoff(),
                                 retention_policy_->GetDeletedColumns(),
-                                context.is_full_compaction, retention_policy_->GetTableTTL()));
+                                context.is_full_compaction, retention_policy_->GetTableTTL(),
+                                key_bounds_));
 }
 
 const char* DocDBCompactionFilterFactory::Name() const {
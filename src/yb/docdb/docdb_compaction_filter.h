@@ -32,7 +32,8 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   DocDBCompactionFilter(HybridTime history_cutoff,
                         ColumnIdsPtr deleted_cols,
                         bool is_major_compaction,
-                        MonoDelta table_ttl);
+                        MonoDelta table_ttl,
+                        const KeyBounds* key_bounds = nullptr);
 
   ~DocDBCompactionFilter() override;
   bool Filter(int level,
@@ -100,6 +101,10 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   MonoDelta table_ttl_;
 
   ColumnIdsPtr deleted_cols_;
+
+  // Keys outside of these bounds belong to other tablets and are removed, e.g. when a tablet
+  // starts from hard links to the files of another tablet that covered a larger key range.
+  const KeyBounds* key_bounds_;
 };
 
 // A strategy for deciding the history cutoff. We may implement this differently in production and
@@ -139,7 +144,9 @@ class FixedHybridTimeRetentionPolicy : public HistoryRetentionPolicy {
 
 class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
  public:
-  explicit DocDBCompactionFilterFactory(std::shared_ptr<HistoryRetentionPolicy> retention_policy);
+  // key_bounds, if specified, should outlive the factory.
+  explicit DocDBCompactionFilterFactory(std::shared_ptr<HistoryRetentionPolicy> retention_policy,
+                                        const KeyBounds* key_bounds = nullptr);
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
@@ -147,6 +154,7 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
 
  private:
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
+  const KeyBounds* key_bounds_;
 };
 
 }  // namespace docdb
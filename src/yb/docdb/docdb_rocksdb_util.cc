@@ -16,6 +16,7 @@
 #include <thread>
 #include <memory>
 
+#include "yb/common/schema.h"
 #include "yb/common/transaction.h"
 
 #include "yb/rocksdb/rate_limiter.h"
@@ -25,6 +26,7 @@
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
+#include "yb/util/logging.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/trace.h"
 
@@ -65,6 +67,10 @@ DEFINE_int64(db_filter_block_size_bytes, 64_KB,
 DEFINE_int64(db_index_block_size_bytes, 32_KB,
              "Size of RocksDB index block (in bytes).");
 
+DEFINE_uint64(db_max_readahead_size_bytes, 2_MB,
+              "Maximum number of bytes read ahead by an iterator that reads the data blocks of an "
+              "SST file sequentially, e.g. during a range scan. 0 disables read-ahead.");
+
 DEFINE_int64(db_min_keys_per_index_block, 100,
              "Minimum number of keys per index block.");
 
@@ -80,6 +86,20 @@ DEFINE_bool(use_multi_level_index, true, "Whether to use multi-level data index.
 
 DEFINE_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
 
+DEFINE_string(rocksdb_compression_type, "snappy",
+              "Compression of the SST files of tables that do not set a compression of their own. "
+              "One of none, snappy, zlib, lz4 and zstd. Types this build does not support fall "
+              "back to snappy.");
+DEFINE_string(rocksdb_large_compaction_compression_type, "",
+              "Compression of the outputs of compactions of at least "
+              "--rocksdb_large_compaction_output_size_bytes, e.g. a stronger compression for the "
+              "bulk of cold data. Empty to use the compression of the table.");
+DEFINE_uint64(rocksdb_large_compaction_output_size_bytes, 0,
+              "Estimated output size above which a compaction uses "
+              "--rocksdb_large_compaction_compression_type. 0 to disable.");
+
+DECLARE_bool(enable_ondisk_compression);
+
 using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
@@ -90,6 +110,62 @@ namespace docdb {
 
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
 
+namespace {
+
+const std::pair<const char*, rocksdb::CompressionType> kCompressionTypeNames[] = {
+  {"none", rocksdb::kNoCompression},
+  {"snappy", rocksdb::kSnappyCompression},
+  {"zlib", rocksdb::kZlibCompression},
+  {"lz4", rocksdb::kLZ4Compression},
+  {"zstd", rocksdb::kZSTDNotFinalCompression},
+};
+
+const char* CompressionTypeName(rocksdb::CompressionType compression_type) {
+  for (const auto& entry : kCompressionTypeNames) {
+    if (entry.second == compression_type) {
+      return entry.first;
+    }
+  }
+  return "unknown";
+}
+
+Result<rocksdb::CompressionType> CompressionTypeFromName(const std::string& name) {
+  for (const auto& entry : kCompressionTypeNames) {
+    if (name == entry.first) {
+      return entry.second;
+    }
+  }
+  return STATUS_FORMAT(InvalidArgument, "Unknown compression type: $0", name);
+}
+
+// Returns the given compression type if this build supports it, otherwise the default one.
+rocksdb::CompressionType SupportedCompressionType(rocksdb::CompressionType compression_type) {
+  if (!FLAGS_enable_ondisk_compression) {
+    return rocksdb::kNoCompression;
+  }
+  if (rocksdb::IsCompressionTypeSupported(compression_type)) {
+    return compression_type;
+  }
+  const auto fallback = rocksdb::IsCompressionTypeSupported(rocksdb::kSnappyCompression)
+      ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+  YB_LOG_EVERY_N_SECS(WARNING, 60)
+      << "Compression type " << CompressionTypeName(compression_type)
+      << " is not supported by this build, using " << CompressionTypeName(fallback);
+  return fallback;
+}
+
+rocksdb::CompressionType CompressionTypeFromFlag(const std::string& flag_value,
+                                                 rocksdb::CompressionType default_type) {
+  auto compression_type = CompressionTypeFromName(flag_value);
+  if (!compression_type.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 60) << compression_type.status();
+    return SupportedCompressionType(default_type);
+  }
+  return SupportedCompressionType(*compression_type);
+}
+
+}  // namespace
+
 Status SeekToValidKvAtTs(
     rocksdb::Iterator *iter,
     const rocksdb::Slice &search_key,
@@ -332,10 +408,11 @@ rocksdb::ReadOptions PrepareReadOptions(
   }
   read_opts.file_filter = std::move(file_filter);
   read_opts.iterate_upper_bound = iterate_upper_bound;
+  read_opts.max_readahead_size = FLAGS_db_max_readahead_size_bytes;
   return read_opts;
 }
 
-} // namespace
+}  // namespace
 
 unique_ptr<rocksdb::Iterator> CreateRocksDBIterator(
     rocksdb::DB* rocksdb,
@@ -463,11 +540,49 @@ void InitRocksDBOptions(
     }
   }
 
+  options->compression = CompressionTypeFromFlag(
+      FLAGS_rocksdb_compression_type, rocksdb::kSnappyCompression);
+  if (compactions_enabled && FLAGS_rocksdb_large_compaction_output_size_bytes > 0 &&
+      !FLAGS_rocksdb_large_compaction_compression_type.empty()) {
+    options->compaction_options_universal.large_output_size_bytes =
+        FLAGS_rocksdb_large_compaction_output_size_bytes;
+    options->compaction_options_universal.large_output_compression = CompressionTypeFromFlag(
+        FLAGS_rocksdb_large_compaction_compression_type, options->compression);
+  }
+
   uint64_t max_file_size_for_compaction = FLAGS_rocksdb_max_file_size_for_compaction;
   if (max_file_size_for_compaction != 0) {
     options->max_file_size_for_compaction = max_file_size_for_compaction;
   }
 }
 
+void SetCompressionFromTableProperties(
+    rocksdb::Options* options, const TableProperties& table_properties) {
+  rocksdb::CompressionType compression_type;
+  switch (table_properties.compression()) {
+    case TableCompressionType::DEFAULT_COMPRESSION:
+      return;
+    case TableCompressionType::NO_COMPRESSION:
+      compression_type = rocksdb::kNoCompression;
+      break;
+    case TableCompressionType::SNAPPY_COMPRESSION:
+      compression_type = rocksdb::kSnappyCompression;
+      break;
+    case TableCompressionType::ZLIB_COMPRESSION:
+      compression_type = rocksdb::kZlibCompression;
+      break;
+    case TableCompressionType::LZ4_COMPRESSION:
+      compression_type = rocksdb::kLZ4Compression;
+      break;
+    case TableCompressionType::ZSTD_COMPRESSION:
+      compression_type = rocksdb::kZSTDNotFinalCompression;
+      break;
+    default:
+      LOG(DFATAL) << "Unknown table compression type: " << table_properties.compression();
+      return;
+  }
+  options->compression = SupportedCompressionType(compression_type);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -31,6 +31,9 @@
 #include "yb/util/slice.h"
 
 namespace yb {
+
+class TableProperties;
+
 namespace docdb {
 
 class IntentAwareIterator;
@@ -137,6 +140,13 @@ void InitRocksDBOptions(
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options);
 
+// Override the compression set up by InitRocksDBOptions with the one chosen for the table, if
+// any. An unsupported compression type falls back to the default one with a warning. RocksDB
+// compression is fixed when the DB is opened, so a changed table compression applies to the SST
+// files written after the tablet is reopened.
+void SetCompressionFromTableProperties(
+    rocksdb::Options* options, const TableProperties& table_properties);
+
 }  // namespace docdb
 }  // namespace yb
 
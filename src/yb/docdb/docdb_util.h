@@ -152,6 +152,11 @@ class DocDBRocksDBUtil {
 
   void SetTableTTL(uint64_t ttl_msec);
 
+  // Keys outside of the given bounds are removed by compactions.
+  void SetKeyBounds(const KeyBounds& key_bounds) {
+    key_bounds_ = key_bounds;
+  }
+
   void SetCurrentTransactionId(const TransactionId& txn_id) {
     current_txn_id_ = txn_id;
   }
@@ -196,6 +201,7 @@ class DocDBRocksDBUtil {
   std::shared_ptr<rocksdb::Cache> block_cache_;
   std::shared_ptr<FixedHybridTimeRetentionPolicy> retention_policy_ {
       std::make_shared<FixedHybridTimeRetentionPolicy>(HybridTime::kMin, MonoDelta::kMax) };
+  KeyBounds key_bounds_;
 
   rocksdb::WriteOptions write_options_;
   Schema schema_;
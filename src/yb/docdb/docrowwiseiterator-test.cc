@@ -19,9 +19,14 @@
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/ql_column_batch.h"
+
+#include "yb/common/ql_protocol_util.h"
 
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/util/bfql/tserver_opcodes.h"
+
 #include "yb/util/size_literals.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
@@ -955,5 +960,83 @@ TXN REV 30303030-3030-3030-3030-303030303031 HT{ physical: 500 w: 1 } -> \
   ASSERT_EQ(doc_ht.ToString(), "HT{ physical: 1000 }");
 }
 
+TEST_F(DocRowwiseIteratorTest, NextBatchFilterAndAggregate) {
+  // Rows (a, b) = ("rowN", N) with d = N * 10, and c set only for odd N.
+  constexpr int kNumRows = 7;
+  for (int i = 1; i <= kNumRows; i++) {
+    const KeyBytes encoded_doc_key(DocKey(PrimitiveValues(Format("row$0", i), i)).Encode());
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue(40_ColId)),
+        PrimitiveValue(i * 10), HybridTime::FromMicros(1000)));
+    if (i % 2 == 1) {
+      ASSERT_OK(SetPrimitive(
+          DocPath(encoded_doc_key, PrimitiveValue(30_ColId)),
+          PrimitiveValue(Format("row$0_c", i)), HybridTime::FromMicros(1000)));
+    }
+  }
+
+  // WHERE b >= 2 AND d < 70 AND c IS NULL matches rows 2, 4 and 6.
+  QLConditionPB condition;
+  condition.set_op(QL_OP_AND);
+  QLAddInt64Condition(&condition, 20, QL_OP_GREATER_THAN_EQUAL, 2);
+  QLAddInt64Condition(&condition, 40, QL_OP_LESS_THAN, 70);
+  QLConditionPB* is_null = condition.add_operands()->mutable_condition();
+  is_null->set_op(QL_OP_IS_NULL);
+  is_null->add_operands()->set_column_id(30);
+
+  std::vector<QLExpressionPB> exprs(5);
+  const std::vector<std::pair<bfql::TSOpcode, int>> calls = {
+      {bfql::TSOpcode::kCount, -1},
+      {bfql::TSOpcode::kCount, 30},
+      {bfql::TSOpcode::kSum, 40},
+      {bfql::TSOpcode::kMin, 40},
+      {bfql::TSOpcode::kMax, 40}};
+  // Use a batch smaller than the number of rows so that aggregates span several batches.
+  QLColumnBatch batch(3);
+  for (size_t i = 0; i < calls.size(); i++) {
+    QLBCallPB* tscall = exprs[i].mutable_tscall();
+    tscall->set_opcode(static_cast<int32_t>(calls[i].first));
+    if (calls[i].second < 0) {
+      tscall->add_operands()->mutable_value()->set_int64_value(1);
+    } else {
+      tscall->add_operands()->set_column_id(calls[i].second);
+    }
+    ASSERT_TRUE(batch.AddAggregateColumns(exprs[i]));
+  }
+  ASSERT_TRUE(batch.AddConditionColumns(condition));
+
+  DocRowwiseIterator iter(
+      kProjectionForIteratorTests, kSchemaForIteratorTests, kNonTransactionalOperationContext,
+      doc_db(), MonoTime::Max() /* deadline */, ReadHybridTime::FromMicros(2000));
+  ASSERT_OK(iter.Init());
+
+  std::vector<QLValue> aggr_results(exprs.size());
+  size_t num_rows = 0;
+  while (iter.HasNext()) {
+    ASSERT_OK(iter.NextBatch(kProjectionForIteratorTests, &batch));
+    ASSERT_LE(batch.num_rows(), batch.capacity());
+    num_rows += batch.num_rows();
+    batch.SelectAll();
+    ASSERT_OK(batch.Filter(condition));
+    for (size_t i = 0; i < exprs.size(); i++) {
+      ASSERT_OK(batch.Aggregate(exprs[i].tscall(), &aggr_results[i]));
+    }
+  }
+
+  ASSERT_EQ(kNumRows, num_rows);
+  ASSERT_EQ(3, aggr_results[0].int64_value());
+  ASSERT_TRUE(aggr_results[1].IsNull());
+  ASSERT_EQ(120, aggr_results[2].int64_value());
+  ASSERT_EQ(20, aggr_results[3].int64_value());
+  ASSERT_EQ(60, aggr_results[4].int64_value());
+
+  // Comparing a column with a value of another type is an error, as in the row by row path.
+  QLConditionPB mismatch;
+  QLSetStringCondition(&mismatch, 40, QL_OP_EQUAL, "10");
+  ASSERT_TRUE(batch.AddConditionColumns(mismatch));
+  batch.SelectAll();
+  ASSERT_NOK(batch.Filter(mismatch));
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -242,7 +242,9 @@ IntentAwareIterator::IntentAwareIterator(
                                                 nullptr /* file_filter */,
                                                 &intent_upperbound_);
   }
-  iter_.reset(doc_db.regular->NewIterator(read_opts));
+  rocksdb::ReadOptions regular_read_opts = read_opts;
+  regular_read_opts.readahead_stats = &readahead_stats_;
+  iter_.reset(doc_db.regular->NewIterator(regular_read_opts));
 }
 
 void IntentAwareIterator::Seek(const DocKey &doc_key) {
@@ -136,6 +136,9 @@ class IntentAwareIterator {
   ReadHybridTime read_time() { return read_time_; }
   HybridTime max_seen_ht() { return max_seen_ht_; }
 
+  // Statistics of the data read ahead while iterating over the regular DB.
+  const rocksdb::ReadaheadStats& readahead_stats() const { return readahead_stats_; }
+
   // If there is a key equal to key_bytes_without_ht + some timestamp, which is later than
   // max_deleted_ts, we update max_deleted_ts and result_value (unless it is nullptr).
   // This should not be used for leaf nodes. - Why? Looks like it is already used for leaf nodes
@@ -205,6 +208,8 @@ class IntentAwareIterator {
   const string encoded_read_time_local_limit_;
   const string encoded_read_time_global_limit_;
   const TransactionOperationContextOpt txn_op_context_;
+  // Updated by the SST file iterators of iter_, so should be destroyed after it.
+  rocksdb::ReadaheadStats readahead_stats_;
   std::unique_ptr<rocksdb::Iterator> intent_iter_;
   std::unique_ptr<rocksdb::Iterator> iter_;
   bool iter_valid_ = false;
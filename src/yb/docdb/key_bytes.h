@@ -207,6 +207,8 @@ class KeyBytes {
 
   size_t size() const { return data_.size(); }
 
+  bool empty() const { return data_.empty(); }
+
   bool IsPrefixOf(const rocksdb::Slice& slice) const {
     return slice.starts_with(data_);
   }
@@ -0,0 +1,416 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/ql_column_batch.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "yb/util/bfql/tserver_opcodes.h"
+
+namespace yb {
+namespace docdb {
+
+using yb::bfql::TSOpcode;
+
+namespace {
+
+bool IsColumnRelation(const QLConditionPB& condition) {
+  return condition.operands().size() == 2 &&
+         condition.operands(0).has_column_id() &&
+         condition.operands(1).has_value();
+}
+
+bool IsColumnNullCheck(const QLConditionPB& condition) {
+  return condition.operands().size() == 1 && condition.operands(0).has_column_id();
+}
+
+// Accessors used by the relational filter. The typed ones let the comparison loop work on the
+// native values, while ValuePB falls back to the QLValuePB comparison operators.
+struct ValuePB {
+  const QLValuePB& operator()(const QLValuePB& v) const { return v; }
+};
+
+struct Int32Value {
+  int32_t operator()(const QLValuePB& v) const { return v.int32_value(); }
+};
+
+struct Int64Value {
+  int64_t operator()(const QLValuePB& v) const { return v.int64_value(); }
+};
+
+struct StringValue {
+  const std::string& operator()(const QLValuePB& v) const { return v.string_value(); }
+};
+
+} // namespace
+
+QLColumnBatch::QLColumnBatch(size_t capacity) : capacity_(capacity) {
+  selection_.reserve(capacity_);
+}
+
+void QLColumnBatch::AddColumn(ColumnId column_id) {
+  if (ColumnIndex(column_id) >= 0) {
+    return;
+  }
+  column_ids_.push_back(column_id);
+  columns_.emplace_back(capacity_);
+}
+
+int QLColumnBatch::ColumnIndex(ColumnId column_id) const {
+  for (size_t i = 0; i < column_ids_.size(); i++) {
+    if (column_ids_[i] == column_id) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool QLColumnBatch::AddConditionColumns(const QLConditionPB& condition) {
+  switch (condition.op()) {
+    case QL_OP_AND:
+      if (condition.operands().empty()) {
+        return false;
+      }
+      for (const auto& operand : condition.operands()) {
+        if (!operand.has_condition() || !AddConditionColumns(operand.condition())) {
+          return false;
+        }
+      }
+      return true;
+
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EQUAL:
+      if (!IsColumnRelation(condition)) {
+        return false;
+      }
+      AddColumn(ColumnId(condition.operands(0).column_id()));
+      return true;
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL:
+      if (!IsColumnNullCheck(condition)) {
+        return false;
+      }
+      AddColumn(ColumnId(condition.operands(0).column_id()));
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+bool QLColumnBatch::AddAggregateColumns(const QLExpressionPB& expr) {
+  if (!expr.has_tscall() || expr.tscall().operands().size() != 1) {
+    return false;
+  }
+  const QLExpressionPB& operand = expr.tscall().operands(0);
+  switch (static_cast<TSOpcode>(expr.tscall().opcode())) {
+    case TSOpcode::kCount:
+      // COUNT(*) does not reference any column.
+      if (operand.has_column_id()) {
+        AddColumn(ColumnId(operand.column_id()));
+      }
+      return true;
+
+    case TSOpcode::kSum: FALLTHROUGH_INTENDED;
+    case TSOpcode::kMin: FALLTHROUGH_INTENDED;
+    case TSOpcode::kMax:
+      if (!operand.has_column_id()) {
+        return false;
+      }
+      AddColumn(ColumnId(operand.column_id()));
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void QLColumnBatch::Reset() {
+  num_rows_ = 0;
+  selection_.clear();
+}
+
+size_t QLColumnBatch::AddRow() {
+  DCHECK_LT(num_rows_, capacity_);
+  for (auto& column : columns_) {
+    column[num_rows_].Clear();
+  }
+  return num_rows_++;
+}
+
+void QLColumnBatch::SelectAll() {
+  selection_.resize(num_rows_);
+  for (size_t i = 0; i < num_rows_; i++) {
+    selection_[i] = i;
+  }
+}
+
+CHECKED_STATUS QLColumnBatch::Filter(const QLConditionPB& condition) {
+  switch (condition.op()) {
+    case QL_OP_AND:
+      for (const auto& operand : condition.operands()) {
+        if (selection_.empty()) {
+          break;
+        }
+        RETURN_NOT_OK(Filter(operand.condition()));
+      }
+      return Status::OK();
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL: {
+      const int index = ColumnIndex(ColumnId(condition.operands(0).column_id()));
+      DCHECK_GE(index, 0);
+      FilterNull(columns_[index], condition.op() == QL_OP_IS_NULL);
+      return Status::OK();
+    }
+
+    default:
+      return FilterRelational(condition);
+  }
+}
+
+void QLColumnBatch::FilterNull(const std::vector<QLValuePB>& column, bool is_null) {
+  size_t num_selected = 0;
+  for (const uint32_t row : selection_) {
+    selection_[num_selected] = row;
+    num_selected += IsNull(column[row]) == is_null;
+  }
+  selection_.resize(num_selected);
+}
+
+CHECKED_STATUS QLColumnBatch::FilterRelational(const QLConditionPB& condition) {
+  const int index = ColumnIndex(ColumnId(condition.operands(0).column_id()));
+  DCHECK_GE(index, 0);
+  const std::vector<QLValuePB>& column = columns_[index];
+  const QLValuePB& value = condition.operands(1).value();
+  switch (condition.op()) {
+    case QL_OP_EQUAL:
+      return FilterRelational(column, value, std::equal_to<>());
+    case QL_OP_LESS_THAN:
+      return FilterRelational(column, value, std::less<>());
+    case QL_OP_LESS_THAN_EQUAL:
+      return FilterRelational(column, value, std::less_equal<>());
+    case QL_OP_GREATER_THAN:
+      return FilterRelational(column, value, std::greater<>());
+    case QL_OP_GREATER_THAN_EQUAL:
+      return FilterRelational(column, value, std::greater_equal<>());
+    case QL_OP_NOT_EQUAL:
+      return FilterRelational(column, value, std::not_equal_to<>());
+    default:
+      return STATUS_FORMAT(NotSupported, "Unexpected operator $0 in batch filter",
+                           static_cast<int>(condition.op()));
+  }
+}
+
+namespace {
+
+// Keeps the selected rows whose column value satisfies "column op value". Values of the same type
+// as the operand are compared natively, null values follow the QLValuePB operator semantics used
+// by QLExprExecutor::EvalCondition, and values of any other type are not comparable.
+template <class Getter, class Op>
+CHECKED_STATUS SelectRelational(const std::vector<QLValuePB>& column,
+                                const QLValuePB& value,
+                                const Getter& get,
+                                const Op& op,
+                                std::vector<uint32_t>* selection) {
+  const auto value_case = value.value_case();
+  const auto& rhs = get(value);
+  size_t num_selected = 0;
+  for (const uint32_t row : *selection) {
+    const QLValuePB& lhs = column[row];
+    bool match;
+    if (PREDICT_TRUE(lhs.value_case() == value_case)) {
+      match = op(get(lhs), rhs);
+    } else if (EitherIsNull(lhs, value)) {
+      match = op(lhs, value);
+    } else {
+      return STATUS(RuntimeError, "values not comparable");
+    }
+    (*selection)[num_selected] = row;
+    num_selected += match;
+  }
+  selection->resize(num_selected);
+  return Status::OK();
+}
+
+} // namespace
+
+template <class Op>
+CHECKED_STATUS QLColumnBatch::FilterRelational(const std::vector<QLValuePB>& column,
+                                               const QLValuePB& value,
+                                               const Op& op) {
+  switch (value.value_case()) {
+    case QLValuePB::kInt32Value:
+      return SelectRelational(column, value, Int32Value(), op, &selection_);
+    case QLValuePB::kInt64Value:
+      return SelectRelational(column, value, Int64Value(), op, &selection_);
+    case QLValuePB::kStringValue:
+      return SelectRelational(column, value, StringValue(), op, &selection_);
+    default:
+      return SelectRelational(column, value, ValuePB(), op, &selection_);
+  }
+}
+
+CHECKED_STATUS QLColumnBatch::Aggregate(const QLBCallPB& tscall, QLValue* aggr_result) const {
+  if (selection_.empty()) {
+    return Status::OK();
+  }
+  const QLExpressionPB& operand = tscall.operands(0);
+  const std::vector<QLValuePB>* column = nullptr;
+  if (operand.has_column_id()) {
+    const int index = ColumnIndex(ColumnId(operand.column_id()));
+    DCHECK_GE(index, 0);
+    column = &columns_[index];
+  }
+
+  switch (static_cast<TSOpcode>(tscall.opcode())) {
+    case TSOpcode::kCount: {
+      int64_t count = 0;
+      if (column == nullptr) {
+        count = selection_.size();
+      } else {
+        // CQL does not count NULL value of a column.
+        for (const uint32_t row : selection_) {
+          count += !IsNull((*column)[row]);
+        }
+      }
+      if (count > 0) {
+        aggr_result->set_int64_value(
+            (aggr_result->IsNull() ? 0 : aggr_result->int64_value()) + count);
+      }
+      return Status::OK();
+    }
+
+    case TSOpcode::kSum:
+      return Sum(*column, aggr_result);
+
+    case TSOpcode::kMin: {
+      const int64_t row = FindMinMax(*column, false /* max */);
+      if (row >= 0 && (aggr_result->IsNull() || aggr_result->value() > (*column)[row])) {
+        *aggr_result->mutable_value() = (*column)[row];
+      }
+      return Status::OK();
+    }
+
+    case TSOpcode::kMax: {
+      const int64_t row = FindMinMax(*column, true /* max */);
+      if (row >= 0 && (aggr_result->IsNull() || aggr_result->value() < (*column)[row])) {
+        *aggr_result->mutable_value() = (*column)[row];
+      }
+      return Status::OK();
+    }
+
+    default:
+      return STATUS_FORMAT(NotSupported, "Unexpected opcode $0 in batch aggregate",
+                           tscall.opcode());
+  }
+}
+
+int64_t QLColumnBatch::FindMinMax(const std::vector<QLValuePB>& column, bool max) const {
+  int64_t result = -1;
+  for (const uint32_t row : selection_) {
+    const QLValuePB& value = column[row];
+    if (IsNull(value)) {
+      continue;
+    }
+    if (result < 0 || (max ? column[result] < value : column[result] > value)) {
+      result = row;
+    }
+  }
+  return result;
+}
+
+namespace {
+
+// Adds the non-null selected values to sum, in row order, so that the result is the same as
+// adding them one at a time with DocExprExecutor::EvalSum.
+template <class Sum, class Getter>
+Sum SumSelected(const std::vector<QLValuePB>& column,
+                const std::vector<uint32_t>& selection,
+                std::vector<uint32_t>::const_iterator begin,
+                Sum sum,
+                const Getter& get) {
+  for (auto it = begin; it != selection.end(); ++it) {
+    const QLValuePB& value = column[*it];
+    if (!IsNull(value)) {
+      sum = sum + get(value);
+    }
+  }
+  return sum;
+}
+
+} // namespace
+
+CHECKED_STATUS QLColumnBatch::Sum(const std::vector<QLValuePB>& column, QLValue* aggr_sum) const {
+  auto it = selection_.begin();
+  if (aggr_sum->IsNull()) {
+    while (it != selection_.end() && IsNull(column[*it])) {
+      ++it;
+    }
+    if (it == selection_.end()) {
+      return Status::OK();
+    }
+    *aggr_sum->mutable_value() = column[*it];
+    ++it;
+  }
+
+  // Narrow integer sums wrap around in the same way whether they are truncated after every
+  // addition or once at the end, so they are accumulated in 64 bits.
+  switch (aggr_sum->type()) {
+    case QLValue::InternalType::kInt8Value:
+      aggr_sum->set_int8_value(SumSelected<int64_t>(
+          column, selection_, it, aggr_sum->int8_value(),
+          [](const QLValuePB& v) { return v.int8_value(); }));
+      break;
+    case QLValue::InternalType::kInt16Value:
+      aggr_sum->set_int16_value(SumSelected<int64_t>(
+          column, selection_, it, aggr_sum->int16_value(),
+          [](const QLValuePB& v) { return v.int16_value(); }));
+      break;
+    case QLValue::InternalType::kInt32Value:
+      aggr_sum->set_int32_value(SumSelected<int64_t>(
+          column, selection_, it, aggr_sum->int32_value(), Int32Value()));
+      break;
+    case QLValue::InternalType::kInt64Value:
+      aggr_sum->set_int64_value(SumSelected<int64_t>(
+          column, selection_, it, aggr_sum->int64_value(), Int64Value()));
+      break;
+    case QLValue::InternalType::kFloatValue:
+      aggr_sum->set_float_value(SumSelected<float>(
+          column, selection_, it, aggr_sum->float_value(),
+          [](const QLValuePB& v) { return v.float_value(); }));
+      break;
+    case QLValue::InternalType::kDoubleValue:
+      aggr_sum->set_double_value(SumSelected<double>(
+          column, selection_, it, aggr_sum->double_value(),
+          [](const QLValuePB& v) { return v.double_value(); }));
+      break;
+    case QLValue::InternalType::kVarintValue:
+      aggr_sum->set_varint_value(SumSelected<util::VarInt>(
+          column, selection_, it, aggr_sum->varint_value(),
+          [](const QLValuePB& v) { return QLValue(v).varint_value(); }));
+      break;
+    default:
+      return STATUS(RuntimeError, "Cannot find SUM of this column");
+  }
+  return Status::OK();
+}
+
+}  // namespace docdb
+}  // namespace yb
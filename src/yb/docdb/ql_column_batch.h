@@ -0,0 +1,109 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_QL_COLUMN_BATCH_H_
+#define YB_DOCDB_QL_COLUMN_BATCH_H_
+
+#include <vector>
+
+#include "yb/common/ql_protocol.pb.h"
+#include "yb/common/ql_value.h"
+#include "yb/common/schema.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// A batch of rows read by DocRowwiseIterator::NextBatch() and stored column by column. Only the
+// columns registered with the batch are stored. The WHERE condition and the COUNT, SUM, MIN and MAX
+// aggregates of a QL read are evaluated over the batch as loops over the column vectors, instead of
+// building a QLTableRow and dispatching the expression tree once per row.
+//
+// The rows that satisfy the condition are tracked by a selection vector of row indexes, which is
+// narrowed by Filter() and consumed by Aggregate().
+class QLColumnBatch {
+ public:
+  explicit QLColumnBatch(size_t capacity);
+
+  // Registers the columns referenced by a WHERE condition. Returns false if the condition has a
+  // form that Filter() cannot evaluate, in which case the caller should read row by row.
+  bool AddConditionColumns(const QLConditionPB& condition);
+
+  // Registers the column referenced by a selected aggregate expression. Returns false if the
+  // expression is not an aggregate that Aggregate() can evaluate.
+  bool AddAggregateColumns(const QLExpressionPB& expr);
+
+  // Returns the index of the given column in the batch, or -1 if the column is not stored.
+  int ColumnIndex(ColumnId column_id) const;
+
+  size_t capacity() const { return capacity_; }
+  size_t num_rows() const { return num_rows_; }
+  bool full() const { return num_rows_ == capacity_; }
+
+  // Removes all rows, keeping the memory allocated for the column values.
+  void Reset();
+
+  // Appends a row with all columns set to null and returns its index.
+  size_t AddRow();
+
+  QLValuePB* mutable_value(int column_index, size_t row) {
+    return &columns_[column_index][row];
+  }
+
+  const QLValuePB& value(int column_index, size_t row) const {
+    return columns_[column_index][row];
+  }
+
+  // Selects all rows of the batch.
+  void SelectAll();
+
+  const std::vector<uint32_t>& selection() const { return selection_; }
+
+  // Removes the rows that do not satisfy the condition from the selection. The condition should
+  // have been accepted by AddConditionColumns().
+  CHECKED_STATUS Filter(const QLConditionPB& condition);
+
+  // Evaluates the aggregate call over the selected rows, accumulating into aggr_result in the
+  // same way DocExprExecutor does for individual rows.
+  CHECKED_STATUS Aggregate(const QLBCallPB& tscall, QLValue* aggr_result) const;
+
+ private:
+  void AddColumn(ColumnId column_id);
+
+  CHECKED_STATUS FilterRelational(const QLConditionPB& condition);
+
+  template <class Op>
+  CHECKED_STATUS FilterRelational(const std::vector<QLValuePB>& column,
+                                  const QLValuePB& value,
+                                  const Op& op);
+
+  void FilterNull(const std::vector<QLValuePB>& column, bool is_null);
+
+  CHECKED_STATUS Sum(const std::vector<QLValuePB>& column, QLValue* aggr_sum) const;
+
+  // Returns the index of the selected row with the smallest (or, for max, largest) non-null
+  // value of the column, or -1 if all selected values are null.
+  int64_t FindMinMax(const std::vector<QLValuePB>& column, bool max) const;
+
+  const size_t capacity_;
+  size_t num_rows_ = 0;
+
+  std::vector<ColumnId> column_ids_;
+  std::vector<std::vector<QLValuePB>> columns_;
+  std::vector<uint32_t> selection_;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_QL_COLUMN_BATCH_H_
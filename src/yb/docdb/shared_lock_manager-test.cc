@@ -19,8 +19,17 @@
 
 #include "yb/docdb/shared_lock_manager.h"
 
+#include "yb/gutil/sysinfo.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
+
+DEFINE_bool(assert_lock_table_scaling, false,
+            "Whether ShardedLockTableScaling should fail when sharded lock table throughput does "
+            "not scale. Only meaningful on an otherwise idle machine with enough cores.");
 
 using std::string;
 using std::vector;
@@ -383,5 +392,81 @@ TEST_F(SharedLockManagerTest, LockBatchReset) {
   EXPECT_TRUE(lb.empty());
 }
 
+namespace {
+
+// Each writer repeatedly locks a batch of random keys, similar to what a tablet does for a write
+// batch, and returns the number of batches it has locked.
+size_t LockBatchesUntilStopped(
+    SharedLockManager* lock_manager, int thread_index, const std::atomic<bool>& stop) {
+  constexpr size_t kKeysPerBatch = 8;
+  constexpr int kNumKeys = 1000000;
+  std::mt19937_64 rng(thread_index);
+  size_t num_batches = 0;
+  while (!stop.load(std::memory_order_acquire)) {
+    KeyToIntentTypeMap keys;
+    while (keys.size() < kKeysPerBatch) {
+      keys.emplace("key" + std::to_string(RandomUniformInt(0, kNumKeys - 1, &rng)),
+                   IntentType::kStrongSnapshotWrite);
+    }
+    LockBatch batch(lock_manager, std::move(keys));
+    ++num_batches;
+  }
+  return num_batches;
+}
+
+double MeasureLockBatchesPerSecond(size_t num_shards, int num_threads, MonoDelta duration) {
+  SharedLockManager lock_manager(num_shards);
+  std::atomic<bool> stop{false};
+  std::atomic<size_t> total_batches{0};
+  std::vector<std::thread> threads;
+  Stopwatch sw;
+  sw.start();
+  for (int i = 0; i != num_threads; ++i) {
+    threads.emplace_back([&lock_manager, &stop, &total_batches, i] {
+      total_batches += LockBatchesUntilStopped(&lock_manager, i, stop);
+    });
+  }
+  SleepFor(duration);
+  stop.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  sw.stop();
+  return total_batches.load() / sw.elapsed().wall_seconds();
+}
+
+} // namespace
+
+// Compares lock batch throughput of a single shard lock table with the default sharded one while
+// the number of writer threads grows. Throughput ratios are only logged, unless
+// --assert_lock_table_scaling is set.
+TEST_F(SharedLockManagerTest, ShardedLockTableScaling) {
+  const int max_threads = AllowSlowTests() ? RegularBuildVsSanitizers(64, 8) : 8;
+  const auto duration = MonoDelta::FromMilliseconds(AllowSlowTests() ? 1000 : 200);
+  const bool multicore = base::NumCPUs() >= 4 && !IsSanitizer();
+  double sharded_single_thread = 0;
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    const auto single_shard = MeasureLockBatchesPerSecond(1, num_threads, duration);
+    const auto sharded = MeasureLockBatchesPerSecond(0, num_threads, duration);
+    if (num_threads == 1) {
+      sharded_single_thread = sharded;
+    }
+    LOG(INFO) << "Threads: " << num_threads
+              << ", batches/sec with 1 shard: " << single_shard
+              << ", with " << SharedLockManager().num_shards() << " shards: " << sharded
+              << ", sharded vs 1 shard: " << sharded / single_shard
+              << ", sharded vs sharded with 1 thread: " << sharded / sharded_single_thread;
+    if (!FLAGS_assert_lock_table_scaling) {
+      continue;
+    }
+    // Sharding only adds grouping of keys by shard, so it should never be much slower.
+    ASSERT_GE(sharded, single_shard * 0.75) << "Threads: " << num_threads;
+    if (multicore && num_threads == 4) {
+      // Writers of random keys rarely meet in the same shard, so they should run in parallel.
+      ASSERT_GT(sharded, sharded_single_thread * 1.5);
+    }
+  }
+}
+
 } // namespace docdb
 } // namespace yb
@@ -13,11 +13,14 @@
 
 #include "yb/docdb/shared_lock_manager.h"
 
+#include <algorithm>
 #include <vector>
 
-#include <boost/range/adaptor/reversed.hpp>
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 
+#include "yb/gutil/bits.h"
+#include "yb/gutil/sysinfo.h"
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
@@ -26,6 +29,10 @@
 
 using std::string;
 
+DEFINE_int32(shared_lock_manager_num_shards, 0,
+             "Number of shards in the lock table of each tablet's shared lock manager. Rounded up "
+             "to a power of two. 0 means use the number of CPUs.");
+
 namespace yb {
 namespace docdb {
 
@@ -79,8 +86,29 @@ std::array<LockState, kIntentTypeMapSize> MakeConflicts() {
   return result;
 }
 
+size_t NumLockShards(size_t requested) {
+  if (requested == 0) {
+    requested = FLAGS_shared_lock_manager_num_shards > 0 ? FLAGS_shared_lock_manager_num_shards
+                                                         : base::NumCPUs();
+  }
+  requested = std::max<size_t>(requested, 1);
+  // Round up to a power of two, so that the shard could be selected with a mask.
+  return 1ULL << Bits::Log2Ceiling64(requested);
+}
+
 } // namespace
 
+SharedLockManager::SharedLockManager(size_t num_shards)
+    : num_shards_(NumLockShards(num_shards)),
+      shards_(new LockShard[num_shards_]) {
+}
+
+SharedLockManager::~SharedLockManager() {
+  for (size_t i = 0; i != num_shards_; ++i) {
+    DCHECK(shards_[i].locks.empty()) << "Lock table shard " << i << " is not empty on destruction";
+  }
+}
+
 // The conflict matrix. (CONFLICTS[i] & (1 << j)) is one iff LockTypes i and j conflict.
 // https://docs.google.com/document/d/1MLpW-9Hjx64U6mNQzVY9w5zUliJ9TYJ7772oAp7jwaA
 // https://docs.google.com/spreadsheets/d/1h8GosY5XnJvrsyjEqyuXdKYlwvfKIaqx_RyDQGd7rSc
@@ -226,9 +254,30 @@ void SharedLockManager::LockEntry::Unlock(IntentType lock_type) {
   }
 }
 
+size_t SharedLockManager::ShardIndex(const std::string& key) const {
+  return std::hash<std::string>()(key) & (num_shards_ - 1);
+}
+
+SharedLockManager::ShardedKeys SharedLockManager::GroupByShard(
+    const KeyToIntentTypeMap& key_to_intent_type) const {
+  ShardedKeys result;
+  result.reserve(key_to_intent_type.size());
+  size_t index = 0;
+  for (const auto& key_and_intent_type : key_to_intent_type) {
+    result.push_back({ShardIndex(key_and_intent_type.first), index, &key_and_intent_type});
+    ++index;
+  }
+  std::sort(result.begin(), result.end(), [](const ShardedKey& lhs, const ShardedKey& rhs) {
+    return lhs.shard < rhs.shard || (lhs.shard == rhs.shard && lhs.index < rhs.index);
+  });
+  return result;
+}
+
 void SharedLockManager::Lock(const KeyToIntentTypeMap& key_to_intent_type) {
   TRACE("Locking a batch of $0 keys", key_to_intent_type.size());
   std::vector<SharedLockManager::LockEntry*> reserved = Reserve(key_to_intent_type);
+  // Keys are locked in the order of the batch, i.e. sorted by key, regardless of the shard they
+  // belong to. This total order is what makes concurrent batch acquisition deadlock-free.
   size_t idx = 0;
   for (const auto& key_and_intent_type : key_to_intent_type) {
     const auto intent_type = key_and_intent_type.second;
@@ -242,14 +291,18 @@ void SharedLockManager::Lock(const KeyToIntentTypeMap& key_to_intent_type) {
 
 std::vector<SharedLockManager::LockEntry*> SharedLockManager::Reserve(
     const KeyToIntentTypeMap& key_to_intent_type) {
-  std::vector<SharedLockManager::LockEntry*> reserved;
-  reserved.reserve(key_to_intent_type.size());
-  {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    for (const auto& key_and_intent_type : key_to_intent_type) {
-      auto it = locks_.emplace(key_and_intent_type.first, std::make_unique<LockEntry>()).first;
-      it->second->num_using++;
-      reserved.push_back(&*it->second);
+  std::vector<SharedLockManager::LockEntry*> reserved(key_to_intent_type.size());
+  const auto sharded_keys = GroupByShard(key_to_intent_type);
+  auto it = sharded_keys.begin();
+  while (it != sharded_keys.end()) {
+    auto& shard = shards_[it->shard];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto shard_index = it->shard;
+    for (; it != sharded_keys.end() && it->shard == shard_index; ++it) {
+      auto entry_it = shard.locks.emplace(
+          it->key_and_intent_type->first, std::make_unique<LockEntry>()).first;
+      entry_it->second->num_using++;
+      reserved[it->index] = entry_it->second.get();
     }
   }
   return reserved;
@@ -257,13 +310,20 @@ std::vector<SharedLockManager::LockEntry*> SharedLockManager::Reserve(
 
 void SharedLockManager::Unlock(const KeyToIntentTypeMap& key_to_intent_type) {
   TRACE("Unlocking a batch of $0 keys", key_to_intent_type.size());
-  std::lock_guard<std::mutex> lock(global_mutex_);
-  for (const auto& key_and_intent_type : boost::adaptors::reverse(key_to_intent_type)) {
-    VLOG(4) << "Unlocking " << docdb::ToString(key_and_intent_type.second) << ": "
-            << util::FormatBytesAsStr(key_and_intent_type.first);
-    locks_[key_and_intent_type.first]->Unlock(key_and_intent_type.second);
+  const auto sharded_keys = GroupByShard(key_to_intent_type);
+  auto it = sharded_keys.begin();
+  while (it != sharded_keys.end()) {
+    auto& shard = shards_[it->shard];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto shard_index = it->shard;
+    for (; it != sharded_keys.end() && it->shard == shard_index; ++it) {
+      const auto& key_and_intent_type = *it->key_and_intent_type;
+      VLOG(4) << "Unlocking " << docdb::ToString(key_and_intent_type.second) << ": "
+              << util::FormatBytesAsStr(key_and_intent_type.first);
+      shard.locks[key_and_intent_type.first]->Unlock(key_and_intent_type.second);
+      Cleanup(key_and_intent_type, &shard);
+    }
   }
-  Cleanup(key_to_intent_type);
 }
 
 void SharedLockManager::LockInTest(const string& key, IntentType intent_type) {
@@ -274,13 +334,12 @@ void SharedLockManager::UnlockInTest(const string& key, IntentType intent_type)
   Unlock({{key, intent_type}});
 }
 
-void SharedLockManager::Cleanup(const KeyToIntentTypeMap& key_to_intent_type) {
-  for (const auto& item : key_to_intent_type) {
-    auto it = locks_.find(item.first);
-    it->second->num_using--;
-    if (it->second->num_using == 0) {
-      locks_.erase(it);
-    }
+void SharedLockManager::Cleanup(
+    const KeyToIntentTypeMap::value_type& key_and_intent_type, LockShard* shard) {
+  auto it = shard->locks.find(key_and_intent_type.first);
+  it->second->num_using--;
+  if (it->second->num_using == 0) {
+    shard->locks.erase(it);
   }
 }
 
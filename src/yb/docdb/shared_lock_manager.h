@@ -22,6 +22,7 @@
 
 #include "yb/docdb/shared_lock_manager_fwd.h"
 #include "yb/docdb/lock_batch.h"
+#include "yb/gutil/port.h"
 #include "yb/gutil/spinlock.h"
 #include "yb/util/cross_thread_mutex.h"
 
@@ -34,8 +35,19 @@ namespace docdb {
 // - Multiple kStrongSerializableRead and kWeakSerializableRead
 // - Multiple kStrongSerializableWrite and kWeakSerializableWrite
 // - Multiple kWeakSnapshotWrite, kWeakSerializableRead, and kWeakSerializableWrite
+//
+// Lock entries are kept in a table that is hash-sharded by key, so that writers working on
+// disjoint keys do not serialize on a single mutex. A batch is reserved and released with one
+// critical section per shard it touches.
 class SharedLockManager {
  public:
+  // num_shards is rounded up to a power of two. Zero means use the shared_lock_manager_num_shards
+  // flag, or the number of CPUs if the flag is not set.
+  explicit SharedLockManager(size_t num_shards = 0);
+  ~SharedLockManager();
+
+  SharedLockManager(const SharedLockManager&) = delete;
+  void operator=(const SharedLockManager&) = delete;
 
   // Attempt to lock a batch of keys. The call may be blocked waiting for other locks to be
   // released. If the entries don't exist, they are created. The lock batch gets associated with
@@ -55,6 +67,8 @@ class SharedLockManager {
   static bool VerifyState(const LockState& state);
   static std::string ToString(const LockState& state);
 
+  size_t num_shards() const { return num_shards_; }
+
  private:
 
   struct LockEntry {
@@ -81,19 +95,40 @@ class SharedLockManager {
 
   typedef std::unordered_map<std::string, std::unique_ptr<LockEntry>> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
+  // Shards are aligned to a cache line, so that neighbouring shard mutexes do not share one.
+  struct alignas(CACHELINE_SIZE) LockShard {
+    // Should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    // Can only be modified if the shard mutex is held.
+    LockEntryMap locks;
+  };
+
+  // A key of the batch together with its position in the batch and the shard it belongs to.
+  struct ShardedKey {
+    size_t shard;
+    size_t index;
+    const KeyToIntentTypeMap::value_type* key_and_intent_type;
+  };
+
+  typedef std::vector<ShardedKey> ShardedKeys;
+
+  size_t ShardIndex(const std::string& key) const;
+
+  // Returns keys of the batch ordered by shard, and by position in the batch within a shard.
+  ShardedKeys GroupByShard(const KeyToIntentTypeMap& key_to_intent_type) const;
+
+  // Make sure the entries exist in the shard maps and return pointers so we can access
+  // them without holding shard locks. Returns a vector with pointers in the same order
   // as the keys in the batch.
   std::vector<LockEntry*> Reserve(const KeyToIntentTypeMap& batch);
 
-  // Update refcounts and maybe collect garbage.
-  void Cleanup(const KeyToIntentTypeMap& key_to_intent_type);
+  // Update refcounts and maybe collect garbage. Requires that the shard mutex is held.
+  void Cleanup(const KeyToIntentTypeMap::value_type& key_and_intent_type, LockShard* shard);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  const size_t num_shards_;
 
-  // Can only be modified if the global mutex is held.
-  LockEntryMap locks_;
+  std::unique_ptr<LockShard[]> shards_;
 };
 
 extern const std::array<LockState, kIntentTypeMapSize> kIntentConflicts;
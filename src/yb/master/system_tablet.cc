@@ -49,7 +49,8 @@ void SystemTablet::UnregisterReader(HybridTime read_point) {
 }
 
 HybridTime SystemTablet::DoGetSafeTime(
-    tablet::RequireLease require_lease, HybridTime min_allowed, MonoTime deadline) const {
+    tablet::RequireLease require_lease, HybridTime min_allowed, MonoTime deadline,
+    const std::vector<std::string>* hashed_keys) const {
   // HybridTime doesn't matter for SystemTablets.
   return HybridTime::kMax;
 }
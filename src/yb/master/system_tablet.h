@@ -75,7 +75,8 @@ class SystemTablet : public tablet::AbstractTablet {
   const TableName& GetTableName() const;
  private:
   HybridTime DoGetSafeTime(
-      tablet::RequireLease require_lease, HybridTime min_allowed, MonoTime deadline) const override;
+      tablet::RequireLease require_lease, HybridTime min_allowed, MonoTime deadline,
+      const std::vector<std::string>* hashed_keys) const override;
 
   Schema schema_;
   std::unique_ptr<YQLVirtualTable> yql_virtual_table_;
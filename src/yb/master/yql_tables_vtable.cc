@@ -82,6 +82,37 @@ Status YQLTablesVTable::RetrieveData(const QLReadRequestPB& request,
     dtxn.add_map_value()->set_string_value(schema.table_properties().is_transactional() ?
                                            "true" : "false");
     RETURN_NOT_OK(SetColumnValue(kTransactions, dtxn.value(), &row));
+
+    const char* compression_class = nullptr;
+    switch (schema.table_properties().compression()) {
+      case TableCompressionType::DEFAULT_COMPRESSION: FALLTHROUGH_INTENDED;
+      case TableCompressionType::NO_COMPRESSION:
+        break;
+      case TableCompressionType::SNAPPY_COMPRESSION:
+        compression_class = "org.apache.cassandra.io.compress.SnappyCompressor";
+        break;
+      case TableCompressionType::ZLIB_COMPRESSION:
+        compression_class = "org.apache.cassandra.io.compress.DeflateCompressor";
+        break;
+      case TableCompressionType::LZ4_COMPRESSION:
+        compression_class = "org.apache.cassandra.io.compress.LZ4Compressor";
+        break;
+      case TableCompressionType::ZSTD_COMPRESSION:
+        compression_class = "org.apache.cassandra.io.compress.ZstdCompressor";
+        break;
+    }
+    if (schema.table_properties().compression() != TableCompressionType::DEFAULT_COMPRESSION) {
+      QLValue compression;
+      compression.set_map_value();
+      if (compression_class != nullptr) {
+        compression.add_map_key()->set_string_value("class");
+        compression.add_map_value()->set_string_value(compression_class);
+      } else {
+        compression.add_map_key()->set_string_value("enabled");
+        compression.add_map_value()->set_string_value("false");
+      }
+      RETURN_NOT_OK(SetColumnValue(kCompression, compression.value(), &row));
+    }
   }
 
   return Status::OK();
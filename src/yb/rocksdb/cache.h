@@ -60,12 +60,28 @@ class Cache;
 // is divided and evenly assigned to each shard.
 //
 // The parameter num_shard_bits defaults to 4, and strict_capacity_limit
-// defaults to false.
+// defaults to false. A negative num_shard_bits selects
+// GetDefaultCacheShardBits().
 extern shared_ptr<Cache> NewLRUCache(size_t capacity);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
 
+// Create a new cache with a CLOCK (second chance) eviction policy, sharded
+// in the same way as the LRU cache. Hits do not reorder any list and only
+// take the shard lock in shared mode, and entries are evicted lazily when
+// new entries are inserted. Better suited than the LRU cache for a block
+// cache shared by many threads.
+//
+// The parameter num_shard_bits defaults to GetDefaultCacheShardBits(), and
+// strict_capacity_limit defaults to false.
+extern shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits = -1,
+                                       bool strict_capacity_limit = false);
+
+// Returns the number of shard bits to use for a cache shared by all cores of
+// this machine: enough for two shards per core, but no fewer than 4 bits.
+extern int GetDefaultCacheShardBits();
+
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
 constexpr QueryId kDefaultQueryId = 0;
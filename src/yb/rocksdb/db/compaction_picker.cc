@@ -1301,6 +1301,22 @@ void GetSmallestLargestSeqno(const std::vector<FileMetaData*>& files,
 }  // namespace
 #endif
 
+namespace {
+// Compression type of the output of a universal compaction with the given estimated size. Outputs
+// of at least large_output_size_bytes use large_output_compression, so that the bulk of the data
+// can be stored with a stronger compression than the recently flushed files.
+CompressionType UniversalOutputCompression(const ImmutableCFOptions& ioptions, int level,
+                                           uint64_t estimated_output_size,
+                                           bool enable_compression = true) {
+  const auto& universal_options = ioptions.compaction_options_universal;
+  if (enable_compression && universal_options.large_output_size_bytes > 0 &&
+      estimated_output_size >= universal_options.large_output_size_bytes) {
+    return universal_options.large_output_compression;
+  }
+  return GetCompressionType(ioptions, level, 1, enable_compression);
+}
+}  // namespace
+
 // Algorithm that checks to see if there are any overlapping
 // files in the input
 bool CompactionPicker::IsInputNonOverlapping(Compaction* c) {
@@ -1711,7 +1727,8 @@ Compaction* UniversalCompactionPicker::PickCompactionUniversalReadAmp(
   return new Compaction(
       vstorage, mutable_cf_options, std::move(inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, start_level, 1, enable_compression),
+      UniversalOutputCompression(ioptions_, start_level, estimated_total_size,
+                                 enable_compression),
       /* grandparents */ {}, /* is manual */ false, score,
       false /* deletion_compaction */, compaction_reason);
 }
@@ -1833,7 +1850,7 @@ Compaction* UniversalCompactionPicker::PickCompactionUniversalSizeAmp(
       vstorage->num_levels() - 1,
       mutable_cf_options.MaxFileSizeForLevel(vstorage->num_levels() - 1),
       /* max_grandparent_overlap_bytes */ LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, vstorage->num_levels() - 1, 1),
+      UniversalOutputCompression(ioptions_, vstorage->num_levels() - 1, estimated_total_size),
       /* grandparents */ {}, /* is manual */ false, score,
       false /* deletion_compaction */,
       CompactionReason::kUniversalSizeAmplification);
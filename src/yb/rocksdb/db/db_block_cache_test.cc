@@ -250,6 +250,53 @@ TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
 }
 #endif
 
+TEST_F(DBBlockCacheTest, TestReadahead) {
+  constexpr int kNumKeys = 200;
+  auto options = GetOptions(GetTableOptions());
+  Reopen(options);
+  std::string value(kValueSize, 'a');
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), value));
+  }
+  ASSERT_OK(Flush());
+
+  ReadaheadStats stats;
+  ReadOptions read_options;
+  read_options.max_readahead_size = 16 * 1024;
+  read_options.readahead_stats = &stats;
+
+  // Sequential scan reads ahead, and the blocks are then found in the data read ahead.
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(Key(count), iter->key().ToString());
+      ++count;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumKeys, count);
+  }
+  LOG(INFO) << "Sequential scan: " << stats.ToString();
+  ASSERT_EQ(kNumKeys - 1, static_cast<int>(stats.sequential_blocks));
+  ASSERT_GT(stats.readaheads, 1U);
+  ASSERT_GT(stats.readahead_hits, stats.sequential_blocks / 2);
+  ASSERT_LE(stats.readahead_bytes / stats.readaheads, read_options.max_readahead_size);
+
+  // Seeks to distant keys are not sequential, so nothing is read ahead.
+  stats = ReadaheadStats();
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    for (int i = 0; i < kNumKeys; i += 10) {
+      iter->Seek(Key(i));
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(Key(i), iter->key().ToString());
+    }
+  }
+  LOG(INFO) << "Seeks: " << stats.ToString();
+  ASSERT_EQ(0U, stats.sequential_blocks);
+  ASSERT_EQ(0U, stats.readaheads);
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -490,6 +490,10 @@ class RandomAccessFile : public File {
 
   virtual void Hint(AccessPattern pattern) {}
 
+  // Start reading the given range of the file into the OS cache without waiting for it, so
+  // that a later Read() of the range does not have to wait for the disk. Noop by default.
+  virtual void Readahead(uint64_t offset, size_t n) {}
+
   // Remove any kind of caching of data from the offset to offset+length
   // of this file. If the length is 0, then it refers to the end of file.
   // If the system is not caching the file contents, then this is a noop.
@@ -1375,6 +1375,20 @@ class TableAwareReadFileFilter {
   virtual ~TableAwareReadFileFilter() {}
 };
 
+// Statistics of the data read ahead by the iterators created with the same ReadOptions.
+struct ReadaheadStats {
+  // Number of read-ahead requests issued and the number of bytes requested by them.
+  uint64_t readaheads = 0;
+  uint64_t readahead_bytes = 0;
+
+  // Number of data blocks that were read sequentially, and the number of them that were already
+  // covered by a read-ahead.
+  uint64_t sequential_blocks = 0;
+  uint64_t readahead_hits = 0;
+
+  std::string ToString() const;
+};
+
 // Options that control read operations
 struct ReadOptions {
   // If true, all data read from underlying storage will be
@@ -1474,6 +1488,18 @@ struct ReadOptions {
   // Query id designated for the read.
   QueryId query_id = kDefaultQueryId;
 
+  // Maximum number of bytes read ahead by an iterator that reads the data blocks of an SST file
+  // sequentially. Once sequential access is detected, the data following the current block is
+  // read ahead asynchronously into the OS cache. The read-ahead size starts from a few blocks and
+  // doubles each time the sequential reads consume the data read ahead, up to this limit. It is
+  // reset when the iterator jumps to another position.
+  // Default: 0 (no read-ahead)
+  size_t max_readahead_size = 0;
+
+  // If set, the read-ahead statistics of the iterators are accumulated here. Should outlive the
+  // iterators.
+  ReadaheadStats* readahead_stats = nullptr;
+
   // Filter for pruning SST files. RocksDB user can provide its own implementation to exclude SST
   // files from being added to MergeIterator. By default doesn't filter files.
   std::shared_ptr<TableAwareReadFileFilter> table_aware_file_filter;
@@ -1551,6 +1577,10 @@ extern Status CreateLoggerFromOptions(const std::string& dbname,
                                       const DBOptions& options,
                                       std::shared_ptr<Logger>* logger);
 
+// Returns whether the given compression type is supported by this build of RocksDB. Column
+// families configured with an unsupported compression type fail to open.
+extern bool IsCompressionTypeSupported(CompressionType compression_type);
+
 // CompactionOptions are used in CompactFiles() call.
 struct CompactionOptions {
   // Compaction output compression type
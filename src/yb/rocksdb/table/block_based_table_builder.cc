@@ -480,8 +480,11 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   size_t data_block_size = 0;
 
   if (!r->data_block_builder.empty()) {
-    data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
+    const Slice raw_block_contents = r->data_block_builder.Finish();
+    r->props.uncompressed_data_size += raw_block_contents.size() + kBlockTrailerSize;
+    data_block_size = WriteBlock(raw_block_contents, &r->data_pending_handle,
         r->data_writer.get());
+    r->data_block_builder.Reset();
   }
   if (!ok()) return;
 
@@ -761,6 +764,7 @@ Status BlockBasedTableBuilder::Finish() {
       PropertyBlockBuilder property_block_builder;
       r->props.filter_policy_name = r->table_options.filter_policy != nullptr ?
           r->table_options.filter_policy->Name() : "";
+      r->props.compression_name = CompressionTypeToString(r->compression_type);
       r->props.data_index_size =
           r->data_index_builder->EstimatedSize() + kBlockTrailerSize;
 
@@ -30,13 +30,14 @@ constexpr char kFixedSizeFilterBlockPrefix[] = "fixedsizefilter.";
 // The only relevant option is options.verify_checksums for now.
 // On failure return non-OK.
 // On success fill *result and return OK - caller owns *result
+// If statistics is not null, the decompression of the block is recorded in it.
 inline CHECKED_STATUS ReadBlockFromFile(
     RandomAccessFileReader* file, const Footer& footer, const ReadOptions& options,
     const BlockHandle& handle, std::unique_ptr<Block>* result, Env* env,
-    bool do_uncompress = true) {
+    bool do_uncompress = true, Statistics* statistics = nullptr) {
   BlockContents contents;
   Status s = ReadBlockContents(file, footer, options, handle, &contents, env,
-                               do_uncompress);
+                               do_uncompress, statistics);
   if (s.ok()) {
     result->reset(new Block(std::move(contents)));
   }
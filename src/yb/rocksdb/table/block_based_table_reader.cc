@@ -23,6 +23,8 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <utility>
 #include <cinttypes>
@@ -231,9 +233,10 @@ struct BlockBasedTable::Rep {
   DataIndexLoadMode data_index_load_mode;
 };
 
-// BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
-// to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
-// functions in order to check if prefix may match or to create a secondary iterator.
+// BlockEntryIteratorState is used as an adapter to BlockBasedTable. It is used by TwoLevelIterator
+// and MultiLevelIterator to call BlockBasedTable functions in order to check if prefix may match or
+// to create a secondary iterator. The only iterator state it stores is the read-ahead state of a
+// data blocks iterator, see MaybeReadahead().
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -246,6 +249,9 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         block_type_(block_type) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
+    if (block_type_ == BlockType::kData && read_options_.max_readahead_size > 0) {
+      MaybeReadahead(index_value);
+    }
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
   }
 
@@ -257,6 +263,56 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   }
 
  private:
+  // Number of sequentially read blocks after which read-ahead is started.
+  static constexpr int kMinSequentialBlocks = 2;
+  // Initial read-ahead size, in blocks.
+  static constexpr int kInitialReadaheadBlocks = 4;
+
+  // Detects sequential reads of data blocks and reads the following data ahead. The read-ahead
+  // window is extended when less than half of it is left unread, doubling its size each time, so
+  // the read-ahead grows only while the iterator keeps consuming the data read ahead.
+  void MaybeReadahead(const Slice& index_value) {
+    BlockHandle handle;
+    Slice input = index_value;
+    if (!handle.DecodeFrom(&input).ok()) {
+      // NewDataBlockIterator() reports the error.
+      return;
+    }
+    ReadaheadStats* stats = read_options_.readahead_stats;
+    const uint64_t block_end = handle.offset() + handle.size() + kBlockTrailerSize;
+    if (handle.offset() == next_block_offset_) {
+      ++num_sequential_blocks_;
+      if (stats) {
+        ++stats->sequential_blocks;
+        if (block_end <= readahead_limit_) {
+          ++stats->readahead_hits;
+        }
+      }
+    } else {
+      // The iterator jumped to another position, the rest of the data read ahead is not needed.
+      num_sequential_blocks_ = 0;
+      readahead_size_ = 0;
+      readahead_limit_ = 0;
+    }
+    next_block_offset_ = block_end;
+
+    if (num_sequential_blocks_ < kMinSequentialBlocks ||
+        readahead_limit_ >= block_end + readahead_size_ / 2) {
+      return;
+    }
+    const size_t max_size = read_options_.max_readahead_size;
+    readahead_size_ = readahead_size_ == 0
+        ? std::min<size_t>(kInitialReadaheadBlocks * (block_end - handle.offset()), max_size)
+        : std::min(readahead_size_ * 2, max_size);
+    const uint64_t readahead_offset = std::max(readahead_limit_, block_end);
+    table_->GetBlockReader(block_type_)->reader->Readahead(readahead_offset, readahead_size_);
+    readahead_limit_ = readahead_offset + readahead_size_;
+    if (stats) {
+      ++stats->readaheads;
+      stats->readahead_bytes += readahead_size_;
+    }
+  }
+
   // Don't own table_. BlockEntryIteratorState should only be stored in iterators or in
   // corresponding BlockBasedTable. TableReader (superclass of BlockBasedTable) is only destroyed
   // after iterator is deleted.
@@ -264,6 +320,12 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
+
+  // Read-ahead state, only used for data blocks.
+  uint64_t next_block_offset_ = std::numeric_limits<uint64_t>::max();
+  int num_sequential_blocks_ = 0;
+  size_t readahead_size_ = 0;
+  uint64_t readahead_limit_ = 0;
 };
 
 
@@ -1138,7 +1200,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            block_cache_compressed == nullptr);
+            block_cache_compressed == nullptr, statistics);
       }
 
       if (s.ok()) {
@@ -1162,7 +1224,8 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     }
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
-        reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env);
+        reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
+        true /* do_uncompress */, rep_->ioptions.statistics);
     if (s.ok()) {
       block.value = block_value.release();
     }
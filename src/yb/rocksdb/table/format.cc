@@ -34,6 +34,8 @@
 #include "yb/rocksdb/util/crc32c.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
+#include "yb/rocksdb/util/statistics.h"
+#include "yb/rocksdb/util/stop_watch.h"
 #include "yb/util/string_util.h"
 #include "yb/rocksdb/util/xxhash.h"
 #include "yb/util/format.h"
@@ -324,7 +326,8 @@ Status ReadBlock(RandomAccessFileReader* file, const Footer& footer,
 Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
                          const ReadOptions& options, const BlockHandle& handle,
                          BlockContents* contents, Env* env,
-                         bool decompression_requested) {
+                         bool decompression_requested,
+                         Statistics* statistics) {
   Status status;
   Slice slice;
   size_t n = static_cast<size_t>(handle.size());
@@ -354,7 +357,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   compression_type = static_cast<rocksdb::CompressionType>(slice.data()[n]);
 
   if (decompression_requested && compression_type != kNoCompression) {
-    return UncompressBlockContents(slice.cdata(), n, contents, footer.version());
+    return UncompressBlockContents(slice.cdata(), n, contents, footer.version(), env,
+                                   statistics);
   }
 
   if (slice.cdata() != used_buf) {
@@ -464,4 +468,20 @@ Status UncompressBlockContents(const char* data, size_t n,
   return Status::OK();
 }
 
+Status UncompressBlockContents(const char* data, size_t n,
+                               BlockContents* contents,
+                               uint32_t format_version,
+                               Env* env, Statistics* statistics) {
+  if (statistics == nullptr || env == nullptr) {
+    return UncompressBlockContents(data, n, contents, format_version);
+  }
+  StopWatchNano timer(env, true /* auto_start */);
+  Status s = UncompressBlockContents(data, n, contents, format_version);
+  if (s.ok()) {
+    MeasureTime(statistics, DECOMPRESSION_TIMES_NANOS, timer.ElapsedNanos());
+    RecordTick(statistics, NUMBER_BLOCK_DECOMPRESSED);
+  }
+  return s;
+}
+
 }  // namespace rocksdb
@@ -95,6 +95,14 @@ std::string TableProperties::ToString(
       filter_policy_name.empty() ? std::string("N/A") : filter_policy_name,
       prop_delim, kv_delim);
 
+  AppendProperty(
+      &result, "compression",
+      compression_name.empty() ? std::string("N/A") : compression_name,
+      prop_delim, kv_delim);
+  AppendProperty(&result, "data blocks uncompressed size", uncompressed_data_size, prop_delim,
+                 kv_delim);
+  AppendProperty(&result, "compression ratio", CompressionRatio(), prop_delim, kv_delim);
+
   return result;
 }
 
@@ -109,6 +117,7 @@ void TableProperties::Add(const TableProperties& tp) {
   num_filter_blocks += tp.num_filter_blocks;
   num_data_index_blocks += tp.num_data_index_blocks;
   num_entries += tp.num_entries;
+  uncompressed_data_size += tp.uncompressed_data_size;
 }
 
 const std::string TablePropertiesNames::kDataSize  =
@@ -137,6 +146,10 @@ const std::string TablePropertiesNames::kFormatVersion =
     "rocksdb.format.version";
 const std::string TablePropertiesNames::kFixedKeyLen =
     "rocksdb.fixed.key.length";
+const std::string TablePropertiesNames::kUncompressedDataSize =
+    "rocksdb.uncompressed.data.size";
+const std::string TablePropertiesNames::kCompression =
+    "rocksdb.compression";
 
 extern const std::string kPropertiesBlock = "rocksdb.properties";
 // Old property block name for backward compatibility
@@ -1050,6 +1050,52 @@ TEST_F(BlockBasedTableTest, BasicBlockBasedTableProperties) {
   }
   Slice content = block_builder.Finish();
   ASSERT_EQ(content.size() + kBlockTrailerSize, props.data_size);
+  ASSERT_EQ(props.data_size, props.uncompressed_data_size);
+  ASSERT_EQ("NoCompression", props.compression_name);
+}
+
+TEST_F(BlockBasedTableTest, CompressionProperties) {
+  if (!Snappy_Supported()) {
+    LOG(INFO) << "Skipping test, snappy is not supported";
+    return;
+  }
+  TableConstructor c(BytewiseComparator());
+  for (int i = 0; i < 1000; ++i) {
+    c.Add("key" + std::to_string(100000 + i), std::string(100, 'a' + i % 26));
+  }
+
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  Options options;
+  options.compression = kSnappyCompression;
+  options.statistics = CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.no_block_cache = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+  auto& props = *c.GetTableReader()->GetTableProperties();
+  ASSERT_EQ("Snappy", props.compression_name);
+  ASSERT_GT(props.num_data_blocks, 1U);
+  ASSERT_GT(props.uncompressed_data_size, props.data_size);
+  ASSERT_GT(props.CompressionRatio(), 2.0);
+
+  // Every data block read is decompressed, since there is no block cache.
+  std::unique_ptr<InternalIterator> iter(c.NewIterator());
+  size_t num_entries = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ++num_entries;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(kvmap.size(), num_entries);
+  ASSERT_GE(options.statistics->getTickerCount(NUMBER_BLOCK_DECOMPRESSED),
+            props.num_data_blocks);
+  HistogramData decompression_times;
+  options.statistics->histogramData(DECOMPRESSION_TIMES_NANOS, &decompression_times);
+  ASSERT_GT(decompression_times.count, 0);
 }
 
 TEST_F(BlockBasedTableTest, FilterPolicyNameProperties) {
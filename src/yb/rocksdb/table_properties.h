@@ -74,11 +74,22 @@ struct TableProperties {
   uint64_t format_version = 0;
   // If 0, key is variable length. Otherwise number of bytes for each key.
   uint64_t fixed_key_len = 0;
+  // the total size of all data blocks before compression, 0 if unknown.
+  uint64_t uncompressed_data_size = 0;
 
   // The name of the filter policy used in this table.
   // If no filter policy is used, `filter_policy_name` will be an empty string.
   std::string filter_policy_name;
 
+  // The name of the compression of the data blocks of this table, empty if unknown.
+  std::string compression_name;
+
+  // Ratio of the uncompressed to the compressed size of the data blocks, 0 if unknown.
+  double CompressionRatio() const {
+    return uncompressed_data_size != 0 && data_size != 0
+        ? static_cast<double>(uncompressed_data_size) / data_size : 0;
+  }
+
   // user collected properties
   UserCollectedProperties user_collected_properties;
   UserCollectedProperties readable_properties;
@@ -108,6 +119,8 @@ struct TablePropertiesNames {
   static const std::string kFormatVersion;
   static const std::string kFixedKeyLen;
   static const std::string kFilterPolicy;
+  static const std::string kUncompressedDataSize;
+  static const std::string kCompression;
 };
 
 extern const std::string kPropertiesBlock;
@@ -27,6 +27,9 @@
 
 namespace rocksdb {
 
+// Defined in options.h.
+enum CompressionType : char;
+
 //
 // Algorithm used to make a compaction request stop picking new files
 // into a single compaction run
@@ -80,6 +83,19 @@ class CompactionOptionsUniversal {
   // Default: -1
   int compression_size_percent;
 
+  // If positive, the output of compactions with an estimated output size of at
+  // least this many bytes is compressed with large_output_compression instead
+  // of the column family compression. This allows to trade more CPU for a
+  // better ratio on the large files, that are rewritten rarely.
+  // Does not apply to compactions that are not compressed because of
+  // compression_size_percent.
+  // Default: 0
+  uint64_t large_output_size_bytes;
+
+  // Compression of the large compaction outputs, see large_output_size_bytes.
+  // Default: kNoCompression
+  CompressionType large_output_compression;
+
   // The algorithm used to stop picking files into a single compaction run
   // Default: kCompactionStopStyleTotalSize
   CompactionStopStyle stop_style;
@@ -96,6 +112,8 @@ class CompactionOptionsUniversal {
         max_merge_width(UINT_MAX),
         max_size_amplification_percent(200),
         compression_size_percent(-1),
+        large_output_size_bytes(0),
+        large_output_compression(static_cast<CompressionType>(0)),
         stop_style(kCompactionStopStyleTotalSize),
         allow_trivial_move(false) {}
 };
@@ -26,6 +26,9 @@
 #include <stdlib.h>
 #include <gflags/gflags.h>
 
+#include <algorithm>
+#include <thread>
+
 #include "yb/util/metrics.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/statistics.h"
@@ -925,6 +928,17 @@ class ShardedLRUCache : public Cache {
 
 }  // end anonymous namespace
 
+int GetDefaultCacheShardBits() {
+  static constexpr int kMinShardBits = 4;
+  static constexpr int kMaxShardBits = 10;
+  const int num_shards = 2 * std::max(std::thread::hardware_concurrency(), 1u);
+  int num_shard_bits = kMinShardBits;
+  while (num_shard_bits < kMaxShardBits && (1 << num_shard_bits) < num_shards) {
+    ++num_shard_bits;
+  }
+  return num_shard_bits;
+}
+
 shared_ptr<Cache> NewLRUCache(size_t capacity) {
   return NewLRUCache(capacity, kNumShardBits, false);
 }
@@ -935,6 +949,9 @@ shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits) {
 
 shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                               bool strict_capacity_limit) {
+  if (num_shard_bits < 0) {
+    num_shard_bits = GetDefaultCacheShardBits();
+  }
   if (num_shard_bits >= 20) {
     return nullptr;  // the cache cannot be sharded into too many fine pieces
   }
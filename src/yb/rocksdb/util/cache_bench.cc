@@ -34,6 +34,10 @@ int main() {
 #include <stdio.h>
 #include <gflags/gflags.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/env.h"
@@ -48,7 +52,11 @@ static const uint32_t KB = 1024;
 DEFINE_int32(threads, 16, "Number of concurrent threads to run.");
 DEFINE_int64(cache_size, 8 * KB * KB,
              "Number of bytes to use as a cache of uncompressed data.");
-DEFINE_int32(num_shard_bits, 4, "shard_bits.");
+DEFINE_int32(num_shard_bits, -1, "shard_bits. -1 picks the default number of shard bits "
+             "for the number of cores of this machine.");
+DEFINE_string(cache_type, "all",
+              "Cache implementation to benchmark: lru, clock, or all to run the same workload "
+              "against each of them.");
 
 DEFINE_int64(max_key, 1 * KB * KB * KB, "Max number of key to place in cache");
 DEFINE_uint64(ops_per_thread, 1200000, "Number of operations per thread.");
@@ -60,6 +68,9 @@ DEFINE_int32(lookup_percent, 50,
              "Ratio of lookup to total workload (expressed as a percentage)");
 DEFINE_int32(erase_percent, 10,
              "Ratio of erase to total workload (expressed as a percentage)");
+DEFINE_int32(num_queries, 16,
+             "Number of distinct query ids used by the threads. Entries accessed by more than "
+             "one query are treated as multi touch.");
 
 namespace rocksdb {
 
@@ -136,6 +147,8 @@ struct ThreadState {
   uint32_t tid;
   Random rnd;
   SharedState* shared;
+  uint64_t lookups = 0;
+  uint64_t hits = 0;
 
   ThreadState(uint32_t index, SharedState* _shared)
       : tid(index), rnd(1000 + index), shared(_shared) {}
@@ -144,8 +157,9 @@ struct ThreadState {
 
 class CacheBench {
  public:
-  CacheBench() :
-      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
+  CacheBench(std::string cache_type, std::shared_ptr<Cache> cache) :
+      cache_type_(std::move(cache_type)),
+      cache_(std::move(cache)),
       num_threads_(FLAGS_threads) {}
 
   ~CacheBench() {}
@@ -157,7 +171,7 @@ class CacheBench {
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       // do insert
-      cache_->Insert(key, new char[10], 1, &deleter);
+      cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter);
     }
   }
 
@@ -193,12 +207,24 @@ class CacheBench {
       double elapsed = static_cast<double>(end_time - start_time) * 1e-6;
       uint32_t qps = static_cast<uint32_t>(
           static_cast<double>(FLAGS_threads * FLAGS_ops_per_thread) / elapsed);
-      fprintf(stdout, "Complete in %.3f s; QPS = %u\n", elapsed, qps);
+      uint64_t lookups = 0;
+      uint64_t hits = 0;
+      for (auto thread : threads) {
+        lookups += thread->lookups;
+        hits += thread->hits;
+      }
+      fprintf(stdout, "%s cache: complete in %.3f s; QPS = %u; hit ratio = %.3f\n",
+              cache_type_.c_str(), elapsed, qps,
+              lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups);
+    }
+    for (auto thread : threads) {
+      delete thread;
     }
     return true;
   }
 
  private:
+  const std::string cache_type_;
   std::shared_ptr<Cache> cache_;
   uint32_t num_threads_;
 
@@ -232,19 +258,20 @@ class CacheBench {
       uint64_t rand_key = thread->rnd.Next() % FLAGS_max_key;
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
+      const QueryId query_id = thread->rnd.Uniform(std::max(FLAGS_num_queries, 1));
       int32_t prob_op = thread->rnd.Uniform(100);
-      if (prob_op >= 0 && prob_op < FLAGS_insert_percent) {
+      if (prob_op < FLAGS_insert_percent) {
         // do insert
-        cache_->Insert(key, new char[10], 1, &deleter);
-      } else if (prob_op -= FLAGS_insert_percent &&
-                 prob_op < FLAGS_lookup_percent) {
+        cache_->Insert(key, query_id, new char[10], 1, &deleter);
+      } else if ((prob_op -= FLAGS_insert_percent) < FLAGS_lookup_percent) {
         // do lookup
-        auto handle = cache_->Lookup(key);
+        ++thread->lookups;
+        auto handle = cache_->Lookup(key, query_id);
         if (handle) {
+          ++thread->hits;
           cache_->Release(handle);
         }
-      } else if (prob_op -= FLAGS_lookup_percent &&
-                 prob_op < FLAGS_erase_percent) {
+      } else if ((prob_op -= FLAGS_lookup_percent) < FLAGS_erase_percent) {
         // do erase
         cache_->Erase(key);
       }
@@ -252,10 +279,12 @@ class CacheBench {
   }
 
   void PrintEnv() const {
+    printf("Cache type          : %s\n", cache_type_.c_str());
     printf("Number of threads   : %d\n", FLAGS_threads);
     printf("Ops per thread      : %" PRIu64 "\n", FLAGS_ops_per_thread);
     printf("Cache size          : %" PRIu64 "\n", FLAGS_cache_size);
-    printf("Num shard bits      : %d\n", FLAGS_num_shard_bits);
+    printf("Num shard bits      : %d\n", FLAGS_num_shard_bits < 0
+        ? GetDefaultCacheShardBits() : FLAGS_num_shard_bits);
     printf("Max key             : %" PRIu64 "\n", FLAGS_max_key);
     printf("Populate cache      : %d\n", FLAGS_populate_cache);
     printf("Insert percentage   : %d%%\n", FLAGS_insert_percent);
@@ -274,15 +303,29 @@ int main(int argc, char** argv) {
     exit(1);
   }
 
-  rocksdb::CacheBench bench;
-  if (FLAGS_populate_cache) {
-    bench.PopulateCache();
-  }
-  if (bench.Run()) {
-    return 0;
+  std::vector<std::string> cache_types;
+  if (FLAGS_cache_type == "all") {
+    cache_types = {"lru", "clock"};
+  } else if (FLAGS_cache_type == "lru" || FLAGS_cache_type == "clock") {
+    cache_types = {FLAGS_cache_type};
   } else {
-    return 1;
+    fprintf(stderr, "unknown cache type %s\n", FLAGS_cache_type.c_str());
+    exit(1);
+  }
+
+  for (const auto& cache_type : cache_types) {
+    auto cache = cache_type == "clock"
+        ? rocksdb::NewClockCache(FLAGS_cache_size, FLAGS_num_shard_bits)
+        : rocksdb::NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits);
+    rocksdb::CacheBench bench(cache_type, std::move(cache));
+    if (FLAGS_populate_cache) {
+      bench.PopulateCache();
+    }
+    if (!bench.Run()) {
+      return 1;
+    }
   }
+  return 0;
 }
 
 #endif  // GFLAGS
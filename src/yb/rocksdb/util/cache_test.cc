@@ -27,8 +27,10 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <thread>
 #include <gflags/gflags.h>
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/random.h"
 #include "yb/util/string_util.h"
 #include "yb/rocksdb/util/testharness.h"
 
@@ -675,6 +677,119 @@ TEST_F(CacheTest, ApplyToAllCacheEntiresTest) {
   ASSERT_TRUE(inserted == callback_state);
 }
 
+TEST_F(CacheTest, ClockCacheHitMissAndErase) {
+  cache_ = NewClockCache(kCacheSize, kNumShardBits);
+  ASSERT_EQ(-1, Lookup(100));
+
+  ASSERT_OK(Insert(100, 101));
+  ASSERT_OK(Insert(200, 201));
+  ASSERT_EQ(101, Lookup(100));
+  ASSERT_EQ(201, Lookup(200));
+
+  ASSERT_OK(Insert(100, 102));
+  ASSERT_EQ(102, Lookup(100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(101, deleted_values_[0]);
+
+  Erase(100);
+  ASSERT_EQ(-1, Lookup(100));
+  ASSERT_EQ(201, Lookup(200));
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(102, deleted_values_[1]);
+  ASSERT_EQ(1U, cache_->GetUsage());
+}
+
+TEST_F(CacheTest, ClockCacheEntriesArePinned) {
+  cache_ = NewClockCache(kCacheSize, kNumShardBits);
+  ASSERT_OK(Insert(100, 101));
+  Cache::Handle* h1 = cache_->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(101, DecodeValue(cache_->Value(h1)));
+  ASSERT_EQ(1U, cache_->GetPinnedUsage());
+
+  ASSERT_OK(Insert(100, 102));
+  ASSERT_EQ(0U, deleted_keys_.size());
+  ASSERT_EQ(2U, cache_->GetUsage());
+
+  // The replaced entry is freed with its last reference.
+  cache_->Release(h1);
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(101, deleted_values_[0]);
+  ASSERT_EQ(1U, cache_->GetUsage());
+  ASSERT_EQ(0U, cache_->GetPinnedUsage());
+}
+
+TEST_F(CacheTest, ClockCacheSecondChance) {
+  const int kCapacity = 10;
+  cache_ = NewClockCache(kCapacity, 0);
+  for (int i = 0; i < kCapacity; i++) {
+    ASSERT_OK(Insert(i, i));
+  }
+  // Entry 0 is accessed by another query, which gives it a second chance, while entry 1 is only
+  // accessed by the query that inserted it.
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(0, 0, kTestQueryId + 1));
+  ASSERT_EQ(1, Lookup(1));
+
+  ASSERT_OK(Insert(kCapacity, kCapacity));
+  ASSERT_EQ(0, Lookup(0));
+  ASSERT_EQ(-1, Lookup(1));
+  ASSERT_EQ(kCapacity, cache_->GetUsage());
+}
+
+TEST_F(CacheTest, ClockCacheStrictCapacityLimit) {
+  cache_ = NewClockCache(5, 0, true /* strict_capacity_limit */);
+  std::vector<Cache::Handle*> handles(5);
+  for (int i = 0; i < 5; i++) {
+    ASSERT_OK(cache_->Insert(EncodeKey(i), kTestQueryId, EncodeValue(i), 1, &CacheTest::Deleter,
+                             &handles[i]));
+  }
+  // All entries are pinned, so nothing can be evicted.
+  Cache::Handle* handle;
+  ASSERT_TRUE(cache_->Insert(EncodeKey(5), kTestQueryId, EncodeValue(5), 1, &CacheTest::Deleter,
+                             &handle).IsIncomplete());
+  ASSERT_EQ(nullptr, handle);
+  ASSERT_TRUE(Insert(5, 5).IsIncomplete());
+  ASSERT_EQ(5U, cache_->GetUsage());
+
+  for (auto h : handles) {
+    cache_->Release(h);
+  }
+  ASSERT_OK(Insert(5, 5));
+  ASSERT_EQ(5U, cache_->GetUsage());
+  ASSERT_EQ(5, Lookup(5));
+}
+
+TEST_F(CacheTest, ClockCacheConcurrentAccess) {
+  const int kNumThreads = 8;
+  const int kNumKeys = 2 * kCacheSize;
+  const int kOpsPerThread = 20000;
+  auto cache = NewClockCache(kCacheSize, kNumShardBits);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([cache, t] {
+      Random rnd(t + 1);
+      for (int i = 0; i < kOpsPerThread; i++) {
+        const int key = rnd.Uniform(kNumKeys);
+        Cache::Handle* handle = cache->Lookup(EncodeKey(key), t);
+        if (handle != nullptr) {
+          ASSERT_EQ(key, DecodeValue(cache->Value(handle)));
+          cache->Release(handle);
+        } else if (rnd.OneIn(10)) {
+          cache->Erase(EncodeKey(key));
+        } else {
+          cache->Insert(EncodeKey(key), t, EncodeValue(key), 1, dumbDeleter);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // Eviction is lazy, so each shard may stay above its capacity by the entries that were pinned by
+  // other threads during its last insert.
+  ASSERT_LE(cache->GetUsage(), kCacheSize + (1 << kNumShardBits) * kNumThreads);
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -0,0 +1,711 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string.h>
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/util/autovector.h"
+#include "yb/rocksdb/util/hash.h"
+#include "yb/rocksdb/util/statistics.h"
+
+#include "yb/util/cache_metrics.h"
+#include "yb/util/locks.h"
+#include "yb/util/metrics.h"
+
+namespace rocksdb {
+
+namespace {
+
+// CLOCK (second chance) cache implementation.
+//
+// Each shard keeps its entries in a hash table, for lookups, and in a circular list walked by the
+// clock hand, for eviction. Unlike the LRU cache, a hit does not move the entry in any list: it
+// takes the shard lock in shared mode and updates the atomic flags of the entry, so concurrent
+// hits on the same shard do not serialize. Releasing a handle does not take the shard lock at all.
+//
+// Eviction is lazy and only happens when an entry is inserted (or the capacity is reduced). The
+// clock hand skips entries that are referenced externally, clears the usage bit of entries that
+// have it set, and evicts the first unreferenced entry whose usage bit is clear.
+//
+// Scan resistance mirrors the single/multi touch split of the LRU cache: the usage bit is only set
+// when an entry is accessed by a query other than the one that inserted it, so blocks read once by
+// a scan are evicted on the first pass of the hand, while blocks shared between queries get a
+// second chance. The capacity is not split between single touch and multi touch entries.
+
+// Flags of an entry, packed in one atomic word. The external reference count is kept in the bits
+// above kRefsShift.
+constexpr uint32_t kInCacheBit = 1;     // The entry is referenced by the hash table.
+constexpr uint32_t kUsageBit = 2;       // The entry was used since the clock hand last passed it.
+constexpr uint32_t kMultiTouchBit = 4;  // The entry was accessed by more than one query.
+constexpr uint32_t kRefsShift = 3;
+constexpr uint32_t kOneRef = 1 << kRefsShift;
+
+inline uint32_t Refs(uint32_t flags) {
+  return flags >> kRefsShift;
+}
+
+struct ClockHandle {
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  ClockHandle* next_hash;
+  // Neighbours in the circular list walked by the clock hand.
+  ClockHandle* next;
+  ClockHandle* prev;
+  size_t charge;
+  size_t key_length;
+  uint32_t hash;
+  QueryId query_id;  // Query id that added the value to the cache.
+  std::atomic<uint32_t> flags;
+  char key_data[1];  // Beginning of key
+
+  Slice key() const {
+    return Slice(key_data, key_length);
+  }
+
+  SubCacheType GetSubCacheType() const {
+    return (flags.load(std::memory_order_relaxed) & kMultiTouchBit) ? MULTI_TOUCH : SINGLE_TOUCH;
+  }
+
+  static ClockHandle* Allocate(const Slice& key) {
+    char* memory = new char[sizeof(ClockHandle) - 1 + key.size()];
+    ClockHandle* result = new (memory) ClockHandle;
+    result->key_length = key.size();
+    memcpy(result->key_data, key.data(), key.size());
+    return result;
+  }
+
+  void Destroy() {
+    this->~ClockHandle();
+    delete[] reinterpret_cast<char*>(this);
+  }
+};
+
+// Hash table of the entries of a shard. It is only modified while the shard lock is held
+// exclusively, so lookups under the shared lock see a consistent table.
+class ClockHandleTable {
+ public:
+  ClockHandleTable() { Resize(); }
+
+  ~ClockHandleTable() {
+    delete[] list_;
+  }
+
+  ClockHandle* Lookup(const Slice& key, uint32_t hash) const {
+    return *FindPointer(key, hash);
+  }
+
+  ClockHandle* Insert(ClockHandle* h) {
+    ClockHandle** ptr = FindPointer(h->key(), h->hash);
+    ClockHandle* old = *ptr;
+    h->next_hash = (old == nullptr ? nullptr : old->next_hash);
+    *ptr = h;
+    if (old == nullptr) {
+      ++elems_;
+      if (elems_ > length_) {
+        Resize();
+      }
+    }
+    return old;
+  }
+
+  ClockHandle* Remove(const Slice& key, uint32_t hash) {
+    ClockHandle** ptr = FindPointer(key, hash);
+    ClockHandle* result = *ptr;
+    if (result != nullptr) {
+      *ptr = result->next_hash;
+      --elems_;
+    }
+    return result;
+  }
+
+ private:
+  ClockHandle** FindPointer(const Slice& key, uint32_t hash) const {
+    ClockHandle** ptr = &list_[hash & (length_ - 1)];
+    while (*ptr != nullptr && ((*ptr)->hash != hash || key != (*ptr)->key())) {
+      ptr = &(*ptr)->next_hash;
+    }
+    return ptr;
+  }
+
+  void Resize() {
+    uint32_t new_length = 16;
+    while (new_length < elems_ * 1.5) {
+      new_length *= 2;
+    }
+    ClockHandle** new_list = new ClockHandle*[new_length];
+    memset(new_list, 0, sizeof(new_list[0]) * new_length);
+    for (uint32_t i = 0; i < length_; i++) {
+      ClockHandle* h = list_[i];
+      while (h != nullptr) {
+        ClockHandle* next = h->next_hash;
+        ClockHandle** ptr = &new_list[h->hash & (new_length - 1)];
+        h->next_hash = *ptr;
+        *ptr = h;
+        h = next;
+      }
+    }
+    delete[] list_;
+    list_ = new_list;
+    length_ = new_length;
+  }
+
+  uint32_t length_ = 0;
+  uint32_t elems_ = 0;
+  ClockHandle** list_ = nullptr;
+};
+
+// A single shard of sharded clock cache.
+class ClockCacheShard {
+ public:
+  ClockCacheShard() {}
+  ~ClockCacheShard();
+
+  void SetCapacity(size_t capacity);
+  void SetStrictCapacityLimit(bool strict_capacity_limit);
+
+  void SetMetrics(shared_ptr<yb::CacheMetrics> metrics) {
+    metrics_ = metrics;
+  }
+
+  // Like Cache methods, but with an extra "hash" parameter.
+  Status Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
+                Cache::Handle** handle, Statistics* statistics);
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                        Statistics* statistics);
+  void Release(Cache::Handle* handle);
+  void Erase(const Slice& key, uint32_t hash);
+
+  size_t GetUsage() const {
+    return usage_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetPinnedUsage() const {
+    return pinned_usage_.load(std::memory_order_relaxed);
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe);
+
+ private:
+  // Moves the clock hand, evicting unreferenced entries, until charge more bytes fit in the
+  // capacity or every entry has been visited twice. Requires mutex_ to be held exclusively.
+  void Evict(size_t charge, autovector<ClockHandle*>* deleted);
+
+  // Adds the entry to the circular list, just behind the clock hand.
+  void ClockAppend(ClockHandle* e);
+  void ClockRemove(ClockHandle* e);
+
+  // Removes the entry, already removed from the hash table, from the circular list and clears its
+  // in cache bit. Returns true if there are no external references to the entry, so the caller
+  // must free it.
+  bool RemoveFromCache(ClockHandle* e);
+
+  // Calls the deleter and frees the entry.
+  void Free(ClockHandle* e);
+
+  void RecordHit(ClockHandle* e, Statistics* statistics);
+
+  // mutex_ is held in shared mode by lookups and exclusively by operations that change the hash
+  // table or the circular list.
+  mutable yb::rw_spinlock mutex_;
+
+  ClockHandleTable table_;
+
+  // Next entry to be visited by the clock hand, or nullptr if the shard is empty.
+  ClockHandle* hand_ = nullptr;
+  size_t num_entries_ = 0;
+
+  size_t capacity_ = 0;
+  bool strict_capacity_limit_ = false;
+
+  // Memory size of the entries that have not been freed yet, including entries that were removed
+  // from the cache but are still referenced externally.
+  std::atomic<size_t> usage_{0};
+
+  // Memory size of the entries referenced externally.
+  std::atomic<size_t> pinned_usage_{0};
+
+  shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+ClockCacheShard::~ClockCacheShard() {
+  while (hand_ != nullptr) {
+    ClockHandle* e = hand_;
+    ClockRemove(e);
+    table_.Remove(e->key(), e->hash);
+    const uint32_t flags = e->flags.fetch_and(~kInCacheBit);
+    if (Refs(flags) == 0) {
+      Free(e);
+    }
+  }
+}
+
+void ClockCacheShard::ClockAppend(ClockHandle* e) {
+  if (hand_ == nullptr) {
+    e->next = e->prev = e;
+    hand_ = e;
+  } else {
+    e->next = hand_;
+    e->prev = hand_->prev;
+    e->prev->next = e;
+    hand_->prev = e;
+  }
+  ++num_entries_;
+}
+
+void ClockCacheShard::ClockRemove(ClockHandle* e) {
+  if (e->next == e) {
+    hand_ = nullptr;
+  } else {
+    if (hand_ == e) {
+      hand_ = e->next;
+    }
+    e->next->prev = e->prev;
+    e->prev->next = e->next;
+  }
+  e->next = e->prev = nullptr;
+  --num_entries_;
+}
+
+bool ClockCacheShard::RemoveFromCache(ClockHandle* e) {
+  ClockRemove(e);
+  const uint32_t flags = e->flags.fetch_and(~kInCacheBit, std::memory_order_acq_rel);
+  return Refs(flags) == 0;
+}
+
+void ClockCacheShard::Free(ClockHandle* e) {
+  (*e->deleter)(e->key(), e->value);
+  usage_.fetch_sub(e->charge, std::memory_order_relaxed);
+  if (metrics_ != nullptr) {
+    if (e->GetSubCacheType() == MULTI_TOUCH) {
+      metrics_->multi_touch_cache_usage->DecrementBy(e->charge);
+    } else {
+      metrics_->single_touch_cache_usage->DecrementBy(e->charge);
+    }
+    metrics_->cache_usage->DecrementBy(e->charge);
+  }
+  e->Destroy();
+}
+
+void ClockCacheShard::Evict(size_t charge, autovector<ClockHandle*>* deleted) {
+  const size_t max_steps = 2 * num_entries_;
+  size_t steps = 0;
+  while (usage_.load(std::memory_order_relaxed) + charge > capacity_ && hand_ != nullptr &&
+         steps < max_steps) {
+    ClockHandle* e = hand_;
+    hand_ = e->next;
+    // No lookup can add a reference while the lock is held exclusively, so an entry without
+    // external references stays that way until it is evicted.
+    const uint32_t flags = e->flags.load(std::memory_order_acquire);
+    if (Refs(flags) > 0) {
+      ++steps;
+      continue;
+    }
+    if (flags & kUsageBit) {
+      e->flags.fetch_and(~kUsageBit, std::memory_order_relaxed);
+      ++steps;
+      continue;
+    }
+    table_.Remove(e->key(), e->hash);
+    RemoveFromCache(e);
+    deleted->push_back(e);
+    if (metrics_ != nullptr) {
+      metrics_->evictions->Increment();
+    }
+  }
+}
+
+void ClockCacheShard::SetCapacity(size_t capacity) {
+  autovector<ClockHandle*> last_reference_list;
+  {
+    std::lock_guard<yb::rw_spinlock> l(mutex_);
+    capacity_ = capacity;
+    Evict(0, &last_reference_list);
+  }
+  for (auto entry : last_reference_list) {
+    Free(entry);
+  }
+}
+
+void ClockCacheShard::SetStrictCapacityLimit(bool strict_capacity_limit) {
+  std::lock_guard<yb::rw_spinlock> l(mutex_);
+  strict_capacity_limit_ = strict_capacity_limit;
+}
+
+void ClockCacheShard::ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) {
+  if (thread_safe) {
+    mutex_.lock_shared();
+  }
+  ClockHandle* e = hand_;
+  for (size_t i = 0; i < num_entries_; i++) {
+    callback(e->value, e->charge);
+    e = e->next;
+  }
+  if (thread_safe) {
+    mutex_.unlock_shared();
+  }
+}
+
+void ClockCacheShard::RecordHit(ClockHandle* e, Statistics* statistics) {
+  // overall cache hit
+  RecordTick(statistics, BLOCK_CACHE_HIT);
+  // total bytes read from cache
+  RecordTick(statistics, BLOCK_CACHE_BYTES_READ, e->charge);
+  if (e->GetSubCacheType() == SubCacheType::SINGLE_TOUCH) {
+    RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_HIT);
+    RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_READ, e->charge);
+  } else {
+    RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_HIT);
+    RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, e->charge);
+  }
+}
+
+Cache::Handle* ClockCacheShard::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                                       Statistics* statistics) {
+  ClockHandle* e;
+  {
+    yb::shared_lock<yb::rw_spinlock> l(mutex_);
+    e = table_.Lookup(key, hash);
+    if (e != nullptr) {
+      const uint32_t flags = e->flags.fetch_add(kOneRef, std::memory_order_acq_rel);
+      if (Refs(flags) == 0) {
+        pinned_usage_.fetch_add(e->charge, std::memory_order_relaxed);
+      }
+      // Only an access from another query gives the entry a second chance.
+      if (e->query_id != query_id && (flags & (kUsageBit | kMultiTouchBit)) !=
+                                         (kUsageBit | kMultiTouchBit)) {
+        const uint32_t old_flags = e->flags.fetch_or(
+            kUsageBit | kMultiTouchBit, std::memory_order_relaxed);
+        if (!(old_flags & kMultiTouchBit) && metrics_ != nullptr) {
+          metrics_->multi_touch_cache_usage->IncrementBy(e->charge);
+          metrics_->single_touch_cache_usage->DecrementBy(e->charge);
+        }
+      }
+      if (statistics != nullptr) {
+        RecordHit(e, statistics);
+      }
+    }
+  }
+
+  if (e == nullptr && statistics != nullptr) {
+    RecordTick(statistics, BLOCK_CACHE_MISS);
+  }
+  if (metrics_ != nullptr) {
+    metrics_->lookups->Increment();
+    if (e != nullptr) {
+      metrics_->cache_hits->Increment();
+    } else {
+      metrics_->cache_misses->Increment();
+    }
+  }
+  return reinterpret_cast<Cache::Handle*>(e);
+}
+
+void ClockCacheShard::Release(Cache::Handle* handle) {
+  if (handle == nullptr) {
+    return;
+  }
+  ClockHandle* e = reinterpret_cast<ClockHandle*>(handle);
+  // Once the last reference is dropped, the entry may be evicted by another thread at any time,
+  // so the charge is read before.
+  const size_t charge = e->charge;
+  const uint32_t flags = e->flags.fetch_sub(kOneRef, std::memory_order_acq_rel);
+  DCHECK_GE(Refs(flags), 1);
+  if (Refs(flags) == 1) {
+    pinned_usage_.fetch_sub(charge, std::memory_order_relaxed);
+    if (!(flags & kInCacheBit)) {
+      // The entry was erased or replaced while referenced, and this was the last reference.
+      Free(e);
+    }
+  }
+}
+
+Status ClockCacheShard::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                               void* value, size_t charge,
+                               void (*deleter)(const Slice& key, void* value),
+                               Cache::Handle** handle, Statistics* statistics) {
+  // Allocate the memory here outside of the mutex.
+  ClockHandle* e = ClockHandle::Allocate(key);
+  e->value = value;
+  e->deleter = deleter;
+  e->charge = charge;
+  e->hash = hash;
+  e->query_id = query_id;
+  e->next = e->prev = nullptr;
+  uint32_t flags = kInCacheBit;
+  if (handle != nullptr) {
+    flags += kOneRef;
+  }
+  if (query_id == kInMultiTouchId) {
+    flags |= kUsageBit | kMultiTouchBit;
+  }
+
+  Status s;
+  autovector<ClockHandle*> last_reference_list;
+  {
+    std::lock_guard<yb::rw_spinlock> l(mutex_);
+    // As in the LRU cache, a value inserted again by another query is considered multi touch.
+    ClockHandle* existing = table_.Lookup(key, hash);
+    if (existing != nullptr &&
+        (existing->GetSubCacheType() == MULTI_TOUCH || existing->query_id != query_id)) {
+      flags |= kUsageBit | kMultiTouchBit;
+    }
+    e->flags.store(flags, std::memory_order_relaxed);
+
+    Evict(charge, &last_reference_list);
+    if (strict_capacity_limit_ &&
+        usage_.load(std::memory_order_relaxed) + charge > capacity_) {
+      s = STATUS(Incomplete, "Insert failed due to clock cache being full.");
+    } else {
+      ClockHandle* old = table_.Insert(e);
+      ClockAppend(e);
+      usage_.fetch_add(charge, std::memory_order_relaxed);
+      if (handle != nullptr) {
+        pinned_usage_.fetch_add(charge, std::memory_order_relaxed);
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      if (old != nullptr && RemoveFromCache(old)) {
+        last_reference_list.push_back(old);
+      }
+      if (metrics_ != nullptr) {
+        if (flags & kMultiTouchBit) {
+          metrics_->multi_touch_cache_usage->IncrementBy(charge);
+        } else {
+          metrics_->single_touch_cache_usage->IncrementBy(charge);
+        }
+        metrics_->cache_usage->IncrementBy(charge);
+        metrics_->inserts->Increment();
+      }
+    }
+  }
+
+  if (statistics != nullptr) {
+    if (s.ok()) {
+      RecordTick(statistics, BLOCK_CACHE_ADD);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+      if (flags & kMultiTouchBit) {
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_ADD);
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_ADD);
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_WRITE, charge);
+      }
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+    }
+  }
+
+  if (!s.ok()) {
+    // The entry was never added to the cache, so it does not count towards the usage.
+    if (handle == nullptr) {
+      (*deleter)(key, value);
+    } else {
+      *handle = nullptr;
+    }
+    e->Destroy();
+  }
+
+  // We free the entries here outside of mutex for performance reasons.
+  for (auto entry : last_reference_list) {
+    Free(entry);
+  }
+  return s;
+}
+
+void ClockCacheShard::Erase(const Slice& key, uint32_t hash) {
+  ClockHandle* e;
+  bool last_reference = false;
+  {
+    std::lock_guard<yb::rw_spinlock> l(mutex_);
+    e = table_.Remove(key, hash);
+    if (e != nullptr) {
+      last_reference = RemoveFromCache(e);
+    }
+  }
+  // last_reference will only be true if e != nullptr
+  if (last_reference) {
+    Free(e);
+  }
+}
+
+class ShardedClockCache : public Cache {
+ public:
+  ShardedClockCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit)
+      : last_id_(0),
+        num_shard_bits_(num_shard_bits),
+        capacity_(capacity),
+        strict_capacity_limit_(strict_capacity_limit) {
+    const int num_shards = 1 << num_shard_bits_;
+    shards_ = new ClockCacheShard[num_shards];
+    const size_t per_shard = (capacity + (num_shards - 1)) / num_shards;
+    for (int s = 0; s < num_shards; s++) {
+      shards_[s].SetCapacity(per_shard);
+      shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
+    }
+  }
+
+  virtual ~ShardedClockCache() {
+    delete[] shards_;
+  }
+
+  void SetCapacity(size_t capacity) override {
+    const int num_shards = 1 << num_shard_bits_;
+    const size_t per_shard = (capacity + (num_shards - 1)) / num_shards;
+    std::lock_guard<std::mutex> l(capacity_mutex_);
+    for (int s = 0; s < num_shards; s++) {
+      shards_[s].SetCapacity(per_shard);
+    }
+    capacity_ = capacity;
+  }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit) override {
+    const int num_shards = 1 << num_shard_bits_;
+    for (int s = 0; s < num_shards; s++) {
+      shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
+    }
+    strict_capacity_limit_ = strict_capacity_limit;
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    DCHECK(IsValidQueryId(query_id));
+    // Queries with no cache query ids are not cached.
+    if (query_id == kNoCacheQueryId) {
+      return Status::OK();
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Insert(key, hash, query_id, value, charge, deleter,
+                                       handle, statistics);
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    DCHECK(IsValidQueryId(query_id));
+    if (query_id == kNoCacheQueryId) {
+      return nullptr;
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Lookup(key, hash, query_id, statistics);
+  }
+
+  void Release(Handle* handle) override {
+    ClockHandle* h = reinterpret_cast<ClockHandle*>(handle);
+    shards_[Shard(h->hash)].Release(handle);
+  }
+
+  void Erase(const Slice& key) override {
+    const uint32_t hash = HashSlice(key);
+    shards_[Shard(hash)].Erase(key, hash);
+  }
+
+  void* Value(Handle* handle) override {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+  }
+
+  uint64_t NewId() override {
+    return last_id_.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  size_t GetCapacity() const override { return capacity_; }
+
+  bool HasStrictCapacityLimit() const override {
+    return strict_capacity_limit_;
+  }
+
+  size_t GetUsage() const override {
+    const int num_shards = 1 << num_shard_bits_;
+    size_t usage = 0;
+    for (int s = 0; s < num_shards; s++) {
+      usage += shards_[s].GetUsage();
+    }
+    return usage;
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return reinterpret_cast<ClockHandle*>(handle)->charge;
+  }
+
+  size_t GetPinnedUsage() const override {
+    const int num_shards = 1 << num_shard_bits_;
+    size_t usage = 0;
+    for (int s = 0; s < num_shards; s++) {
+      usage += shards_[s].GetPinnedUsage();
+    }
+    return usage;
+  }
+
+  SubCacheType GetSubCacheType(Handle* e) const override {
+    return reinterpret_cast<ClockHandle*>(e)->GetSubCacheType();
+  }
+
+  void DisownData() override {
+    shards_ = nullptr;
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    const int num_shards = 1 << num_shard_bits_;
+    for (int s = 0; s < num_shards; s++) {
+      shards_[s].ApplyToAllCacheEntries(callback, thread_safe);
+    }
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+    const int num_shards = 1 << num_shard_bits_;
+    metrics_ = std::make_shared<yb::CacheMetrics>(entity);
+    for (int s = 0; s < num_shards; s++) {
+      shards_[s].SetMetrics(metrics_);
+    }
+  }
+
+ private:
+  static inline uint32_t HashSlice(const Slice& s) {
+    return Hash(s.data(), s.size(), 0);
+  }
+
+  uint32_t Shard(uint32_t hash) {
+    // Note, hash >> 32 yields hash in gcc, not the zero we expect!
+    return (num_shard_bits_ > 0) ? (hash >> (32 - num_shard_bits_)) : 0;
+  }
+
+  bool IsValidQueryId(const QueryId query_id) {
+    return query_id >= 0 || query_id == kInMultiTouchId || query_id == kNoCacheQueryId;
+  }
+
+  ClockCacheShard* shards_;
+  std::atomic<uint64_t> last_id_;
+  std::mutex capacity_mutex_;
+  const int num_shard_bits_;
+  size_t capacity_;
+  bool strict_capacity_limit_;
+  shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+}  // end anonymous namespace
+
+shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                bool strict_capacity_limit) {
+  if (num_shard_bits < 0) {
+    num_shard_bits = GetDefaultCacheShardBits();
+  }
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedClockCache>(capacity, num_shard_bits, strict_capacity_limit);
+}
+
+}  // namespace rocksdb
@@ -103,6 +103,8 @@ class RandomAccessFileReader {
 
   Status Read(uint64_t offset, size_t n, Slice* result, char* scratch) const;
 
+  void Readahead(uint64_t offset, size_t n) { file_->Readahead(offset, n); }
+
   RandomAccessFile* file() { return file_.get(); }
 };
 
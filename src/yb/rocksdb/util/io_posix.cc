@@ -223,6 +223,10 @@ void PosixRandomAccessFile::Hint(AccessPattern pattern) {
   }
 }
 
+void PosixRandomAccessFile::Readahead(uint64_t offset, size_t n) {
+  Fadvise(fd_, offset, n, POSIX_FADV_WILLNEED);
+}
+
 Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #ifndef OS_LINUX
   return Status::OK();
@@ -40,6 +40,7 @@
 #include "yb/rocksdb/sst_file_manager.h"
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/merge_operator.h"
+#include "yb/util/format.h"
 #include "yb/util/slice.h"
 #include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/table.h"
@@ -528,6 +529,13 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
   RHEADER(log,
       "Options.compaction_options_universal.compression_size_percent: %d",
       compaction_options_universal.compression_size_percent);
+  RHEADER(log,
+      "Options.compaction_options_universal.large_output_size_bytes: %" PRIu64,
+      compaction_options_universal.large_output_size_bytes);
+  RHEADER(log,
+      "Options.compaction_options_universal.large_output_compression: %s",
+      CompressionTypeToString(
+          compaction_options_universal.large_output_compression).c_str());
   RHEADER(log,
       "Options.compaction_options_fifo.max_table_files_size: %" PRIu64,
       compaction_options_fifo.max_table_files_size);
@@ -695,6 +703,12 @@ DBOptions* DBOptions::IncreaseParallelism(int total_threads) {
 
 const ReadOptions ReadOptions::kDefault;
 
+std::string ReadaheadStats::ToString() const {
+  return yb::Format(
+      "{ readaheads: $0 readahead_bytes: $1 sequential_blocks: $2 readahead_hits: $3 }",
+      readaheads, readahead_bytes, sequential_blocks, readahead_hits);
+}
+
 ReadOptions::ReadOptions()
     : verify_checksums(true),
       fill_cache(true),
@@ -727,4 +741,8 @@ ReadOptions::ReadOptions(bool cksum, bool cache)
              reinterpret_cast<ReadOptions*>(this));
 }
 
+bool IsCompressionTypeSupported(CompressionType compression_type) {
+  return CompressionTypeSupported(compression_type);
+}
+
 }  // namespace rocksdb
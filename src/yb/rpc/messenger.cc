@@ -91,6 +91,11 @@ DEFINE_uint64(io_thread_pool_size, 4, "Size of allocated IO Thread Pool.");
 
 DEFINE_int64(outbound_rpc_block_size, 1_MB, "Outbound RPC block size");
 DEFINE_int64(outbound_rpc_memory_limit, 0, "Outbound RPC memory limit");
+DEFINE_bool(rpc_batch_tcp_syscalls, false,
+            "Whether the socket syscalls of the TCP connections served by the same reactor should "
+            "be batched: data queued to a connection is written once per event loop iteration and "
+            "sockets are not read again after a short read.");
+TAG_FLAG(rpc_batch_tcp_syscalls, advanced);
 
 namespace yb {
 namespace rpc {
@@ -111,7 +116,9 @@ MessengerBuilder::MessengerBuilder(std::string name)
           rpc::CreateConnectionContextFactory<YBOutboundConnectionContext>(
               FLAGS_outbound_rpc_block_size, FLAGS_outbound_rpc_memory_limit)),
       listen_protocol_(TcpStream::StaticProtocol()) {
-  AddStreamFactory(TcpStream::StaticProtocol(), TcpStream::Factory());
+  TcpStreamOptions tcp_stream_options;
+  tcp_stream_options.batch_syscalls = FLAGS_rpc_batch_tcp_syscalls;
+  AddStreamFactory(TcpStream::StaticProtocol(), TcpStream::Factory(tcp_stream_options));
 }
 
 MessengerBuilder& MessengerBuilder::set_connection_keepalive_time(
@@ -153,6 +160,11 @@ MessengerBuilder &MessengerBuilder::AddStreamFactory(
   return *this;
 }
 
+MessengerBuilder &MessengerBuilder::SetTcpStreamOptions(const TcpStreamOptions& options) {
+  stream_factories_[TcpStream::StaticProtocol()] = TcpStream::Factory(options);
+  return *this;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Messenger
 // ------------------------------------------------------------------------------------------------
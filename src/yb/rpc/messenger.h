@@ -53,6 +53,7 @@
 #include "yb/rpc/reactor.h"
 #include "yb/rpc/response_callback.h"
 #include "yb/rpc/scheduler.h"
+#include "yb/rpc/tcp_stream.h"
 
 #include "yb/util/concurrent_value.h"
 #include "yb/util/locks.h"
@@ -102,6 +103,9 @@ class MessengerBuilder {
 
   MessengerBuilder &AddStreamFactory(const Protocol* protocol, StreamFactoryPtr factory);
 
+  // Set the options of the streams used for TCP connections, e.g. to batch socket syscalls.
+  MessengerBuilder &SetTcpStreamOptions(const TcpStreamOptions& options);
+
   MessengerBuilder &SetListenProtocol(const Protocol* protocol) {
     listen_protocol_ = protocol;
     return *this;
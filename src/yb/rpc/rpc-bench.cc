@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <algorithm>
 #include <string>
 #include <thread>
 
@@ -38,9 +39,13 @@
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rtest.proxy.h"
 #include "yb/util/countdown_latch.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/test_util.h"
 
 using namespace std::literals; // NOLINT
+using namespace yb::size_literals;
+
+DECLARE_int32(num_connections_to_server);
 
 using std::string;
 using std::shared_ptr;
@@ -150,6 +155,156 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+// Measures responses with large sidecars built the way large read responses are: serialized in
+// small pieces, then either copied into one buffer or sent as a chain of buffers.
+class LargeSidecarBench : public RpcBench {
+ protected:
+  void RunClients(rpc_test::SendStringsRequestPB::SidecarMode mode) {
+    constexpr size_t kSidecarSize = 1_MB;
+    constexpr int kNumThreads = 8;
+
+    should_run_.store(true, std::memory_order_release);
+    std::vector<std::vector<MonoDelta>> latencies(kNumThreads);
+    std::vector<std::thread> threads;
+
+    Stopwatch sw(Stopwatch::ALL_THREADS);
+    sw.start();
+    for (int i = 0; i < kNumThreads; i++) {
+      threads.emplace_back([this, mode, kSidecarSize, &latencies, i] {
+        Proxy proxy(client_messenger_, server_hostport_);
+        rpc_test::SendStringsRequestPB req;
+        req.set_random_seed(i);
+        req.add_sizes(kSidecarSize);
+        req.set_sidecar_mode(mode);
+        rpc_test::SendStringsResponsePB resp;
+        while (should_run_.load(std::memory_order_acquire)) {
+          RpcController controller;
+          controller.set_timeout(MonoDelta::FromSeconds(10));
+          auto start = MonoTime::Now();
+          CHECK_OK(proxy.SyncRequest(
+              GenericCalculatorService::SendStringsMethod(), req, &resp, &controller));
+          latencies[i].push_back(MonoTime::Now() - start);
+        }
+      });
+    }
+
+    std::this_thread::sleep_for(10s);
+    should_run_.store(false, std::memory_order_release);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    sw.stop();
+
+    std::vector<MonoDelta> all_latencies;
+    for (const auto& thread_latencies : latencies) {
+      all_latencies.insert(all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+    }
+    ASSERT_FALSE(all_latencies.empty());
+    std::sort(all_latencies.begin(), all_latencies.end());
+    const size_t total_reqs = all_latencies.size();
+
+    LOG(INFO) << "Sidecar mode:     " << rpc_test::SendStringsRequestPB::SidecarMode_Name(mode);
+    LOG(INFO) << "Reqs/sec:         " << total_reqs / sw.elapsed().wall_seconds();
+    LOG(INFO) << "User CPU per req: " << sw.elapsed().user / 1000.0 / total_reqs << "us";
+    LOG(INFO) << "Sys CPU per req:  " << sw.elapsed().system / 1000.0 / total_reqs << "us";
+    LOG(INFO) << "p99 latency:      " << all_latencies[total_reqs * 99 / 100];
+  }
+};
+
+TEST_F(LargeSidecarBench, BenchmarkLargeSidecars) {
+  StartTestServer(&server_hostport_);
+
+  MessengerOptions client_options = kDefaultClientMessengerOptions;
+  client_options.n_reactors = 2;
+  client_messenger_ = CreateMessenger("Client", client_options);
+
+  RunClients(rpc_test::SendStringsRequestPB::COPIED);
+  RunClients(rpc_test::SendStringsRequestPB::CHUNKED);
+}
+
+// Measures syscalls per RPC and throughput with 10k concurrent client connections. Each client
+// messenger keeps one call in flight on each of its connections.
+class ManyConnectionsBench : public RpcBench {
+ protected:
+  void RunCalls(bool batch_syscalls) {
+    constexpr int kNumClients = 40;
+    constexpr int kConnectionsPerClient = 250;
+    FLAGS_num_connections_to_server = kConnectionsPerClient;
+
+    TcpStreamOptions tcp_stream_options;
+    tcp_stream_options.batch_syscalls = batch_syscalls;
+    tcp_stream_options.stats = std::make_shared<TcpStreamStats>();
+
+    TestServerOptions server_options;
+    server_options.messenger = ASSERT_RESULT(
+        CreateMessengerBuilder("TestServer", kDefaultServerMessengerOptions)
+            .SetTcpStreamOptions(tcp_stream_options).Build());
+    StartTestServerWithGeneratedCode(&server_hostport_, server_options);
+
+    std::atomic<int64_t> total_calls{0};
+    std::vector<std::thread> threads;
+    Stopwatch sw(Stopwatch::ALL_THREADS);
+    sw.start();
+    for (int i = 0; i != kNumClients; ++i) {
+      threads.emplace_back([this, &tcp_stream_options, &total_calls, kConnectionsPerClient] {
+        auto messenger = CHECK_RESULT(
+            CreateMessengerBuilder("Client", kDefaultClientMessengerOptions)
+                .SetTcpStreamOptions(tcp_stream_options).Build());
+        ProxyCache proxy_cache(messenger);
+        rpc_test::CalculatorServiceProxy proxy(&proxy_cache, server_hostport_);
+
+        std::vector<rpc_test::AddRequestPB> requests(kConnectionsPerClient);
+        std::vector<rpc_test::AddResponsePB> responses(kConnectionsPerClient);
+        std::vector<RpcController> controllers(kConnectionsPerClient);
+        while (should_run_.load(std::memory_order_acquire)) {
+          CountDownLatch latch(kConnectionsPerClient);
+          for (int j = 0; j != kConnectionsPerClient; ++j) {
+            requests[j].set_x(j);
+            requests[j].set_y(j);
+            controllers[j].Reset();
+            controllers[j].set_timeout(MonoDelta::FromSeconds(30));
+            proxy.AddAsync(requests[j], &responses[j], &controllers[j], [&latch] {
+              latch.CountDown();
+            });
+          }
+          latch.Wait();
+          for (int j = 0; j != kConnectionsPerClient; ++j) {
+            CHECK_OK(controllers[j].status());
+            CHECK_EQ(2 * j, responses[j].result());
+          }
+          total_calls.fetch_add(kConnectionsPerClient, std::memory_order_relaxed);
+        }
+      });
+    }
+
+    std::this_thread::sleep_for(10s);
+    should_run_.store(false, std::memory_order_release);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    sw.stop();
+
+    const auto calls = total_calls.load();
+    ASSERT_GT(calls, 0);
+    const auto& stats = *tcp_stream_options.stats;
+    LOG(INFO) << "Batch syscalls:   " << batch_syscalls;
+    LOG(INFO) << "Connections:      " << kNumClients * kConnectionsPerClient;
+    LOG(INFO) << "Reqs/sec:         " << calls / sw.elapsed().wall_seconds();
+    LOG(INFO) << "Reads per req:    " << static_cast<double>(stats.reads) / calls;
+    LOG(INFO) << "Writes per req:   " << static_cast<double>(stats.writes) / calls;
+    LOG(INFO) << "User CPU per req: " << sw.elapsed().user / 1000.0 / calls << "us";
+    LOG(INFO) << "Sys CPU per req:  " << sw.elapsed().system / 1000.0 / calls << "us";
+  }
+};
+
+TEST_F(ManyConnectionsBench, BenchmarkTcpSyscalls) {
+  RunCalls(false /* batch_syscalls */);
+}
+
+TEST_F(ManyConnectionsBench, BenchmarkBatchedTcpSyscalls) {
+  RunCalls(true /* batch_syscalls */);
+}
+
 } // namespace rpc
 } // namespace yb
 
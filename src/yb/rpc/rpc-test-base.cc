@@ -144,13 +144,37 @@ void GenericCalculatorService::DoSendStrings(InboundCall* incoming) {
     LOG(FATAL) << "couldn't parse: " << param.ToDebugString();
   }
 
+  // Size of the pieces the sidecars are serialized in, when not generated directly.
+  constexpr size_t kPieceSize = 4096;
+
   Random r(req.random_seed());
   SendStringsResponsePB resp;
+  faststring source;
   for (auto size : req.sizes()) {
-    auto sidecar = RefCntBuffer(size);
-    RandomString(sidecar.udata(), size, &r);
     int idx = 0;
-    auto status = down_cast<YBInboundCall*>(incoming)->AddRpcSidecar(sidecar, &idx);
+    Status status;
+    if (req.sidecar_mode() == SendStringsRequestPB::DIRECT) {
+      auto sidecar = RefCntBuffer(size);
+      RandomString(sidecar.udata(), size, &r);
+      status = down_cast<YBInboundCall*>(incoming)->AddRpcSidecar(sidecar, &idx);
+    } else {
+      source.resize(size);
+      RandomString(source.data(), size, &r);
+      if (req.sidecar_mode() == SendStringsRequestPB::CHUNKED) {
+        RefCntBufferChain chain;
+        for (size_t pos = 0; pos < size; pos += kPieceSize) {
+          chain.Append(source.data() + pos, std::min(kPieceSize, size - pos));
+        }
+        status = down_cast<YBInboundCall*>(incoming)->AddRpcSidecar(&chain, &idx);
+      } else {
+        faststring serialized;
+        for (size_t pos = 0; pos < size; pos += kPieceSize) {
+          serialized.append(source.data() + pos, std::min(kPieceSize, size - pos));
+        }
+        status = down_cast<YBInboundCall*>(incoming)->AddRpcSidecar(
+            RefCntBuffer(serialized), &idx);
+      }
+    }
     if (!status.ok()) {
       incoming->RespondFailure(ErrorStatusPB::ERROR_APPLICATION, status);
       return;
@@ -373,7 +397,8 @@ CHECKED_STATUS RpcTestBase::DoTestSyncCall(Proxy* proxy, const RemoteMethod* met
 
 void RpcTestBase::DoTestSidecar(Proxy* proxy,
                                 std::vector<size_t> sizes,
-                                Status::Code expected_code) {
+                                Status::Code expected_code,
+                                SendStringsRequestPB::SidecarMode mode) {
   const uint32_t kSeed = 12345;
 
   SendStringsRequestPB req;
@@ -381,6 +406,7 @@ void RpcTestBase::DoTestSidecar(Proxy* proxy,
     req.add_sizes(size);
   }
   req.set_random_seed(kSeed);
+  req.set_sidecar_mode(mode);
 
   SendStringsResponsePB resp;
   RpcController controller;
@@ -431,8 +457,9 @@ void RpcTestBase::DoTestExpectTimeout(Proxy* proxy, const MonoDelta& timeout) {
 
 void RpcTestBase::StartTestServer(Endpoint* server_endpoint, const TestServerOptions& options) {
   std::unique_ptr<ServiceIf> service(new GenericCalculatorService(metric_entity_));
-  server_.reset(new TestServer(
-      std::move(service), CreateMessenger("TestServer", options.messenger_options), options));
+  auto messenger = options.messenger ? options.messenger
+                                     : CreateMessenger("TestServer", options.messenger_options);
+  server_.reset(new TestServer(std::move(service), messenger, options));
   *server_endpoint = server_->bound_endpoint();
 }
 
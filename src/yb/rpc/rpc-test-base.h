@@ -174,7 +174,9 @@ class RpcTestBase : public YBTest {
 
   void DoTestSidecar(Proxy* proxy,
                      std::vector<size_t> sizes,
-                     Status::Code expected_code = Status::Code::kOk);
+                     Status::Code expected_code = Status::Code::kOk,
+                     rpc_test::SendStringsRequestPB::SidecarMode mode =
+                         rpc_test::SendStringsRequestPB::DIRECT);
 
   void DoTestExpectTimeout(Proxy* proxy, const MonoDelta &timeout);
   void StartTestServer(HostPort* server_hostport,
@@ -338,6 +338,70 @@ TEST_F(TestRpc, TestRpcSidecar) {
   DoTestSidecar(&p, sizes, Status::kRemoteError);
 }
 
+// Test sending sidecars built as chains of buffers.
+TEST_F(TestRpc, TestChunkedSidecar) {
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+
+  shared_ptr<Messenger> client_messenger(CreateMessenger("Client"));
+  Proxy p(client_messenger, server_addr);
+
+  const auto kChunked = rpc_test::SendStringsRequestPB::CHUNKED;
+  DoTestSidecar(&p, {0, 123, 456}, Status::kOk, kChunked);
+
+  // Large sidecars consist of more chunks than can be written with a single writev().
+  DoTestSidecar(&p, {3000 * 1024, 10, 20 * 1024 * 1024}, Status::kOk, kChunked);
+
+  // The limit on the number of sidecars does not depend on the number of chunks.
+  std::vector<size_t> sizes(CallResponse::kMaxSidecarSlices, 100 * 1024);
+  DoTestSidecar(&p, sizes, Status::kOk, kChunked);
+
+  sizes.push_back(333);
+  DoTestSidecar(&p, sizes, Status::kRemoteError, kChunked);
+}
+
+// Test calls over connections that batch socket syscalls.
+TEST_F(TestRpc, TestBatchedTcpSyscalls) {
+  TcpStreamOptions tcp_stream_options;
+  tcp_stream_options.batch_syscalls = true;
+  tcp_stream_options.stats = std::make_shared<TcpStreamStats>();
+
+  TestServerOptions options;
+  options.messenger = ASSERT_RESULT(
+      CreateMessengerBuilder("TestServer", kDefaultServerMessengerOptions)
+          .SetTcpStreamOptions(tcp_stream_options).Build());
+  HostPort server_addr;
+  StartTestServer(&server_addr, options);
+
+  auto client_messenger = ASSERT_RESULT(
+      CreateMessengerBuilder("Client").SetTcpStreamOptions(tcp_stream_options).Build());
+  Proxy p(client_messenger, server_addr);
+
+  ASSERT_OK(DoTestSyncCall(&p, GenericCalculatorService::AddMethod()));
+
+  // Large responses cannot be written at once, so their writing is continued when the socket
+  // becomes writable.
+  DoTestSidecar(&p, {3000 * 1024, 2000 * 1024});
+
+  // Concurrent calls are batched over the same connections.
+  constexpr int kThreads = 8;
+  constexpr int kCallsPerThread = 100;
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kThreads; ++i) {
+    threads.emplace_back([this, &p, kCallsPerThread] {
+      for (int j = 0; j != kCallsPerThread; ++j) {
+        CHECK_OK(DoTestSyncCall(&p, GenericCalculatorService::AddMethod()));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_GT(tcp_stream_options.stats->reads.load(), 0U);
+  ASSERT_GT(tcp_stream_options.stats->writes.load(), 0U);
+}
+
 // Test that timeouts are properly handled.
 TEST_F(TestRpc, TestCallTimeout) {
   HostPort server_addr;
@@ -173,6 +173,12 @@ class RpcContext {
   // by the RPC response.
   CHECKED_STATUS AddRpcSidecar(RefCntBuffer car, int* idx);
 
+  // Adds an RpcSidecar made of the chunks of 'car'. The chunks are sent as they are, without
+  // copying them into a contiguous buffer, so large responses can be built directly in them.
+  //
+  // No more data should be appended to 'car' after insertion.
+  CHECKED_STATUS AddRpcSidecar(RefCntBufferChain* car, int* idx);
+
   // Removes all RpcSidecars.
   void ResetRpcSidecars();
 
@@ -148,6 +148,11 @@ void ConnectionContextWithQueue::FlushOutboundQueue(Connection* conn) {
         calls_queue_.begin() + end);
     conn->QueueOutboundDataBatch(batch);
   }
+
+  if (parse_received_when_call_completes_ && begin != end) {
+    parse_received_when_call_completes_ = false;
+    conn->ParseReceived();
+  }
 }
 
 void ConnectionContextWithQueue::AssignConnection(const ConnectionPtr& conn) {
@@ -78,6 +78,19 @@ class ConnectionContextWithQueue : public ConnectionContextBase {
 
   void Enqueue(std::shared_ptr<QueueableInboundCall> call);
 
+  // Returns true if max_concurrent_calls calls are being processed, so a new call would have to
+  // wait in the queue.
+  bool processing_limit_reached() const {
+    return calls_queue_.size() - replies_being_sent_ >= max_concurrent_calls_;
+  }
+
+  // Requests the connection to parse the received data again once one of the calls being
+  // processed has a reply. Used to defer forming a call while it would only wait in the queue, so
+  // that it could include the data received meanwhile.
+  void ParseReceivedWhenCallCompletes() {
+    parse_received_when_call_completes_ = true;
+  }
+
   uint64_t ProcessedCallCount() override {
     return processed_call_count_.load(std::memory_order_acquire);
   }
@@ -112,6 +125,7 @@ class ConnectionContextWithQueue : public ConnectionContextBase {
   std::atomic<QueueableInboundCall*> first_without_reply_{nullptr};
   std::atomic<uint64_t> processed_call_count_{0};
   IdleListener idle_listener_;
+  bool parse_received_when_call_completes_ = false;
 };
 
 } // namespace rpc
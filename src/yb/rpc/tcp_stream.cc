@@ -13,6 +13,8 @@
 
 #include "yb/rpc/tcp_stream.h"
 
+#include <algorithm>
+
 #include "yb/rpc/outbound_data.h"
 
 #include "yb/util/logging.h"
@@ -25,11 +27,63 @@ DECLARE_uint64(rpc_connection_timeout_ms);
 namespace yb {
 namespace rpc {
 
+TcpStreamWriteBatcher::TcpStreamWriteBatcher(ev::loop_ref* loop) {
+  prepare_.set(*loop);
+  prepare_.set<TcpStreamWriteBatcher, &TcpStreamWriteBatcher::Flush>(this);
+}
+
+TcpStreamWriteBatcher::~TcpStreamWriteBatcher() {
+  // Streams cancel their writes when shut down, so the watcher was already stopped.
+  CHECK(pending_.empty());
+}
+
+void TcpStreamWriteBatcher::Schedule(TcpStream* stream) {
+  pending_.push_back(stream);
+  if (!prepare_.is_active()) {
+    prepare_.start();
+  }
+}
+
+void TcpStreamWriteBatcher::Cancel(TcpStream* stream) {
+  pending_.erase(std::remove(pending_.begin(), pending_.end(), stream), pending_.end());
+  // The stream could be shut down by Flush() writing to another stream of the same reactor.
+  std::replace(flushing_.begin(), flushing_.end(), stream, static_cast<TcpStream*>(nullptr));
+  if (pending_.empty() && flushing_.empty()) {
+    prepare_.stop();
+  }
+}
+
+void TcpStreamWriteBatcher::Flush(ev::prepare& watcher, int revents) { // NOLINT
+  flushing_.swap(pending_);
+  // Streams that are scheduled while flushing are written at the next loop iteration.
+  for (size_t i = 0; i != flushing_.size(); ++i) {
+    if (flushing_[i]) {
+      flushing_[i]->FlushScheduledWrite();
+    }
+  }
+  flushing_.clear();
+  if (pending_.empty()) {
+    prepare_.stop();
+  }
+}
+
+TcpStreamWriteBatcher* TcpStreamWriteBatchers::Get(ev::loop_ref* loop) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& batcher = batchers_[static_cast<struct ev_loop*>(*loop)];
+  if (!batcher) {
+    batcher = std::make_unique<TcpStreamWriteBatcher>(loop);
+  }
+  return batcher.get();
+}
+
 TcpStream::TcpStream(
-    const Endpoint& remote, Socket socket, GrowableBufferAllocator* allocator, size_t limit)
+    const Endpoint& remote, Socket socket, GrowableBufferAllocator* allocator, size_t limit,
+    const TcpStreamOptions& options, TcpStreamWriteBatchers* write_batchers)
     : socket_(std::move(socket)),
       remote_(remote),
-      read_buffer_(allocator, limit) {
+      read_buffer_(allocator, limit),
+      stats_(options.stats),
+      write_batchers_(options.batch_syscalls ? write_batchers : nullptr) {
 }
 
 TcpStream::~TcpStream() {
@@ -66,6 +120,10 @@ Status TcpStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context
   int events = ev::READ | (!connected_ ? ev::WRITE : 0);
   io_.start(socket_.GetFd(), events);
 
+  if (write_batchers_) {
+    write_batcher_ = write_batchers_->Get(loop);
+  }
+
   DVLOG_WITH_PREFIX(4) << "Starting, listen events: " << events << ", fd: " << socket_.GetFd();
 
   is_epoll_registered_ = true;
@@ -85,6 +143,11 @@ void TcpStream::Close() {
 }
 
 void TcpStream::Shutdown(const Status& status) {
+  if (write_scheduled_) {
+    write_batcher_->Cancel(this);
+    write_scheduled_ = false;
+  }
+
   ClearSending(status);
 
   if (!read_buffer_.empty()) {
@@ -98,6 +161,20 @@ void TcpStream::Shutdown(const Status& status) {
 }
 
 Status TcpStream::TryWrite() {
+  if (write_batcher_) {
+    // Write when the reactor has handled all ready events, unless we are waiting for the socket to
+    // become writable anyway.
+    if (!write_scheduled_ && connected_ && !waiting_write_ready_ && is_epoll_registered_) {
+      write_scheduled_ = true;
+      write_batcher_->Schedule(this);
+    }
+    return Status::OK();
+  }
+
+  return WriteAndUpdateEvents();
+}
+
+Status TcpStream::WriteAndUpdateEvents() {
   auto result = DoWrite();
   if (result.ok()) {
     UpdateEvents();
@@ -105,6 +182,15 @@ Status TcpStream::TryWrite() {
   return result;
 }
 
+void TcpStream::FlushScheduledWrite() {
+  write_scheduled_ = false;
+  auto status = WriteAndUpdateEvents();
+  if (!status.ok()) {
+    VLOG_WITH_PREFIX(1) << "Write failed: " << status;
+    context_->Destroy(status);
+  }
+}
+
 Status TcpStream::DoWrite() {
   if (!connected_ || waiting_write_ready_ || !is_epoll_registered_) {
     return Status::OK();
@@ -112,7 +198,9 @@ Status TcpStream::DoWrite() {
 
   // If we weren't waiting write to be ready, we could try to write data to socket.
   while (!sending_.empty()) {
-    const size_t kMaxIov = 16;
+    // Large sidecars are queued as chains of chunks, so allow enough of them in a single writev()
+    // to send a whole large response at once.
+    const size_t kMaxIov = 64;
     iovec iov[kMaxIov];
     const int iov_len = static_cast<int>(std::min(kMaxIov, sending_.size()));
     size_t offset = send_position_;
@@ -125,6 +213,9 @@ Status TcpStream::DoWrite() {
     context_->UpdateLastActivity();
     int32_t written = 0;
 
+    if (stats_) {
+      stats_->writes.fetch_add(1, std::memory_order_relaxed);
+    }
     auto status = socket_.Writev(iov, iov_len, &written);
     if (PREDICT_FALSE(!status.ok())) {
       if (!Socket::IsTemporarySocketError(status)) {
@@ -217,6 +308,10 @@ Status TcpStream::ReadHandler() {
     if (!continue_receiving.get()) {
       return Status::OK();
     }
+    // Level triggered notification will tell us when there is more data.
+    if (write_batcher_ && read_drained_) {
+      return Status::OK();
+    }
   }
 }
 
@@ -231,6 +326,9 @@ Result<bool> TcpStream::Receive() {
   }
   read_buffer_full_ = false;
 
+  if (stats_) {
+    stats_->reads.fetch_add(1, std::memory_order_relaxed);
+  }
   auto nread = socket_.Recvv(iov.get_ptr());
   if (!nread.ok()) {
     if (Socket::IsTemporarySocketError(nread.status())) {
@@ -238,6 +336,7 @@ Result<bool> TcpStream::Receive() {
     }
     return nread.status();
   }
+  read_drained_ = static_cast<size_t>(*nread) < IoVecsFullSize(*iov);
 
   read_buffer_.DataAppended(*nread);
   return *nread != 0;
@@ -344,17 +443,24 @@ const Protocol* TcpStream::StaticProtocol() {
   return &result;
 }
 
-StreamFactoryPtr TcpStream::Factory() {
+StreamFactoryPtr TcpStream::Factory(const TcpStreamOptions& options) {
   class TcpStreamFactory : public StreamFactory {
+   public:
+    explicit TcpStreamFactory(const TcpStreamOptions& options) : options_(options) {}
+
    private:
     std::unique_ptr<Stream> Create(
         const Endpoint& remote, Socket socket, GrowableBufferAllocator* allocator, size_t limit)
             override {
-      return std::make_unique<TcpStream>(remote, std::move(socket), allocator, limit);
+      return std::make_unique<TcpStream>(
+          remote, std::move(socket), allocator, limit, options_, &write_batchers_);
     }
+
+    const TcpStreamOptions options_;
+    TcpStreamWriteBatchers write_batchers_;
   };
 
-  return std::make_shared<TcpStreamFactory>();
+  return std::make_shared<TcpStreamFactory>(options);
 }
 
 } // namespace rpc
@@ -14,6 +14,10 @@
 #ifndef YB_RPC_TCP_STREAM_H
 #define YB_RPC_TCP_STREAM_H
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 #include <ev++.h>
 
 #include "yb/rpc/growable_buffer.h"
@@ -25,10 +29,62 @@
 namespace yb {
 namespace rpc {
 
+class TcpStream;
+
+// Numbers of socket syscalls made by TCP streams.
+struct TcpStreamStats {
+  std::atomic<uint64_t> reads{0};
+  std::atomic<uint64_t> writes{0};
+};
+
+struct TcpStreamOptions {
+  // Batch the socket syscalls of the connections served by the same reactor. Data queued to a
+  // connection is written once per event loop iteration, after all ready events were handled, so
+  // the calls and responses queued during the iteration are sent with a single writev(). A socket
+  // is not read again after a read that did not fill the read buffer, since it would only return
+  // EAGAIN.
+  bool batch_syscalls = false;
+
+  // If set, the syscalls made by the streams are counted here.
+  std::shared_ptr<TcpStreamStats> stats;
+};
+
+// Writes the data queued to the streams of an event loop at the end of each loop iteration.
+class TcpStreamWriteBatcher {
+ public:
+  explicit TcpStreamWriteBatcher(ev::loop_ref* loop);
+  ~TcpStreamWriteBatcher();
+
+  void Schedule(TcpStream* stream);
+  void Cancel(TcpStream* stream);
+
+ private:
+  void Flush(ev::prepare& watcher, int revents); // NOLINT
+
+  // Called before the event loop waits for new events.
+  ev::prepare prepare_;
+
+  // Streams scheduled for writing, and the ones being written by Flush().
+  std::vector<TcpStream*> pending_;
+  std::vector<TcpStream*> flushing_;
+};
+
+// Write batchers of the event loops that streams created by a factory are started on.
+class TcpStreamWriteBatchers {
+ public:
+  TcpStreamWriteBatcher* Get(ev::loop_ref* loop);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<struct ev_loop*, std::unique_ptr<TcpStreamWriteBatcher>> batchers_;
+};
+
 class TcpStream : public Stream {
  public:
   TcpStream(
-      const Endpoint& remote, Socket socket, GrowableBufferAllocator* allocator, size_t limit);
+      const Endpoint& remote, Socket socket, GrowableBufferAllocator* allocator, size_t limit,
+      const TcpStreamOptions& options = TcpStreamOptions(),
+      TcpStreamWriteBatchers* write_batchers = nullptr);
   ~TcpStream();
 
   Socket* socket() { return &socket_; }
@@ -36,9 +92,11 @@ class TcpStream : public Stream {
   std::string ToString() const;
 
   static const rpc::Protocol* StaticProtocol();
-  static StreamFactoryPtr Factory();
+  static StreamFactoryPtr Factory(const TcpStreamOptions& options = TcpStreamOptions());
 
  private:
+  friend class TcpStreamWriteBatcher;
+
   CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
   void Close() override;
   void Shutdown(const Status& status) override;
@@ -59,6 +117,9 @@ class TcpStream : public Stream {
   void ParseReceived() override;
 
   CHECKED_STATUS DoWrite();
+  CHECKED_STATUS WriteAndUpdateEvents();
+  // Writes the data queued while a batched write was scheduled.
+  void FlushScheduledWrite();
   void HandleOutcome(const Status& status, bool enqueue);
   void ClearSending(const Status& status);
 
@@ -107,6 +168,16 @@ class TcpStream : public Stream {
   std::deque<OutboundDataPtr> sending_outbound_datas_;
   size_t send_position_ = 0;
   bool waiting_write_ready_ = false;
+
+  const std::shared_ptr<TcpStreamStats> stats_;
+
+  // Set when syscalls are batched.
+  TcpStreamWriteBatchers* const write_batchers_;
+  TcpStreamWriteBatcher* write_batcher_ = nullptr;
+  bool write_scheduled_ = false;
+
+  // Whether the last read did not fill the read buffer, i.e. there is nothing more to read.
+  bool read_drained_ = false;
 };
 
 } // namespace rpc
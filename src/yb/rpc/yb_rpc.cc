@@ -206,20 +206,41 @@ Status YBInboundCall::ParseFrom(const MemTrackerPtr& mem_tracker, std::vector<ch
 Status YBInboundCall::AddRpcSidecar(RefCntBuffer car, int* idx) {
   // Check that the number of sidecars does not exceed the number of payload
   // slices that are free.
-  if(sidecars_.size() >= CallResponse::kMaxSidecarSlices) {
+  if(sidecar_sizes_.size() >= CallResponse::kMaxSidecarSlices) {
     return STATUS(ServiceUnavailable, "All available sidecars already used");
   }
-  *idx = static_cast<int>(sidecars_.size());
+  *idx = static_cast<int>(sidecar_sizes_.size());
   if(consumption_) {
     consumption_.Add(car.size());
   }
+  sidecar_sizes_.push_back(car.size());
   sidecars_.push_back(std::move(car));
 
   return Status::OK();
 }
 
+Status YBInboundCall::AddRpcSidecar(RefCntBufferChain* car, int* idx) {
+  // The response of a local call refers to each sidecar in place, so it has to be contiguous.
+  if (IsLocalCall()) {
+    return AddRpcSidecar(car->Flatten(), idx);
+  }
+  if(sidecar_sizes_.size() >= CallResponse::kMaxSidecarSlices) {
+    return STATUS(ServiceUnavailable, "All available sidecars already used");
+  }
+  *idx = static_cast<int>(sidecar_sizes_.size());
+  if(consumption_) {
+    consumption_.Add(car->size());
+  }
+  const auto& chunks = car->Finish();
+  sidecar_sizes_.push_back(car->size());
+  sidecars_.insert(sidecars_.end(), chunks.begin(), chunks.end());
+
+  return Status::OK();
+}
+
 void YBInboundCall::ResetRpcSidecars() {
   sidecars_.clear();
+  sidecar_sizes_.clear();
 }
 
 Status YBInboundCall::SerializeResponseBuffer(const google::protobuf::MessageLite& response,
@@ -233,9 +254,9 @@ Status YBInboundCall::SerializeResponseBuffer(const google::protobuf::MessageLit
   resp_hdr.set_call_id(header_.call_id());
   resp_hdr.set_is_error(!is_success);
   uint32_t absolute_sidecar_offset = protobuf_msg_size;
-  for (auto& car : sidecars_) {
+  for (auto size : sidecar_sizes_) {
     resp_hdr.add_sidecar_offsets(absolute_sidecar_offset);
-    absolute_sidecar_offset += car.size();
+    absolute_sidecar_offset += size;
   }
 
   int additional_size = absolute_sidecar_offset - protobuf_msg_size;
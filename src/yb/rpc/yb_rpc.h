@@ -94,6 +94,7 @@ class YBInboundCall : public InboundCall {
 
   // See RpcContext::AddRpcSidecar()
   CHECKED_STATUS AddRpcSidecar(RefCntBuffer car, int* idx);
+  CHECKED_STATUS AddRpcSidecar(RefCntBufferChain* car, int* idx);
 
   // See RpcContext::ResetRpcSidecars()
   void ResetRpcSidecars();
@@ -149,7 +150,10 @@ class YBInboundCall : public InboundCall {
  protected:
   // Vector of additional sidecars that are tacked on to the call's response
   // after serialization of the protobuf. See rpc/rpc_sidecar.h for more info.
+  // A sidecar added as a RefCntBufferChain occupies several consecutive buffers here, so the sizes
+  // of the sidecars are kept separately.
   std::vector<RefCntBuffer> sidecars_;
+  std::vector<size_t> sidecar_sizes_;
 
   // Serialize and queue the response.
   virtual void Respond(const google::protobuf::MessageLite& response, bool is_success);
@@ -11,7 +11,9 @@
 // under the License.
 //
 
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_operation.h"
+#include "yb/docdb/docdb_util.h"
 #include "yb/tablet/abstract_tablet.h"
 #include "yb/util/trace.h"
 #include "yb/yql/pgsql/ybpostgres/pg_send.h"
@@ -19,6 +21,46 @@
 namespace yb {
 namespace tablet {
 
+std::string AbstractTablet::ReadHashedKey(const RedisReadRequestPB& redis_read_request) {
+  const auto& key_value = redis_read_request.key_value();
+  if (!key_value.has_hash_code()) {
+    return std::string();
+  }
+  return docdb::DocKey::EncodedHashedPart(
+      docdb::DocKey::EncodedFromRedisKey(key_value.hash_code(), key_value.key()).AsSlice())
+      .ToBuffer();
+}
+
+std::string AbstractTablet::ReadHashedKey(const QLReadRequestPB& ql_read_request) const {
+  if (ql_read_request.hashed_column_values().empty()) {
+    return std::string();
+  }
+  std::vector<docdb::PrimitiveValue> hashed_components;
+  const Schema& schema = SchemaRef();
+  if (!docdb::QLKeyColumnValuesToPrimitiveValues(
+          ql_read_request.hashed_column_values(), schema, 0, schema.num_hash_key_columns(),
+          &hashed_components).ok()) {
+    return std::string();
+  }
+  return docdb::DocKey::EncodedHashedPart(
+      docdb::DocKey(ql_read_request.hash_code(), hashed_components).Encode().AsSlice())
+      .ToBuffer();
+}
+
+std::string AbstractTablet::ReadHashedKey(const PgsqlReadRequestPB& pgsql_read_request) const {
+  if (pgsql_read_request.hashed_column_values().empty()) {
+    return std::string();
+  }
+  std::vector<docdb::PrimitiveValue> hashed_components;
+  if (!docdb::InitKeyColumnPrimitiveValues(
+          pgsql_read_request.hashed_column_values(), SchemaRef(), 0, &hashed_components).ok()) {
+    return std::string();
+  }
+  return docdb::DocKey::EncodedHashedPart(
+      docdb::DocKey(pgsql_read_request.hash_code(), hashed_components).Encode().AsSlice())
+      .ToBuffer();
+}
+
 CHECKED_STATUS AbstractTablet::HandleQLReadRequest(
     MonoTime deadline,
     const ReadHybridTime& read_time,
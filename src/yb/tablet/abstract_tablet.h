@@ -14,10 +14,15 @@
 #ifndef YB_TABLET_ABSTRACT_TABLET_H
 #define YB_TABLET_ABSTRACT_TABLET_H
 
+#include <string>
+#include <vector>
+
 #include "yb/common/redis_protocol.pb.h"
 #include "yb/common/schema.h"
 #include "yb/common/ql_storage_interface.h"
 
+#include "yb/util/ref_cnt_buffer.h"
+
 #include "yb/tablet/tablet_fwd.h"
 
 namespace yb {
@@ -25,7 +30,8 @@ namespace tablet {
 
 struct QLReadRequestResult {
   QLResponsePB response;
-  faststring rows_data;
+  // Serialized rows, kept in chunks so they can be sent as an RPC sidecar without another copy.
+  RefCntBufferChain rows_data;
   HybridTime restart_read_ht;
 };
 
@@ -76,15 +82,24 @@ class AbstractTablet {
   //    consistent reads require a lease, while eventually consistent reads don't.
   // `min_allowed` - result should be greater or equal to `min_allowed`, otherwise
   //    this function tries to wait until the safe time reaches this value or `deadline` happens.
+  // `hashed_keys` - if specified, the result is only used to read documents with these hashed key
+  //    parts, so in-flight writes of other documents don't have to be waited for.
   //
   // Returns invalid hybrid time in case it cannot satisfy provided requirements, e.g. because of
   // a timeout.
   HybridTime SafeTime(RequireLease require_lease = RequireLease::kTrue,
                       HybridTime min_allowed = HybridTime::kMin,
-                      MonoTime deadline = MonoTime::kMax) const {
-    return DoGetSafeTime(require_lease, min_allowed, deadline);
+                      MonoTime deadline = MonoTime::kMax,
+                      const std::vector<std::string>* hashed_keys = nullptr) const {
+    return DoGetSafeTime(require_lease, min_allowed, deadline, hashed_keys);
   }
 
+  // Returns the hashed key part (see docdb::DocKey::EncodedHashedPart) of the documents read by the
+  // request, or an empty string if the request does not read a single hash key.
+  static std::string ReadHashedKey(const RedisReadRequestPB& redis_read_request);
+  std::string ReadHashedKey(const QLReadRequestPB& ql_read_request) const;
+  std::string ReadHashedKey(const PgsqlReadRequestPB& pgsql_read_request) const;
+
  protected:
   CHECKED_STATUS HandleQLReadRequest(
       MonoTime deadline,
@@ -115,7 +130,8 @@ class AbstractTablet {
                                         PgsqlReadRequestResult* result);
  private:
   virtual HybridTime DoGetSafeTime(
-      RequireLease require_lease, HybridTime min_allowed, MonoTime deadline) const = 0;
+      RequireLease require_lease, HybridTime min_allowed, MonoTime deadline,
+      const std::vector<std::string>* hashed_keys) const = 0;
 };
 
 }  // namespace tablet
@@ -115,7 +115,8 @@ class CompositePushdownTest : public YBTabletTest {
     ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, result.response.status())
         << "Error: " << result.response.error_message();
 
-    auto row_block = CreateRowBlock(QLClient::YQL_CLIENT_CQL, schema_, result.rows_data);
+    auto row_block = CreateRowBlock(
+        QLClient::YQL_CLIENT_CQL, schema_, result.rows_data.ToBuffer());
     for (const auto& row : row_block->rows()) {
       results->push_back(row.ToString());
     }
@@ -0,0 +1,123 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/hot_keys.h"
+
+#include "yb/docdb/doc_key.h"
+
+#include "yb/util/test_util.h"
+
+DECLARE_int32(hot_keys_sample_interval);
+DECLARE_int32(hot_keys_capacity);
+DECLARE_int32(hot_keys_decay_secs);
+
+namespace yb {
+namespace tablet {
+
+using docdb::DocKey;
+using docdb::PrimitiveValue;
+
+class HotKeysTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    FLAGS_hot_keys_sample_interval = 1;
+    FLAGS_hot_keys_capacity = 4;
+    FLAGS_hot_keys_decay_secs = 0;
+  }
+
+  static std::string HashedKey(int value) {
+    return DocKey(value, {PrimitiveValue::Int32(value)}).Encode().AsStringRef();
+  }
+
+  static std::string RangeKey(int value) {
+    return DocKey({PrimitiveValue::Int32(value)}).Encode().AsStringRef();
+  }
+
+  HotKeys hot_keys_{nullptr};
+};
+
+TEST_F(HotKeysTest, FindsHeavyHitters) {
+  // Two hot keys among many cold ones.
+  for (int i = 0; i != 1000; ++i) {
+    for (int j = 0; j != 3; ++j) {
+      hot_keys_.Record(HotKeys::AccessType::kRead, HashedKey(1));
+    }
+    for (int j = 0; j != 2; ++j) {
+      hot_keys_.Record(HotKeys::AccessType::kWrite, HashedKey(2));
+    }
+    hot_keys_.Record(HotKeys::AccessType::kWrite, HashedKey(100 + i));
+  }
+
+  ASSERT_EQ(6000, hot_keys_.TotalAccesses());
+  auto top = hot_keys_.TopKeys(2);
+  ASSERT_EQ(2, top.size());
+  ASSERT_EQ(HashedKey(1), top[0].key);
+  ASSERT_EQ(3000, top[0].reads);
+  ASSERT_EQ(HashedKey(2), top[1].key);
+  ASSERT_EQ(2000, top[1].writes);
+  for (const auto& stats : top) {
+    LOG(INFO) << stats.ToString();
+    // The hot keys were tracked since their first access, so their counts are exact.
+    ASSERT_EQ(0, stats.error);
+  }
+
+  ASSERT_EQ(4, hot_keys_.TopKeys(10).size());
+}
+
+TEST_F(HotKeysTest, KeysAreGroupedByHashedPart) {
+  // Accesses to different rows of the same hash key are attributed to the hash key.
+  for (int i = 0; i != 10; ++i) {
+    hot_keys_.Record(
+        HotKeys::AccessType::kRead,
+        DocKey(1, {PrimitiveValue::Int32(1)}, {PrimitiveValue::Int32(i)}).Encode().AsSlice());
+  }
+  hot_keys_.Record(HotKeys::AccessType::kWrite, RangeKey(5));
+
+  auto top = hot_keys_.TopKeys(10);
+  ASSERT_EQ(2, top.size());
+  ASSERT_EQ(HashedKey(1), top[0].key);
+  ASSERT_EQ(10, top[0].reads);
+  ASSERT_EQ(DocKey(1, {PrimitiveValue::Int32(1)}).ToString(), top[0].KeyToString());
+  ASSERT_EQ(RangeKey(5), top[1].key);
+  ASSERT_EQ(DocKey({PrimitiveValue::Int32(5)}).ToString(), top[1].KeyToString());
+}
+
+TEST_F(HotKeysTest, SampledAccessesAreWeighted) {
+  FLAGS_hot_keys_sample_interval = 10;
+  hot_keys_.Record(HotKeys::AccessType::kRead, HashedKey(1));
+  ASSERT_EQ(10, hot_keys_.TotalAccesses());
+  ASSERT_EQ(10, hot_keys_.TopKeys(1)[0].reads);
+}
+
+TEST_F(HotKeysTest, Decay) {
+  FLAGS_hot_keys_decay_secs = 1;
+  for (int i = 0; i != 8; ++i) {
+    hot_keys_.Record(HotKeys::AccessType::kRead, HashedKey(1));
+  }
+  hot_keys_.Record(HotKeys::AccessType::kRead, HashedKey(2));
+  SleepFor(MonoDelta::FromMilliseconds(1100));
+  hot_keys_.Record(HotKeys::AccessType::kWrite, HashedKey(3));
+
+  // Counts were halved before the last access, and the key that dropped to zero is forgotten.
+  auto top = hot_keys_.TopKeys(10);
+  ASSERT_EQ(2, top.size());
+  ASSERT_EQ(HashedKey(1), top[0].key);
+  ASSERT_EQ(4, top[0].reads);
+  ASSERT_EQ(HashedKey(3), top[1].key);
+  ASSERT_EQ(1, top[1].writes);
+  ASSERT_EQ(5, hot_keys_.TotalAccesses());
+}
+
+} // namespace tablet
+} // namespace yb
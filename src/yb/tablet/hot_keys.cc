@@ -0,0 +1,201 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/hot_keys.h"
+
+#include <algorithm>
+
+#include "yb/docdb/doc_key.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/random_util.h"
+
+DEFINE_int32(hot_keys_sample_interval, 100,
+             "One in this many reads and writes of a tablet, picked at random, is used to find the "
+             "most frequently accessed keys of the tablet. 0 to disable hot key detection.");
+TAG_FLAG(hot_keys_sample_interval, runtime);
+TAG_FLAG(hot_keys_sample_interval, advanced);
+
+DEFINE_int32(hot_keys_capacity, 32,
+             "Number of keys tracked per tablet by hot key detection. Every key that gets more "
+             "than a 1/capacity share of the accesses to the tablet is reported.");
+TAG_FLAG(hot_keys_capacity, runtime);
+TAG_FLAG(hot_keys_capacity, advanced);
+
+DEFINE_int32(hot_keys_decay_secs, 60,
+             "Access counts of the hot keys of a tablet are halved this often, so that they "
+             "reflect the recent load. 0 to never decay them.");
+TAG_FLAG(hot_keys_decay_secs, runtime);
+TAG_FLAG(hot_keys_decay_secs, advanced);
+
+METRIC_DEFINE_counter(tablet, hot_keys_sampled_accesses, "Hot Keys Sampled Accesses",
+                      yb::MetricUnit::kOperations,
+                      "Number of reads and writes sampled by hot key detection.");
+METRIC_DEFINE_gauge_uint64(tablet, hot_key_access_percentage, "Hottest Key Access Percentage",
+                           yb::MetricUnit::kUnits,
+                           "Estimated percentage of the recent reads and writes of the tablet "
+                           "that accessed its most frequently accessed key.");
+
+namespace yb {
+namespace tablet {
+
+std::string HotKeyStats::KeyToString() const {
+  docdb::DocKey doc_key;
+  Slice slice(key);
+  auto status = doc_key.DecodeFrom(&slice, docdb::DocKeyPart::HASHED_PART_ONLY);
+  if (status.ok() && doc_key.hashed_group().empty()) {
+    slice = key;
+    status = doc_key.DecodeFrom(&slice);
+  }
+  if (!status.ok()) {
+    return Slice(key).ToDebugHexString();
+  }
+  return doc_key.ToString();
+}
+
+std::string HotKeyStats::ToString() const {
+  return Format("{ key: $0 reads: $1 writes: $2 error: $3 }",
+                KeyToString(), reads, writes, error);
+}
+
+HotKeys::HotKeys(const scoped_refptr<MetricEntity>& metric_entity)
+    : last_decay_time_(MonoTime::Now()) {
+  if (metric_entity) {
+    sampled_accesses_ = METRIC_hot_keys_sampled_accesses.Instantiate(metric_entity);
+    top_key_access_percentage_ = METRIC_hot_key_access_percentage.Instantiate(metric_entity, 0);
+  }
+}
+
+bool HotKeys::ShouldSample() {
+  const auto sample_interval = FLAGS_hot_keys_sample_interval;
+  return sample_interval > 0 && RandomWithChance(sample_interval);
+}
+
+void HotKeys::Record(AccessType type, const Slice& encoded_doc_key) {
+  if (sampled_accesses_) {
+    sampled_accesses_->Increment();
+  }
+
+  // Every sampled access stands for sample_interval accesses.
+  const uint64_t weight = std::max(FLAGS_hot_keys_sample_interval, 1);
+  const size_t capacity = std::max(FLAGS_hot_keys_capacity, 1);
+  // Tables without hash columns are tracked by the whole key.
+  Slice hashed_part = docdb::DocKey::EncodedHashedPart(encoded_doc_key);
+  std::string key = (hashed_part.empty() ? encoded_doc_key : hashed_part).ToBuffer();
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  DecayIfNeeded(MonoTime::Now());
+
+  size_t idx;
+  auto it = counter_index_.find(key);
+  if (it != counter_index_.end()) {
+    idx = it->second;
+  } else if (counters_.size() < capacity) {
+    idx = counters_.size();
+    counters_.emplace_back();
+    counters_.back().key = key;
+    counter_index_.emplace(std::move(key), idx);
+  } else {
+    // Space-Saving: the new key takes over the counter of the least accessed key, and inherits its
+    // count as the error of its own.
+    idx = MinCounterIndex();
+    auto& counter = counters_[idx];
+    counter_index_.erase(counter.key);
+    counter.key = key;
+    counter.error = counter.accesses();
+    // The inherited count is attributed to the type of the first access.
+    if (type == AccessType::kRead) {
+      counter.reads = counter.error;
+      counter.writes = 0;
+    } else {
+      counter.reads = 0;
+      counter.writes = counter.error;
+    }
+    counter_index_.emplace(std::move(key), idx);
+  }
+
+  auto& counter = counters_[idx];
+  if (type == AccessType::kRead) {
+    counter.reads += weight;
+  } else {
+    counter.writes += weight;
+  }
+  total_accesses_ += weight;
+
+  if (top_key_access_percentage_) {
+    uint64_t max_accesses = 0;
+    for (const auto& stats : counters_) {
+      max_accesses = std::max(max_accesses, stats.accesses() - stats.error);
+    }
+    top_key_access_percentage_->set_value(max_accesses * 100 / total_accesses_);
+  }
+}
+
+size_t HotKeys::MinCounterIndex() const {
+  size_t result = 0;
+  for (size_t i = 1; i < counters_.size(); ++i) {
+    if (counters_[i].accesses() < counters_[result].accesses()) {
+      result = i;
+    }
+  }
+  return result;
+}
+
+void HotKeys::DecayIfNeeded(MonoTime now) {
+  const auto decay_secs = FLAGS_hot_keys_decay_secs;
+  if (decay_secs <= 0 || now.GetDeltaSince(last_decay_time_).ToSeconds() < decay_secs) {
+    return;
+  }
+  last_decay_time_ = now;
+
+  total_accesses_ /= 2;
+  std::vector<HotKeyStats> decayed;
+  decayed.reserve(counters_.size());
+  for (auto& counter : counters_) {
+    counter.reads /= 2;
+    counter.writes /= 2;
+    counter.error /= 2;
+    if (counter.accesses() != 0) {
+      decayed.push_back(std::move(counter));
+    }
+  }
+  counters_.swap(decayed);
+  counter_index_.clear();
+  for (size_t i = 0; i != counters_.size(); ++i) {
+    counter_index_.emplace(counters_[i].key, i);
+  }
+}
+
+std::vector<HotKeyStats> HotKeys::TopKeys(size_t limit) const {
+  std::vector<HotKeyStats> result;
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    result = counters_;
+  }
+  std::sort(result.begin(), result.end(), [](const HotKeyStats& lhs, const HotKeyStats& rhs) {
+    return lhs.accesses() > rhs.accesses();
+  });
+  if (result.size() > limit) {
+    result.resize(limit);
+  }
+  return result;
+}
+
+uint64_t HotKeys::TotalAccesses() const {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  return total_accesses_;
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,102 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_HOT_KEYS_H
+#define YB_TABLET_HOT_KEYS_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/locks.h"
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace tablet {
+
+// Estimated recent access counts of a partition key of a tablet.
+struct HotKeyStats {
+  // The hashed part of the encoded document key, or the whole encoded document key for tables
+  // without hash columns.
+  std::string key;
+
+  // Estimated number of reads and writes of the key.
+  uint64_t reads = 0;
+  uint64_t writes = 0;
+
+  // Upper bound of the overestimation of reads + writes.
+  uint64_t error = 0;
+
+  uint64_t accesses() const { return reads + writes; }
+
+  // Human-readable form of the key.
+  std::string KeyToString() const;
+
+  std::string ToString() const;
+};
+
+// Finds the most frequently accessed partition keys of a tablet.
+//
+// One in --hot_keys_sample_interval reads and writes, picked at random, feeds a Space-Saving heavy
+// hitters sketch with --hot_keys_capacity counters, so the rest of the operations only pay for a
+// random number. Every key accessed more often than a 1/capacity share of all the accesses is in
+// the sketch, and its count is overestimated by at most the reported error. The counts are halved
+// every --hot_keys_decay_secs, so the sketch reflects the recent load of the tablet.
+class HotKeys {
+ public:
+  enum class AccessType {
+    kRead,
+    kWrite,
+  };
+
+  explicit HotKeys(const scoped_refptr<MetricEntity>& metric_entity);
+
+  // Returns true if the current access should be recorded.
+  static bool ShouldSample();
+
+  // Records a sampled access to the given key. encoded_doc_key is an encoded document key or a
+  // prefix of it that contains the whole hashed part.
+  void Record(AccessType type, const Slice& encoded_doc_key);
+
+  // Returns up to limit most accessed keys, the most accessed first.
+  std::vector<HotKeyStats> TopKeys(size_t limit) const;
+
+  // Estimated number of recent accesses to all the keys of the tablet.
+  uint64_t TotalAccesses() const;
+
+ private:
+  void DecayIfNeeded(MonoTime now);
+
+  size_t MinCounterIndex() const;
+
+  mutable simple_spinlock lock_;
+  std::vector<HotKeyStats> counters_;
+  // Index of the counter of every key in counters_.
+  std::unordered_map<std::string, size_t> counter_index_;
+  uint64_t total_accesses_ = 0;
+  MonoTime last_decay_time_;
+
+  scoped_refptr<Counter> sampled_accesses_;
+  scoped_refptr<AtomicGauge<uint64_t>> top_key_access_percentage_;
+
+  DISALLOW_COPY_AND_ASSIGN(HotKeys);
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_HOT_KEYS_H
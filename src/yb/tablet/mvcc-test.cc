@@ -128,6 +128,36 @@ TEST_F(MvccTest, Abort) {
   ASSERT_EQ(now, manager_.SafeTime(now));
 }
 
+TEST_F(MvccTest, SafeTimeForHashedKeys) {
+  auto safe_time_for = [this](const std::string& hashed_key) {
+    return manager_.SafeTimeForHashedKeys(
+        {hashed_key}, HybridTime::kMin, MonoTime::kMax, HybridTime::kMax);
+  };
+
+  HybridTime ht1;
+  manager_.AddPending(&ht1, {"a"});
+  HybridTime ht2;
+  manager_.AddPending(&ht2, {"b"});
+  ASSERT_EQ(ht1.Decremented(), safe_time_for("a"));
+  ASSERT_EQ(ht2.Decremented(), safe_time_for("b"));
+  // Reads of other keys don't wait for the pending operations.
+  ASSERT_GT(safe_time_for("c"), ht2);
+  ASSERT_EQ(ht1.Decremented(), manager_.SafeTime());
+
+  // Operation that could write any key.
+  HybridTime ht3;
+  manager_.AddPending(&ht3);
+  ASSERT_EQ(ht3.Decremented(), safe_time_for("c"));
+
+  manager_.Aborted(ht2);
+  ASSERT_EQ(ht3.Decremented(), safe_time_for("b"));
+
+  manager_.Replicated(ht1);
+  ASSERT_EQ(ht3.Decremented(), safe_time_for("a"));
+  manager_.Replicated(ht3);
+  ASSERT_GT(safe_time_for("a"), ht3);
+}
+
 void MvccTest::RunRandomizedTest(bool use_ht_lease) {
   constexpr size_t kTotalOperations = 20000;
   enum class Op { kAdd, kReplicated, kAborted };
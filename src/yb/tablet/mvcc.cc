@@ -78,13 +78,15 @@ void MvccManager::Aborted(HybridTime ht) {
       PopFront(&lock);
     } else {
       aborted_.push(ht);
-      return;
+      // Readers of the documents written by the aborted operation don't have to wait for it.
+      RemovePendingHashedKeys(ht);
     }
   }
   cond_.notify_all();
 }
 
 void MvccManager::PopFront(std::lock_guard<std::mutex>* lock) {
+  RemovePendingHashedKeys(queue_.front());
   queue_.pop_front();
   CHECK_GE(queue_.size(), aborted_.size()) << LogPrefix();
   while (!aborted_.empty()) {
@@ -92,12 +94,33 @@ void MvccManager::PopFront(std::lock_guard<std::mutex>* lock) {
       CHECK_LT(queue_.front(), aborted_.top()) << LogPrefix();
       break;
     }
+    RemovePendingHashedKeys(queue_.front());
     queue_.pop_front();
     aborted_.pop();
   }
 }
 
+void MvccManager::RemovePendingHashedKeys(HybridTime ht) {
+  auto it = pending_operation_hashed_keys_.find(ht);
+  if (it == pending_operation_hashed_keys_.end()) {
+    return;
+  }
+  for (const auto& hashed_key : it->second) {
+    auto key_it = pending_hashed_keys_.find(hashed_key);
+    DCHECK(key_it != pending_hashed_keys_.end()) << LogPrefix();
+    key_it->second.erase(ht);
+    if (key_it->second.empty()) {
+      pending_hashed_keys_.erase(key_it);
+    }
+  }
+  pending_operation_hashed_keys_.erase(it);
+}
+
 void MvccManager::AddPending(HybridTime* ht) {
+  AddPending(ht, {std::string()});
+}
+
+void MvccManager::AddPending(HybridTime* ht, std::vector<std::string> hashed_keys) {
   const bool is_follower_side = ht->is_valid();
   std::lock_guard<std::mutex> lock(mutex_);
   if (is_follower_side) {
@@ -123,6 +146,7 @@ void MvccManager::AddPending(HybridTime* ht) {
 
     auto start_iter = iter;
     while (iter != queue_.end() && *iter == aborted_.top()) {
+      RemovePendingHashedKeys(*iter);
       aborted_.pop();
       iter++;
     }
@@ -188,6 +212,10 @@ void MvccManager::AddPending(HybridTime* ht) {
     }
   }
   queue_.push_back(*ht);
+  for (const auto& hashed_key : hashed_keys) {
+    pending_hashed_keys_[hashed_key].insert(*ht);
+  }
+  pending_operation_hashed_keys_.emplace(*ht, std::move(hashed_keys));
 }
 
 void MvccManager::SetLastReplicated(HybridTime ht) {
@@ -344,6 +372,52 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
   return result;
 }
 
+HybridTime MvccManager::SafeTimeForHashedKeys(
+    const std::vector<std::string>& hashed_keys, HybridTime min_allowed, MonoTime deadline,
+    HybridTime ht_lease) const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  CHECK(ht_lease.is_valid());
+  CHECK_LE(min_allowed, ht_lease) << LogPrefix();
+
+  bool has_lease = false;
+  if (ht_lease.GetPhysicalValueMicros() < kMaxHybridTimePhysicalMicros) {
+    max_ht_lease_seen_ = std::max(ht_lease, max_ht_lease_seen_);
+    has_lease = true;
+  }
+
+  HybridTime result;
+  auto limit_by_pending = [this, &result](const std::string& hashed_key) {
+    auto it = pending_hashed_keys_.find(hashed_key);
+    if (it != pending_hashed_keys_.end()) {
+      result = std::min(result, it->second.begin()->Decremented());
+    }
+  };
+  auto predicate = [this, &result, &hashed_keys, &limit_by_pending, min_allowed, has_lease] {
+    // Operations that are added after this call get hybrid time higher than the current one, so
+    // only the pending operations that write the same documents, or any document, limit the result.
+    result = clock_->Now();
+    limit_by_pending(std::string());
+    for (const auto& hashed_key : hashed_keys) {
+      limit_by_pending(hashed_key);
+    }
+
+    if (has_lease && result > max_ht_lease_seen_) {
+      result = max_ht_lease_seen_;
+    }
+    result = std::max(result, last_replicated_);
+    return result >= min_allowed;
+  };
+
+  if (deadline == MonoTime::kMax) {
+    cond_.wait(lock, predicate);
+  } else if (!cond_.wait_until(lock, deadline.ToSteadyTimePoint(), predicate)) {
+    return HybridTime::kInvalid;
+  }
+  VLOG_WITH_PREFIX(1) << "SafeTimeForHashedKeys(" << min_allowed << ", " << ht_lease
+                      << "), result = " << result;
+  return result;
+}
+
 HybridTime MvccManager::LastReplicatedHybridTime() const {
   std::lock_guard<std::mutex> lock(mutex_);
   VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << last_replicated_;
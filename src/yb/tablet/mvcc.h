@@ -35,7 +35,11 @@
 #include <condition_variable>
 #include <mutex>
 #include <deque>
+#include <map>
 #include <queue>
+#include <set>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "yb/server/clock.h"
@@ -90,6 +94,11 @@ class MvccManager {
   // OpId is being passed for the ease of debugging.
   void AddPending(HybridTime* ht);
 
+  // Same as above, but the operation writes only documents whose hashed key parts (see
+  // DocKey::EncodedHashedPart) are listed in `hashed_keys`. An empty hashed key stands for any
+  // document. SafeTimeForHashedKeys does not wait for such an operation to read other documents.
+  void AddPending(HybridTime* ht, std::vector<std::string> hashed_keys);
+
   // Notifies that operation with appropriate time was replicated.
   // It should be first operation in queue.
   void Replicated(HybridTime ht);
@@ -125,6 +134,13 @@ class MvccManager {
 
   HybridTime SafeTimeForFollower(HybridTime min_allowed, MonoTime deadline) const;
 
+  // Same as SafeTime, but the result is only safe to read documents with the given hashed key
+  // parts. Pending operations that write only other documents are not waited for, so the result
+  // could be higher than SafeTime and is not taken into account by it.
+  HybridTime SafeTimeForHashedKeys(
+      const std::vector<std::string>& hashed_keys, HybridTime min_allowed, MonoTime deadline,
+      HybridTime ht_lease) const;
+
   // Returns time of last replicated operation.
   HybridTime LastReplicatedHybridTime() const;
 
@@ -137,6 +153,9 @@ class MvccManager {
   const std::string& LogPrefix() const { return prefix_; }
   void PopFront(std::lock_guard<std::mutex>* lock);
 
+  // Forgets hashed keys of the pending operation with the given hybrid time.
+  void RemovePendingHashedKeys(HybridTime ht);
+
   std::string prefix_;
   server::ClockPtr clock_;
   mutable std::mutex mutex_;
@@ -149,6 +168,12 @@ class MvccManager {
   // Required because we could abort operations from the middle of the queue.
   std::priority_queue<HybridTime, std::vector<HybridTime>, std::greater<>> aborted_;
 
+  // Hybrid times of pending operations by hashed keys of the documents they write.
+  std::unordered_map<std::string, std::set<HybridTime>> pending_hashed_keys_;
+
+  // Hashed keys written by every pending operation.
+  std::map<HybridTime, std::vector<std::string>> pending_operation_hashed_keys_;
+
   HybridTime last_replicated_ = HybridTime::kMin;
 
   // If we are a follower, this is the latest safe time sent by the leader to us. If we are the
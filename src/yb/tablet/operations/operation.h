@@ -33,6 +33,7 @@
 #ifndef YB_TABLET_OPERATIONS_OPERATION_H
 #define YB_TABLET_OPERATIONS_OPERATION_H
 
+#include <functional>
 #include <mutex>
 #include <string>
 
@@ -107,6 +108,11 @@ class Operation {
   // transaction type, but usually this is the method where data-structures are changed.
   virtual CHECKED_STATUS Apply() = 0;
 
+  // Executes the Apply() phase as part of the tablet's current apply group, if the operation
+  // supports that. Returns false if the operation was not added to a group and should be applied
+  // with Apply(). Otherwise on_written is invoked once the changes of the operation are written.
+  virtual bool ApplyInGroup(std::function<void()> on_written) { return false; }
+
   // Executed after Apply() but before the commit is submitted to consensus.  Some transactions use
   // this to perform pre-commit actions (e.g. write transactions perform early lock release on this
   // hook).  Default implementation does nothing.
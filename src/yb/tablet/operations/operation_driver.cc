@@ -423,6 +423,21 @@ void OperationDriver::ApplyTask() {
   scoped_refptr<OperationDriver> ref(this);
 
   {
+    // Grouped operations are pre-committed and finalized only when their writes are in RocksDB,
+    // so locks are not released and the client is not answered before that.
+    if (operation_->ApplyInGroup([this, ref] {
+          operation_->PreCommit();
+          Finalize();
+        })) {
+      return;
+    }
+
+    // Make the writes grouped so far visible to this operation.
+    auto* tablet = operation_->state()->tablet();
+    if (tablet) {
+      tablet->FlushApplyGroup();
+    }
+
     CHECK_OK(operation_->Apply());
 
     operation_->PreCommit();
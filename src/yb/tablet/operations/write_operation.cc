@@ -92,18 +92,26 @@ void WriteOperation::DoStart() {
   state()->tablet()->StartOperation(state());
 }
 
-// FIXME: Since this is called as a void in a thread-pool callback,
-// it seems pointless to return a Status!
-Status WriteOperation::Apply() {
-  TRACE_EVENT0("txn", "WriteOperation::Apply");
-  TRACE("APPLY: Starting");
+namespace {
 
+void InjectApplyLatency() {
   if (PREDICT_FALSE(
           ANNOTATE_UNPROTECTED_READ(FLAGS_tablet_inject_latency_on_apply_write_txn_ms) > 0)) {
     TRACE("Injecting $0ms of latency due to --tablet_inject_latency_on_apply_write_txn_ms",
           FLAGS_tablet_inject_latency_on_apply_write_txn_ms);
     SleepFor(MonoDelta::FromMilliseconds(FLAGS_tablet_inject_latency_on_apply_write_txn_ms));
   }
+}
+
+} // namespace
+
+// FIXME: Since this is called as a void in a thread-pool callback,
+// it seems pointless to return a Status!
+Status WriteOperation::Apply() {
+  TRACE_EVENT0("txn", "WriteOperation::Apply");
+  TRACE("APPLY: Starting");
+
+  InjectApplyLatency();
 
   Tablet* tablet = state()->tablet();
 
@@ -112,6 +120,18 @@ Status WriteOperation::Apply() {
   return Status::OK();
 }
 
+bool WriteOperation::ApplyInGroup(std::function<void()> on_written) {
+  TRACE_EVENT0("txn", "WriteOperation::ApplyInGroup");
+  if (!tablet()->ApplyRowOperationsInGroup(state(), std::move(on_written))) {
+    return false;
+  }
+  TRACE("APPLY: Added to apply group");
+
+  // Grouped writes reach RocksDB only when the group is written, so the latency delays that.
+  InjectApplyLatency();
+  return true;
+}
+
 void WriteOperation::PreCommit() {
   TRACE_EVENT0("txn", "WriteOperation::PreCommit");
   TRACE("PRECOMMIT: Releasing row and schema locks");
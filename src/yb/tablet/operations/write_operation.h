@@ -223,6 +223,9 @@ class WriteOperation : public Operation {
   // algorithm.
   CHECKED_STATUS Apply() override;
 
+  // Adds the writes of this operation to the tablet's apply group.
+  bool ApplyInGroup(std::function<void()> on_written) override;
+
   // Releases the row locks (Early Lock Release).
   void PreCommit() override;
 
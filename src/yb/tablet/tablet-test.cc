@@ -35,6 +35,7 @@
 #include <glog/logging.h>
 
 #include "yb/common/row.h"
+#include "yb/common/ql_protocol_util.h"
 #include "yb/common/ql_rowwise_iterator_interface.h"
 
 #include "yb/gutil/stl_util.h"
@@ -43,6 +44,7 @@
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet-test-base.h"
 #include "yb/util/slice.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_macros.h"
 
 // Include client header so we can access YBTableType.
@@ -53,6 +55,8 @@
 using std::shared_ptr;
 using std::unordered_set;
 
+DECLARE_bool(leader_read_safe_time_per_key);
+
 namespace yb {
 namespace tablet {
 
@@ -214,5 +218,139 @@ TYPED_TEST(TestTablet, TestFlushedOpId) {
   ASSERT_EQ(id.index, start_index + 2*kCount);
 }
 
+namespace {
+
+struct PendingWrite {
+  tserver::WriteRequestPB request;
+  tserver::WriteResponsePB response;
+  std::unique_ptr<WriteOperationState> state;
+};
+
+} // namespace
+
+// Applies small single row writes either one by one, or through apply groups of the size that
+// the tablet preparer uses for replication batches, and reports the throughput of both.
+TYPED_TEST(TestTablet, ApplyGroupPerformance) {
+  constexpr int64_t kOpsPerGroup = 16;
+  const int64_t num_ops = this->ClampRowCount(FLAGS_testiterator_num_inserts * 10);
+  auto* tablet = this->tablet().get();
+  int64_t op_index = 0;
+
+  for (bool grouped : {false, true}) {
+    const auto groups_written_before = tablet->TEST_apply_groups_written();
+    size_t callbacks_invoked = 0;
+    Stopwatch sw;
+    sw.start();
+    for (int64_t first_key = 0; first_key < num_ops; first_key += kOpsPerGroup) {
+      std::vector<std::unique_ptr<PendingWrite>> writes;
+      for (int64_t key = first_key; key < std::min(first_key + kOpsPerGroup, num_ops); ++key) {
+        auto write = std::make_unique<PendingWrite>();
+        auto* req = write->request.add_ql_write_batch();
+        req->set_type(QLWriteRequestPB::QL_STMT_INSERT);
+        this->setup_.BuildRow(req, key, grouped ? 1 : 0);
+        req->set_schema_version(tablet->metadata()->schema_version());
+        QLSetHashCode(req);
+        write->state = std::make_unique<WriteOperationState>(
+            tablet, &write->request, &write->response);
+        HybridTime read_ht;
+        ASSERT_OK(tablet->AcquireLocksAndPerformDocOperations(
+            MonoTime::Max(), write->state.get(), &read_ht));
+        tablet->StartOperation(write->state.get());
+        write->state->mutable_op_id()->set_term(0);
+        write->state->mutable_op_id()->set_index(++op_index);
+        writes.push_back(std::move(write));
+      }
+
+      if (grouped) {
+        const size_t callbacks_before = callbacks_invoked;
+        tablet->StartApplyGroup();
+        for (const auto& write : writes) {
+          auto* state = write->state.get();
+          ASSERT_TRUE(tablet->ApplyRowOperationsInGroup(state, [state, tablet, &callbacks_invoked] {
+            ++callbacks_invoked;
+            state->Commit();
+            state->ReleaseDocDbLocks(tablet);
+          }));
+        }
+        // Operations are finished only when the whole group is written.
+        ASSERT_EQ(callbacks_before, callbacks_invoked);
+        tablet->FinishApplyGroup();
+        ASSERT_EQ(callbacks_before + writes.size(), callbacks_invoked);
+      } else {
+        for (const auto& write : writes) {
+          tablet->ApplyRowOperations(write->state.get());
+          write->state->Commit();
+          write->state->ReleaseDocDbLocks(tablet);
+        }
+      }
+    }
+    sw.stop();
+
+    LOG(INFO) << (grouped ? "Grouped" : "Ungrouped") << " apply of " << num_ops << " writes: "
+              << num_ops / sw.elapsed().wall_seconds() << " writes/sec";
+
+    // Each group should be written to RocksDB with a single write.
+    const int64_t expected_groups = grouped ? (num_ops + kOpsPerGroup - 1) / kOpsPerGroup : 0;
+    ASSERT_EQ(expected_groups, tablet->TEST_apply_groups_written() - groups_written_before);
+  }
+
+  vector<string> rows;
+  ASSERT_OK(this->IterateToStringList(&rows));
+  ASSERT_EQ(num_ops, rows.size());
+}
+
+// A strongly consistent read of a single hash key does not wait for an in-flight write of another
+// key, while a read of the written key, or of the whole tablet, does.
+TYPED_TEST(TestTablet, ReadOfOtherKeyNotBlockedByPendingWrite) {
+  FLAGS_leader_read_safe_time_per_key = true;
+  auto* tablet = this->tablet().get();
+  auto hashed_keys = [this, tablet](int64_t key) {
+    QLWriteRequestPB write_req;
+    this->setup_.BuildRowKey(&write_req, key);
+    QLSetHashCode(&write_req);
+    QLReadRequestPB read_req;
+    *read_req.mutable_hashed_column_values() = write_req.hashed_column_values();
+    read_req.set_hash_code(write_req.hash_code());
+    return std::vector<std::string>{tablet->ReadHashedKey(read_req)};
+  };
+
+  PendingWrite write;
+  auto* req = write.request.add_ql_write_batch();
+  req->set_type(QLWriteRequestPB::QL_STMT_INSERT);
+  this->setup_.BuildRow(req, 1);
+  req->set_schema_version(tablet->metadata()->schema_version());
+  QLSetHashCode(req);
+  write.state = std::make_unique<WriteOperationState>(tablet, &write.request, &write.response);
+  HybridTime read_ht;
+  ASSERT_OK(tablet->AcquireLocksAndPerformDocOperations(
+      MonoTime::Max(), write.state.get(), &read_ht));
+  tablet->StartOperation(write.state.get());
+  const HybridTime write_ht = write.state->hybrid_time();
+
+  const auto written_key = hashed_keys(1);
+  const auto other_key = hashed_keys(2);
+  ASSERT_FALSE(other_key.front().empty());
+  ASSERT_NE(written_key, other_key);
+  const auto timeout = MonoDelta::FromMilliseconds(100);
+  auto safe_time = [tablet, write_ht, timeout](const std::vector<std::string>* keys) {
+    return tablet->SafeTime(
+        RequireLease::kTrue, write_ht /* min_allowed */, MonoTime::Now() + timeout, keys);
+  };
+
+  // Reading at the hybrid time of the write is only safe for the other key.
+  ASSERT_GE(safe_time(&other_key), write_ht);
+  ASSERT_FALSE(safe_time(&written_key).is_valid());
+  ASSERT_FALSE(safe_time(nullptr).is_valid());
+
+  write.state->mutable_op_id()->set_term(0);
+  write.state->mutable_op_id()->set_index(1);
+  tablet->ApplyRowOperations(write.state.get());
+  write.state->Commit();
+  write.state->ReleaseDocDbLocks(tablet);
+
+  ASSERT_GE(safe_time(&written_key), write_ht);
+  ASSERT_GE(safe_time(nullptr), write_ht);
+}
+
 } // namespace tablet
 } // namespace yb
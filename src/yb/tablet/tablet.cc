@@ -70,6 +70,7 @@
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_compaction_filter.h"
+#include "yb/docdb/docdb_util.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
 #include "yb/docdb/primitive_value.h"
@@ -136,6 +137,25 @@ DEFINE_int32(intents_flush_max_delay_ms, 2000,
              "Max time to wait for regular db to flush during flush of intents. "
              "After this time flush of regular db will be forced.");
 
+DEFINE_bool(tablet_group_apply_writes, true,
+            "Whether consecutively committed non-transactional write operations should be written "
+            "to RocksDB with a single write batch.");
+TAG_FLAG(tablet_group_apply_writes, advanced);
+
+DEFINE_bool(tablet_compaction_drop_keys_out_of_partition, false,
+            "Whether compactions of a hash partitioned tablet drop the keys that are outside of "
+            "its partition, e.g. the data of the other half of a split tablet. Only safe when "
+            "every tablet of the table was created from its current partition.");
+TAG_FLAG(tablet_compaction_drop_keys_out_of_partition, unsafe);
+TAG_FLAG(tablet_compaction_drop_keys_out_of_partition, advanced);
+
+DEFINE_bool(leader_read_safe_time_per_key, false,
+            "Whether strongly consistent reads of single hash keys on the leader pick the read time "
+            "from the hybrid time leader lease and the in-flight writes of the same keys only, "
+            "instead of waiting for all the in-flight writes to the tablet.");
+TAG_FLAG(leader_read_safe_time_per_key, runtime);
+TAG_FLAG(leader_read_safe_time_per_key, advanced);
+
 using namespace std::placeholders;
 
 using std::shared_ptr;
@@ -324,6 +344,17 @@ Tablet::Tablet(
       local_tablet_filter_(std::move(local_tablet_filter)) {
   CHECK(schema()->has_column_ids());
 
+  // Only the document keys of hash partitioned tables start with the hash that the partition keys
+  // consist of. Tablets do not record whether they were split yet, so dropping keys out of the
+  // partition is off unless explicitly enabled.
+  const auto& partition = metadata_->partition();
+  if (FLAGS_tablet_compaction_drop_keys_out_of_partition &&
+      metadata_->partition_schema().IsHashPartitioning() &&
+      metadata_->schema().num_hash_key_columns() > 0) {
+    key_bounds_ = docdb::KeyBounds::FromHashPartition(
+        partition.partition_key_start(), partition.partition_key_end());
+  }
+
   if (metric_registry) {
     MetricEntity::AttributeMap attrs;
     // TODO(KUDU-745): table_id is apparently not set in the metadata.
@@ -350,10 +381,13 @@ Tablet::Tablet(
 
     metrics_.reset(new TabletMetrics(metric_entity_));
   }
+  hot_keys_ = std::make_unique<HotKeys>(metric_entity_);
 
   if (transaction_participant_context && metadata->schema().table_properties().is_transactional()) {
     transaction_participant_ = std::make_unique<TransactionParticipant>(
-        transaction_participant_context);
+        transaction_participant_context,
+        metrics_ ? metrics_->transaction_status_batch_size.get() : nullptr,
+        metrics_ ? metrics_->transaction_status_resolution_latency.get() : nullptr);
     // Create transaction manager for secondary index update.
     if (!metadata_->index_map().empty()) {
       transaction_manager_.emplace(transaction_participant_context->client_future().get(),
@@ -466,11 +500,14 @@ Result<bool> Tablet::IntentsDbFlushFilter(const rocksdb::MemTable& memtable) {
 Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options rocksdb_options;
   docdb::InitRocksDBOptions(&rocksdb_options, tablet_id(), rocksdb_statistics_, tablet_options_);
+  docdb::SetCompressionFromTableProperties(
+      &rocksdb_options, metadata()->schema().table_properties());
 
   // Install the history cleanup handler. Note that TabletRetentionPolicy is going to hold a raw ptr
   // to this tablet. So, we ensure that rocksdb_ is reset before this tablet gets destroyed.
   rocksdb_options.compaction_filter_factory = make_shared<DocDBCompactionFilterFactory>(
-      make_shared<TabletRetentionPolicy>(this));
+      make_shared<TabletRetentionPolicy>(this),
+      key_bounds_.IsInitialized() ? &key_bounds_ : nullptr);
 
   rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
     if (mem_table_flush_filter_factory_) {
@@ -578,12 +615,44 @@ Result<std::unique_ptr<common::YQLRowwiseIteratorIf>> Tablet::NewRowIterator(
   return std::move(result);
 }
 
+namespace {
+
+const KeyValueWriteBatchPB& KeyValueWriteBatchOf(WriteOperationState* operation_state) {
+  return operation_state->consensus_round() && operation_state->consensus_round()->replicate_msg()
+      // Online case.
+      ? operation_state->consensus_round()->replicate_msg()->write_request().write_batch()
+      // Bootstrap case.
+      : operation_state->request()->write_batch();
+}
+
+// Returns hashed key parts of the documents written by the batch, see MvccManager::AddPending.
+std::vector<std::string> WrittenHashedKeys(const KeyValueWriteBatchPB& write_batch) {
+  std::vector<std::string> result;
+  for (const auto& kv_pair : write_batch.kv_pairs()) {
+    Slice hashed_part = docdb::DocKey::EncodedHashedPart(kv_pair.key());
+    if (hashed_part.empty()) {
+      // Documents without hash are not tracked separately.
+      return {std::string()};
+    }
+    result.push_back(hashed_part.ToBuffer());
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+} // namespace
+
 void Tablet::StartOperation(WriteOperationState* operation_state) {
   // If the state already has a hybrid_time then we're replaying a transaction that occurred
   // before a crash or at another node.
   HybridTime ht = operation_state->hybrid_time_even_if_unset();
   bool was_valid = ht.is_valid();
-  mvcc_.AddPending(&ht);
+  if (FLAGS_leader_read_safe_time_per_key) {
+    mvcc_.AddPending(&ht, WrittenHashedKeys(KeyValueWriteBatchOf(operation_state)));
+  } else {
+    mvcc_.AddPending(&ht);
+  }
   if (!was_valid) {
     operation_state->set_hybrid_time(ht);
   }
@@ -591,12 +660,7 @@ void Tablet::StartOperation(WriteOperationState* operation_state) {
 
 void Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
   last_committed_write_index_.store(operation_state->op_id().index(), std::memory_order_release);
-  const KeyValueWriteBatchPB& put_batch =
-      operation_state->consensus_round() && operation_state->consensus_round()->replicate_msg()
-          // Online case.
-          ? operation_state->consensus_round()->replicate_msg()->write_request().write_batch()
-          // Bootstrap case.
-          : operation_state->request()->write_batch();
+  const KeyValueWriteBatchPB& put_batch = KeyValueWriteBatchOf(operation_state);
 
   docdb::ConsensusFrontiers frontiers;
   set_op_id({operation_state->op_id().term(), operation_state->op_id().index()}, &frontiers);
@@ -696,6 +760,85 @@ void Tablet::WriteBatch(const rocksdb::UserFrontiers* frontiers,
   }
 }
 
+void Tablet::StartApplyGroup() {
+  if (!FLAGS_tablet_group_apply_writes) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(apply_group_mutex_);
+  DCHECK(!apply_group_.active);
+  apply_group_.active = true;
+}
+
+void Tablet::FinishApplyGroup() {
+  std::unique_lock<std::mutex> lock(apply_group_mutex_);
+  if (!apply_group_.active) {
+    return;
+  }
+  apply_group_.active = false;
+  FlushApplyGroupAndUnlock(&lock);
+}
+
+void Tablet::FlushApplyGroup() {
+  std::unique_lock<std::mutex> lock(apply_group_mutex_);
+  FlushApplyGroupAndUnlock(&lock);
+}
+
+void Tablet::FlushApplyGroupAndUnlock(std::unique_lock<std::mutex>* lock) {
+  if (apply_group_.on_written.empty()) {
+    return;
+  }
+
+  VLOG(3) << tablet_id() << ": Writing apply group of " << apply_group_.on_written.size()
+          << " operations, " << apply_group_.write_batch.Count() << " entries";
+  // The oldest write of the group is the one the memstore has to be flushed for.
+  WriteBatch(&apply_group_.frontiers, apply_group_.frontiers.Smallest().hybrid_time(),
+             &apply_group_.write_batch, regular_db_.get());
+  apply_group_.write_batch.Clear();
+  apply_group_.frontiers = docdb::ConsensusFrontiers();
+  apply_groups_written_.fetch_add(1, std::memory_order_relaxed);
+
+  // Callbacks finish the operations, so they are invoked outside of apply_group_mutex_, not to
+  // block adding of next operations to the group. Callbacks mutex is acquired before
+  // apply_group_mutex_ is released, so grouped operations still finish in the order they were
+  // applied, even if another thread writes the next group.
+  auto on_written = std::move(apply_group_.on_written);
+  apply_group_.on_written.clear();
+  std::lock_guard<std::mutex> callbacks_lock(apply_group_callbacks_mutex_);
+  lock->unlock();
+  for (const auto& callback : on_written) {
+    callback();
+  }
+}
+
+bool Tablet::ApplyRowOperationsInGroup(WriteOperationState* operation_state,
+                                       std::function<void()> on_written) {
+  const KeyValueWriteBatchPB& put_batch = KeyValueWriteBatchOf(operation_state);
+  if (put_batch.has_transaction()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(apply_group_mutex_);
+  if (!apply_group_.active) {
+    return false;
+  }
+
+  last_committed_write_index_.store(operation_state->op_id().index(), std::memory_order_release);
+  const yb::OpId op_id(operation_state->op_id().term(), operation_state->op_id().index());
+  const HybridTime hybrid_time = operation_state->hybrid_time();
+  if (apply_group_.on_written.empty()) {
+    apply_group_.frontiers.Smallest().set_op_id(op_id);
+    apply_group_.frontiers.Smallest().set_hybrid_time(hybrid_time);
+  }
+  apply_group_.frontiers.Largest().set_op_id(op_id);
+  apply_group_.frontiers.Largest().set_hybrid_time(hybrid_time);
+
+  if (put_batch.kv_pairs_size() != 0) {
+    PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &apply_group_.write_batch);
+  }
+  apply_group_.on_written.push_back(std::move(on_written));
+  return true;
+}
+
 namespace {
 
 // Separate Redis / QL / row operations write batches from write_request in preparation for the
@@ -753,6 +896,13 @@ Status Tablet::HandleRedisReadRequest(MonoTime deadline,
 
   ScopedTabletMetricsTracker metrics_tracker(metrics_->redis_read_latency);
 
+  if (HotKeys::ShouldSample()) {
+    auto hashed_key = ReadHashedKey(redis_read_request);
+    if (!hashed_key.empty()) {
+      hot_keys_->Record(HotKeys::AccessType::kRead, hashed_key);
+    }
+  }
+
   docdb::RedisReadOperation doc_op(
       redis_read_request, {regular_db_.get(), intents_db_.get()}, deadline, read_time);
   RETURN_NOT_OK(doc_op.Execute());
@@ -777,6 +927,14 @@ Status Tablet::HandleQLReadRequest(
     return Status::OK();
   }
 
+  // Only reads of a single hash key are attributed to a key, scans are not.
+  if (HotKeys::ShouldSample()) {
+    auto hashed_key = ReadHashedKey(ql_read_request);
+    if (!hashed_key.empty()) {
+      hot_keys_->Record(HotKeys::AccessType::kRead, hashed_key);
+    }
+  }
+
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(transaction_metadata);
   RETURN_NOT_OK(txn_op_ctx);
@@ -959,6 +1117,13 @@ Status Tablet::HandlePgsqlReadRequest(
     return Status::OK();
   }
 
+  if (HotKeys::ShouldSample()) {
+    auto hashed_key = ReadHashedKey(pgsql_read_request);
+    if (!hashed_key.empty()) {
+      hot_keys_->Record(HotKeys::AccessType::kRead, hashed_key);
+    }
+  }
+
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(transaction_metadata);
   RETURN_NOT_OK(txn_op_ctx);
@@ -1123,6 +1288,20 @@ Status Tablet::WaitForFlush() {
   return Status::OK();
 }
 
+MemStoreUsage Tablet::GetMemStoreUsage(FlushFlags flags) const {
+  DCHECK(flags == FlushFlags::kRegular || flags == FlushFlags::kIntents);
+  MemStoreUsage result;
+  auto* db = flags == FlushFlags::kIntents ? intents_db_.get() : regular_db_.get();
+  if (!db) {
+    return result;
+  }
+  uint64_t all_bytes = 0;
+  db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable, &result.active_bytes);
+  db->GetIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables, &all_bytes);
+  result.immutable_bytes = all_bytes > result.active_bytes ? all_bytes - result.active_bytes : 0;
+  return result;
+}
+
 Status Tablet::ImportData(const std::string& source_dir) {
   // We import only regular records, so don't have to deal with intents here.
   return regular_db_->Import(source_dir);
@@ -1150,6 +1329,23 @@ Status Tablet::ApplyIntents(const TransactionApplyData& data) {
   return Status::OK();
 }
 
+Status Tablet::RemoveIntents(const TransactionApplyData& data) {
+  rocksdb::WriteBatch intents_write_batch;
+  auto removed_intents = VERIFY_RESULT(docdb::PrepareRemoveIntentsBatch(
+      data.transaction_id, intents_db_.get(), &intents_write_batch));
+
+  docdb::ConsensusFrontiers frontiers;
+  set_op_id({data.op_id.term(), data.op_id.index()}, &frontiers);
+  set_hybrid_time(data.log_ht, &frontiers);
+  WriteBatch(&frontiers, data.log_ht, &intents_write_batch, intents_db_.get());
+  VLOG(2) << "T " << tablet_id() << ": removed " << removed_intents
+          << " intents of aborted transaction " << data.transaction_id;
+  if (metrics_) {
+    metrics_->aborted_transaction_intents_removed->IncrementBy(removed_intents);
+  }
+  return Status::OK();
+}
+
 Status Tablet::CreatePreparedAlterSchema(AlterSchemaOperationState *operation_state,
                                          const Schema* schema) {
   if (!key_schema_.KeyEquals(*schema)) {
@@ -1406,6 +1602,18 @@ Status Tablet::StartDocWriteOperation(const docdb::DocOperations &doc_ops,
       doc_ops, metrics_->write_lock_latency, *isolation_level, &shared_lock_manager_,
       data.keys_locked, &need_read_snapshot);
 
+  for (const auto& doc_op : doc_ops) {
+    if (!HotKeys::ShouldSample()) {
+      continue;
+    }
+    std::list<docdb::DocPath> doc_paths;
+    IsolationLevel ignored_level;
+    doc_op->GetDocPathsToLock(&doc_paths, &ignored_level);
+    if (!doc_paths.empty()) {
+      hot_keys_->Record(HotKeys::AccessType::kWrite, doc_paths.front().encoded_doc_key().AsSlice());
+    }
+  }
+
   auto read_op = need_read_snapshot
       ? ScopedReadOperation(this, RequireLease::kTrue, data.read_time())
       : ScopedReadOperation();
@@ -1452,7 +1660,8 @@ Status Tablet::StartDocWriteOperation(const docdb::DocOperations &doc_ops,
 }
 
 HybridTime Tablet::DoGetSafeTime(
-    tablet::RequireLease require_lease, HybridTime min_allowed, MonoTime deadline) const {
+    tablet::RequireLease require_lease, HybridTime min_allowed, MonoTime deadline,
+    const std::vector<std::string>* hashed_keys) const {
   HybridTime ht_lease;
   if (!require_lease) {
     return mvcc_.SafeTimeForFollower(min_allowed, deadline);
@@ -1478,7 +1687,18 @@ HybridTime Tablet::DoGetSafeTime(
                 << ht_lease;
     return HybridTime::kInvalid;
   }
-  return mvcc_.SafeTime(min_allowed, deadline, ht_lease);
+  auto start = MonoTime::Now();
+  HybridTime result;
+  if (hashed_keys && FLAGS_leader_read_safe_time_per_key) {
+    result = mvcc_.SafeTimeForHashedKeys(*hashed_keys, min_allowed, deadline, ht_lease);
+  } else {
+    result = mvcc_.SafeTime(min_allowed, deadline, ht_lease);
+  }
+  if (metrics_) {
+    metrics_->snapshot_read_inflight_wait_duration->Increment(
+        MonoTime::Now().GetDeltaSince(start).ToMicroseconds());
+  }
+  return result;
 }
 
 HybridTime Tablet::OldestReadPoint() const {
@@ -53,6 +53,7 @@
 #include "yb/common/transaction.h"
 #include "yb/common/ql_storage_interface.h"
 
+#include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_compaction_filter.h"
 #include "yb/docdb/doc_operation.h"
@@ -64,6 +65,7 @@
 #include "yb/gutil/macros.h"
 
 #include "yb/tablet/abstract_tablet.h"
+#include "yb/tablet/hot_keys.h"
 #include "yb/tablet/lock_manager.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/mvcc.h"
@@ -181,6 +183,14 @@ struct DocDbOpIds {
   OpId intents;
 };
 
+// Memory used by the memtables of one of the RocksDB instances of a tablet.
+struct MemStoreUsage {
+  // Size of the active memtable, which a new flush would free.
+  uint64_t active_bytes = 0;
+  // Size of the immutable memtables that are waiting to be flushed or being flushed.
+  uint64_t immutable_bytes = 0;
+};
+
 class Tablet : public AbstractTablet, public TransactionIntentApplier {
  public:
   class CompactionFaultHooks;
@@ -231,6 +241,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS ApplyIntents(const TransactionApplyData& data) override;
 
+  CHECKED_STATUS RemoveIntents(const TransactionApplyData& data) override;
+
   // Finish the Prepare phase of a write transaction.
   //
   // Starts an MVCC transaction and assigns a timestamp for the transaction.
@@ -274,6 +286,25 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
                   rocksdb::WriteBatch* write_batch,
                   rocksdb::DB* dest_db);
 
+  // Starts an apply group. Non-transactional write operations applied with
+  // ApplyRowOperationsInGroup are accumulated into a single RocksDB write batch with one frontier
+  // update, instead of being written to RocksDB one by one.
+  void StartApplyGroup();
+
+  // Writes the operations accumulated in the current apply group and closes the group.
+  void FinishApplyGroup();
+
+  // Writes the operations accumulated in the current apply group, if any. Should be called before
+  // applying an operation that is not part of the group.
+  void FlushApplyGroup();
+
+  // Adds the row operations of operation_state to the current apply group. on_written is invoked
+  // after they are written to RocksDB, i.e. when the group is flushed. Returns false when there is
+  // no open apply group or the operation cannot be grouped, in which case it should be applied
+  // with ApplyRowOperations.
+  bool ApplyRowOperationsInGroup(WriteOperationState* operation_state,
+                                 std::function<void()> on_written);
+
   //------------------------------------------------------------------------------------------------
   // Redis Request Processing.
   // Takes a Redis WriteRequestPB as input with its redis_write_batch.
@@ -342,6 +373,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS WaitForFlush();
 
+  // Returns the memtable memory usage of the regular or the intents RocksDB, depending on whether
+  // the flags are FlushFlags::kRegular or FlushFlags::kIntents.
+  MemStoreUsage GetMemStoreUsage(FlushFlags flags) const;
+
   // Prepares the transaction context for the alter schema operation.
   // An error will be returned if the specified schema is invalid (e.g.
   // key mismatch, or missing IDs)
@@ -389,6 +424,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Return handle to the metric entity of this tablet.
   const scoped_refptr<MetricEntity>& GetMetricEntity() const { return metric_entity_; }
 
+  // Returns the most frequently read and written keys of this tablet.
+  const HotKeys& hot_keys() const { return *hot_keys_; }
+
   // Returns a reference to this tablet's memory tracker.
   const std::shared_ptr<MemTracker>& mem_tracker() const { return mem_tracker_; }
 
@@ -471,6 +509,15 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
     return regular_db_.get();
   }
 
+  rocksdb::DB* TEST_intents_db() const {
+    return intents_db_.get();
+  }
+
+  // Number of apply groups written to RocksDB.
+  int64_t TEST_apply_groups_written() const {
+    return apply_groups_written_.load(std::memory_order_relaxed);
+  }
+
   CHECKED_STATUS TEST_SwitchMemtable();
 
  protected:
@@ -556,6 +603,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   MetricEntityPtr metric_entity_;
   gscoped_ptr<TabletMetrics> metrics_;
+  std::unique_ptr<HotKeys> hot_keys_;
+
+  // Encoded document keys that belong to this tablet, according to its partition.
+  docdb::KeyBounds key_bounds_;
   FunctionGaugeDetacher metric_detacher_;
 
   int64_t next_mrs_id_ = 0;
@@ -642,6 +693,23 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::atomic<int64_t> last_committed_write_index_{0};
 
+  // Writes of consecutively applied operations that are written to RocksDB together.
+  struct ApplyGroup {
+    bool active = false;
+    rocksdb::WriteBatch write_batch;
+    docdb::ConsensusFrontiers frontiers;
+    // Callbacks of the grouped operations, in the order they were added.
+    std::vector<std::function<void()>> on_written;
+  };
+
+  // Protects apply_group_. Operations are usually applied by the consensus thread that opened the
+  // group, but replica operations that finish prepare late are applied from the prepare thread.
+  std::mutex apply_group_mutex_;
+  ApplyGroup apply_group_;
+  // Held while callbacks of a written apply group are invoked. Acquired under apply_group_mutex_.
+  std::mutex apply_group_callbacks_mutex_;
+  std::atomic<int64_t> apply_groups_written_{0};
+
   // Remembers he HybridTime of the oldest write that is still not scheduled to
   // be flushed in RocksDB.
   std::shared_ptr<TabletFlushStats> flush_stats_;
@@ -650,10 +718,15 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
  private:
   HybridTime DoGetSafeTime(
-      RequireLease require_lease, HybridTime min_allowed, MonoTime deadline) const override;
+      RequireLease require_lease, HybridTime min_allowed, MonoTime deadline,
+      const std::vector<std::string>* hashed_keys) const override;
 
   CHECKED_STATUS UpdateQLIndexes(docdb::DocOperations* doc_ops);
 
+  // Writes the current apply group. lock should hold apply_group_mutex_, it is released before
+  // callbacks of the written operations are invoked.
+  void FlushApplyGroupAndUnlock(std::unique_lock<std::mutex>* lock);
+
   Result<bool> IntentsDbFlushFilter(const rocksdb::MemTable& memtable);
 
   std::function<rocksdb::MemTableFilter()> mem_table_flush_filter_factory_;
@@ -50,6 +50,12 @@ using std::shared_ptr;
 using std::string;
 using std::vector;
 
+DEFINE_int32(bootstrap_benchmark_num_ops, 20000,
+             "Number of write operations replayed by the bootstrap benchmarks.");
+
+DECLARE_int32(tablet_bootstrap_read_ahead_segments);
+DECLARE_int32(tablet_bootstrap_apply_group_max_ops);
+
 namespace yb {
 
 namespace log {
@@ -159,6 +165,39 @@ class BootstrapTest : public LogTestBase {
     return Status::OK();
   }
 
+  // Writes a log of single row write operations spread over several segments, bootstraps the tablet
+  // from it and reports the replay speed.
+  void BenchmarkReplay(const std::string& description) {
+    BuildLog();
+    const int num_ops = FLAGS_bootstrap_benchmark_num_ops;
+    const int ops_per_segment = std::max(num_ops / 10, 1);
+    for (int i = 1; i <= num_ops; ++i) {
+      const auto op_id = MakeOpId(1, i);
+      const bool last_in_segment = i % ops_per_segment == 0 || i == num_ops;
+      AppendReplicateBatch(op_id, op_id, {TupleForAppend(i, i, "benchmark row")},
+                           last_in_segment /* sync */);
+      if (last_in_segment && i != num_ops) {
+        ASSERT_OK(RollLog());
+      }
+    }
+
+    ConsensusBootstrapInfo boot_info;
+    shared_ptr<TabletClass> tablet;
+    const MonoTime start = MonoTime::Now();
+    ASSERT_OK(BootstrapTestTablet(-1, -1, &tablet, &boot_info));
+    const MonoDelta elapsed = MonoTime::Now() - start;
+
+    ASSERT_EQ(boot_info.orphaned_replicates.size(), 0);
+    ASSERT_OPID_EQ(boot_info.last_committed_id, MakeOpId(1, num_ops));
+    vector<string> results;
+    IterateTabletRows(tablet.get(), &results);
+    ASSERT_EQ(num_ops, results.size());
+
+    LOG(INFO) << description << ": replayed " << num_ops << " operations in "
+              << elapsed.ToMilliseconds() << "ms, "
+              << num_ops * 1000 / std::max<int64_t>(elapsed.ToMilliseconds(), 1) << " ops/s";
+  }
+
   void IterateTabletRows(const Tablet* tablet,
                          vector<string>* results) {
     auto iter = tablet->NewRowIterator(schema_, boost::none);
@@ -336,5 +375,17 @@ TEST_F(BootstrapTest, TestConsensusOnlyOperationOutOfOrderHybridTime) {
   ASSERT_EQ(1, results.size());
 }
 
+TEST_F(BootstrapTest, BenchmarkSerialReplay) {
+  FLAGS_tablet_bootstrap_read_ahead_segments = 0;
+  FLAGS_tablet_bootstrap_apply_group_max_ops = 0;
+  BenchmarkReplay("Serial replay");
+}
+
+TEST_F(BootstrapTest, BenchmarkPipelinedReplay) {
+  FLAGS_tablet_bootstrap_read_ahead_segments = 2;
+  FLAGS_tablet_bootstrap_apply_group_max_ops = 1000;
+  BenchmarkReplay("Pipelined replay");
+}
+
 } // namespace tablet
 } // namespace yb
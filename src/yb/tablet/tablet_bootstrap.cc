@@ -31,6 +31,12 @@
 //
 #include "yb/tablet/tablet_bootstrap.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <boost/scope_exit.hpp>
+
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_reader.h"
@@ -45,7 +51,10 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/opid.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/thread.h"
 
 DEFINE_bool(skip_remove_old_recovery_dir, false,
             "Skip removing WAL recovery dir after startup. (useful for debugging)");
@@ -55,13 +64,36 @@ DEFINE_test_flag(double, fault_crash_during_log_replay, 0.0,
                  "Fraction of the time when the tablet will crash immediately "
                  "after processing a log entry during log replay.");
 
+DEFINE_int32(tablet_bootstrap_read_ahead_segments, 1,
+             "Number of log segments that are read and decoded by a separate thread ahead of the "
+             "one being replayed during tablet bootstrap. 0 to read the segments in the replaying "
+             "thread.");
+TAG_FLAG(tablet_bootstrap_read_ahead_segments, advanced);
+
+DEFINE_int32(tablet_bootstrap_apply_group_max_ops, 1000,
+             "Maximum number of consecutive non-transactional write operations that are replayed "
+             "into RocksDB with a single write batch during tablet bootstrap. 1 or less to write "
+             "them one by one. Requires --tablet_group_apply_writes.");
+TAG_FLAG(tablet_bootstrap_apply_group_max_ops, advanced);
+
 DECLARE_uint64(max_clock_sync_error_usec);
 
+METRIC_DEFINE_counter(tablet, log_replay_entries, "Log Entries Replayed",
+                      yb::MetricUnit::kEntries,
+                      "Number of log entries read and replayed during tablet bootstrap.");
+METRIC_DEFINE_counter(tablet, log_replay_bytes, "Log Bytes Replayed",
+                      yb::MetricUnit::kBytes,
+                      "Size of the log segments replayed during tablet bootstrap.");
+METRIC_DEFINE_counter(tablet, log_replay_segments, "Log Segments Replayed",
+                      yb::MetricUnit::kUnits,
+                      "Number of log segments replayed during tablet bootstrap.");
+
 namespace yb {
 namespace tablet {
 
 using namespace std::literals; // NOLINT
 using namespace std::placeholders;
+using namespace yb::size_literals;
 using std::shared_ptr;
 
 using log::Log;
@@ -100,6 +132,113 @@ static string DebugInfo(const string& tablet_id,
                     segment_path, debug_str);
 }
 
+// ============================================================================
+//  Class LogSegmentReader.
+// ============================================================================
+
+namespace {
+
+// Reads and decodes the log segments to replay, in order. Unless max_read_ahead is 0, a separate
+// thread reads up to max_read_ahead segments following the one being replayed, so that reading and
+// decoding them overlaps with applying the entries of the current segment.
+class LogSegmentReader {
+ public:
+  struct ReadSegment {
+    scoped_refptr<ReadableLogSegment> segment;
+    log::LogEntries entries;
+    // Status of reading the segment. The entries read before a failure are still returned.
+    Status read_status;
+  };
+
+  LogSegmentReader(const log::SegmentSequence& segments, int max_read_ahead)
+      : segments_(segments), max_read_ahead_(max_read_ahead) {
+  }
+
+  ~LogSegmentReader() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    if (thread_) {
+      CHECK_OK(ThreadJoiner(thread_.get()).Join());
+    }
+  }
+
+  CHECKED_STATUS Start() {
+    if (max_read_ahead_ <= 0 || segments_.size() <= 1) {
+      return Status::OK();
+    }
+    return Thread::Create("tablet", "bootstrap-read", &LogSegmentReader::Run, this, &thread_);
+  }
+
+  // Returns the next segment with its entries in 'result', blocking until it is read. Returns false
+  // when there are no more segments.
+  bool Next(ReadSegment* result) {
+    if (!thread_) {
+      if (next_to_read_ >= segments_.size()) {
+        return false;
+      }
+      Read(next_to_read_++, result);
+      return true;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return !ready_.empty() || next_to_read_ >= segments_.size(); });
+    if (ready_.empty()) {
+      return false;
+    }
+    *result = std::move(ready_.front());
+    ready_.pop_front();
+    cond_.notify_all();
+    return true;
+  }
+
+ private:
+  void Read(size_t idx, ReadSegment* result) {
+    result->segment = segments_[idx];
+    result->entries.clear();
+    result->read_status = result->segment->ReadEntries(&result->entries);
+  }
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (next_to_read_ < segments_.size()) {
+      cond_.wait(lock, [this] { return stop_ || ready_.size() < max_read_ahead_; });
+      if (stop_) {
+        break;
+      }
+      const size_t idx = next_to_read_;
+      lock.unlock();
+
+      ReadSegment segment;
+      Read(idx, &segment);
+      const bool failed = !segment.read_status.ok();
+
+      lock.lock();
+      ready_.push_back(std::move(segment));
+      // Replay fails at the segment that could not be read, so there is no point to read further.
+      next_to_read_ = failed ? segments_.size() : idx + 1;
+      cond_.notify_all();
+    }
+  }
+
+  const log::SegmentSequence& segments_;
+  const size_t max_read_ahead_;
+
+  scoped_refptr<Thread> thread_;
+
+  std::mutex mutex_;
+  // Signaled when a segment is read or taken by the replaying thread, or the reader is stopped.
+  std::condition_variable cond_;
+  // Segments read ahead and not taken yet.
+  std::deque<ReadSegment> ready_;
+  size_t next_to_read_ = 0;
+  bool stop_ = false;
+};
+
+} // namespace
+
 // ============================================================================
 //  Class ReplayState.
 // ============================================================================
@@ -656,6 +795,11 @@ Status TabletBootstrap::HandleEntryPair(ReplayState* state, LogEntryPB* replicat
   }
 
   if (replicate->id().index() > flushed_index) {
+    if (op_type != consensus::WRITE_OP) {
+      // Operations other than writes may depend on the grouped writes being in RocksDB, or write to
+      // it themselves.
+      FlushApplyGroup();
+    }
     const auto status = HandleOperation(op_type, replicate);
     if (!status.ok()) {
       return status.CloneAndAppend(Format(
@@ -713,11 +857,34 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   // from the log we're reading into the log we're writing.
   RETURN_NOT_OK_PREPEND(OpenNewLog(), "Failed to open new log");
 
+  scoped_refptr<Counter> entries_replayed;
+  scoped_refptr<Counter> bytes_replayed;
+  scoped_refptr<Counter> segments_replayed;
+  if (tablet_->GetMetricEntity()) {
+    entries_replayed = METRIC_log_replay_entries.Instantiate(tablet_->GetMetricEntity());
+    bytes_replayed = METRIC_log_replay_bytes.Instantiate(tablet_->GetMetricEntity());
+    segments_replayed = METRIC_log_replay_segments.Instantiate(tablet_->GetMetricEntity());
+  }
+
+  if (FLAGS_tablet_bootstrap_apply_group_max_ops > 1) {
+    tablet_->StartApplyGroup();
+  }
+  auto* tablet = tablet_.get();
+  BOOST_SCOPE_EXIT(tablet) {
+    tablet->FinishApplyGroup();
+  } BOOST_SCOPE_EXIT_END;
+
+  LogSegmentReader reader(segments, FLAGS_tablet_bootstrap_read_ahead_segments);
+  RETURN_NOT_OK(reader.Start());
+
+  const MonoTime replay_start = MonoTime::Now();
+  int64_t total_bytes = 0;
   int segment_count = 0;
-  for (const scoped_refptr<ReadableLogSegment>& segment : segments) {
-    log::LogEntries entries;
-    // TODO: Optimize this to not read the whole thing into memory?
-    Status read_status = segment->ReadEntries(&entries);
+  LogSegmentReader::ReadSegment read_segment;
+  while (reader.Next(&read_segment)) {
+    const auto& segment = read_segment.segment;
+    auto& entries = read_segment.entries;
+    const MonoTime segment_start = MonoTime::Now();
     for (int entry_idx = 0; entry_idx < entries.size(); ++entry_idx) {
       Status s = HandleEntry(&state, &entries[entry_idx]);
       if (!s.ok()) {
@@ -734,6 +901,7 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
     // possible, and then fail with Corruption.
     // TODO: this is sort of scary -- why doesn't LogReader expose an entry-by-entry iterator-like
     // API instead? Seems better to avoid exposing the idea of segments to callers.
+    const Status& read_status = read_segment.read_status;
     if (PREDICT_FALSE(!read_status.ok())) {
       return STATUS(Corruption, Substitute("Error reading Log Segment of tablet $0: $1 "
                                            "(Read up to entry $2 of segment $3, in path $4)",
@@ -744,16 +912,33 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
                                            segment->path()));
     }
 
-    // TODO: could be more granular here and log during the segments as well, plus give info about
-    // number of MB processed, but this is better than nothing.
-    listener_->StatusMessage(Substitute("Bootstrap replayed $0/$1 log segments. "
-                                        "Stats: $2. Pending: $3 replicates",
+    const int64_t segment_bytes = segment->readable_up_to();
+    total_bytes += segment_bytes;
+    if (entries_replayed) {
+      entries_replayed->IncrementBy(entries.size());
+      bytes_replayed->IncrementBy(segment_bytes);
+      segments_replayed->Increment();
+    }
+
+    // Replay time of the segment only, i.e. excluding the time spent waiting for it to be read.
+    const double segment_seconds = (MonoTime::Now() - segment_start).ToSeconds();
+    const double total_seconds = (MonoTime::Now() - replay_start).ToSeconds();
+    VLOG_WITH_PREFIX(1) << "Replayed " << entries.size() << " entries of log segment "
+                        << segment->path() << " in " << segment_seconds << "s";
+    listener_->StatusMessage(Substitute("Bootstrap replayed $0/$1 log segments, $2 MB at $3 MB/s. "
+                                        "Stats: $4. Pending: $5 replicates",
                                         segment_count + 1, log_reader_->num_segments(),
+                                        total_bytes / 1_MB,
+                                        total_seconds > 0
+                                            ? static_cast<int64_t>(total_bytes / total_seconds) / 1_MB
+                                            : 0,
                                         stats_.ToString(),
                                         state.pending_replicates.size()));
     segment_count++;
   }
 
+  tablet_->FinishApplyGroup();
+
   LOG(INFO) << "Dumping replay state to log at the end of " << __FUNCTION__;
   DumpReplayStateToLog(state);
 
@@ -795,9 +980,26 @@ void TabletBootstrap::PlayWriteRequest(ReplicateMsg* replicate_msg) {
   // Use committed OpId for mem store anchoring.
   operation_state.mutable_op_id()->CopyFrom(replicate_msg->id());
 
+  const HybridTime hybrid_time = operation_state.hybrid_time();
+  auto* mvcc = tablet_->mvcc_manager();
+  if (tablet_->ApplyRowOperationsInGroup(
+          &operation_state, [mvcc, hybrid_time] { mvcc->Replicated(hybrid_time); })) {
+    if (++ops_in_apply_group_ >= FLAGS_tablet_bootstrap_apply_group_max_ops) {
+      FlushApplyGroup();
+    }
+    return;
+  }
+
+  // Transactional writes are not grouped, and should follow the grouped writes before them.
+  FlushApplyGroup();
   tablet_->ApplyRowOperations(&operation_state);
 
-  tablet_->mvcc_manager()->Replicated(operation_state.hybrid_time());
+  mvcc->Replicated(hybrid_time);
+}
+
+void TabletBootstrap::FlushApplyGroup() {
+  tablet_->FlushApplyGroup();
+  ops_in_apply_group_ = 0;
 }
 
 Status TabletBootstrap::PlayAlterSchemaRequest(ReplicateMsg* replicate_msg) {
@@ -109,8 +109,13 @@ class TabletBootstrap {
   // accepting writes from clients.
   CHECKED_STATUS PlaySegments(consensus::ConsensusBootstrapInfo* results);
 
+  // Replays a write operation. Consecutive non-transactional writes are accumulated in the apply
+  // group of the tablet, if it is open, and written to RocksDB together.
   void PlayWriteRequest(consensus::ReplicateMsg* replicate_msg);
 
+  // Writes the write operations accumulated in the apply group of the tablet to RocksDB.
+  void FlushApplyGroup();
+
   CHECKED_STATUS PlayUpdateTransactionRequest(consensus::ReplicateMsg* replicate_msg);
 
   CHECKED_STATUS PlayAlterSchemaRequest(consensus::ReplicateMsg* replicate_msg);
@@ -183,6 +188,9 @@ class TabletBootstrap {
 
   HybridTime rocksdb_last_entry_hybrid_time_ = HybridTime::kMin;
 
+  // Number of write operations in the apply group of the tablet that are not written yet.
+  int ops_in_apply_group_ = 0;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(TabletBootstrap);
 };
@@ -68,6 +68,14 @@ TAG_FLAG(enable_tablet_orphaned_block_deletion, advanced);
 TAG_FLAG(enable_tablet_orphaned_block_deletion, hidden);
 TAG_FLAG(enable_tablet_orphaned_block_deletion, runtime);
 
+DEFINE_bool(retain_tombstoned_rocksdb_files, false,
+            "Whether to keep the RocksDB files of a tombstoned tablet until it is deleted or "
+            "remotely bootstrapped again, so that remote bootstrap can hard link the SST files "
+            "that did not change instead of downloading them. The retained files take as much "
+            "disk space as the tablet had, also when the tablet was moved away for good.");
+TAG_FLAG(retain_tombstoned_rocksdb_files, advanced);
+TAG_FLAG(retain_tombstoned_rocksdb_files, runtime);
+
 using std::shared_ptr;
 
 using base::subtle::Barrier_AtomicIncrement;
@@ -82,6 +90,7 @@ namespace tablet {
 const int64 kNoDurableMemStore = -1;
 const std::string kIntentsSubdir = "intents";
 const std::string kIntentsDBSuffix = ".intents";
+const std::string kTombstonedDBSuffix = ".tombstoned";
 
 // ============================================================================
 //  Tablet Metadata
@@ -208,13 +217,39 @@ Status TabletMetadata::DeleteTabletData(TabletDataState delete_type,
   docdb::InitRocksDBOptions(
       &rocksdb_options, tablet_id_, nullptr /* statistics */, tablet_options);
 
-  LOG(INFO) << "Destroying regular db at: " << rocksdb_dir_;
-  rocksdb::Status status = rocksdb::DestroyDB(rocksdb_dir_, rocksdb_options);
+  // With --retain_tombstoned_rocksdb_files, a tombstoned tablet keeps its files aside for the
+  // next remote bootstrap instead of destroying them. Files retained by an earlier tombstone are
+  // replaced, or deleted with the tablet.
+  auto* env = fs_manager_->env();
+  const auto tombstoned_dir = rocksdb_dir_ + kTombstonedDBSuffix;
+  const bool retain = delete_type == TABLET_DATA_TOMBSTONED &&
+                      FLAGS_retain_tombstoned_rocksdb_files && env->FileExists(rocksdb_dir_);
+  if ((retain || delete_type == TABLET_DATA_DELETED) && env->FileExists(tombstoned_dir)) {
+    LOG(INFO) << "Deleting retained files of tombstoned regular DB at: " << tombstoned_dir;
+    WARN_NOT_OK(env->DeleteRecursively(tombstoned_dir),
+                Substitute("Failed to delete $0", tombstoned_dir));
+  }
 
-  if (!status.ok()) {
-    LOG(ERROR) << "Failed to destroy regular DB at: " << rocksdb_dir_ << ": " << status;
-  } else {
-    LOG(INFO) << "Successfully destroyed regular DB at: " << rocksdb_dir_;
+  bool retained = false;
+  if (retain) {
+    Status s = env->RenameFile(rocksdb_dir_, tombstoned_dir);
+    if (s.ok()) {
+      LOG(INFO) << "Retained files of regular DB at: " << tombstoned_dir;
+      retained = true;
+    } else {
+      LOG(ERROR) << "Failed to retain files of regular DB at: " << rocksdb_dir_ << ": " << s;
+    }
+  }
+
+  if (!retained) {
+    LOG(INFO) << "Destroying regular db at: " << rocksdb_dir_;
+    rocksdb::Status status = rocksdb::DestroyDB(rocksdb_dir_, rocksdb_options);
+
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to destroy regular DB at: " << rocksdb_dir_ << ": " << status;
+    } else {
+      LOG(INFO) << "Successfully destroyed regular DB at: " << rocksdb_dir_;
+    }
   }
 
   auto intents_dir = rocksdb_dir_ + kIntentsDBSuffix;
@@ -208,7 +208,9 @@ class TabletMetadata : public RefCountedThreadSafe<TabletMetadata> {
   // last_logged_opid is not modified. This is important for roll-forward of
   // partially-tombstoned tablets during crash recovery.
   //
-  // Returns only once all data has been removed.
+  // Returns only once all data has been removed. When tombstoning with
+  // --retain_tombstoned_rocksdb_files, the RocksDB files are moved aside to
+  // rocksdb_dir() + kTombstonedDBSuffix instead, for reuse by remote bootstrap.
   // The OUT parameter 'was_deleted' can be used by caller to determine if the tablet data was
   // actually deleted from disk or not. For example, in some cases, the tablet may have been
   // already deleted (and are here on a retry) and this operation essentially ends up being a no-op;
@@ -380,6 +382,9 @@ class TabletMetadata : public RefCountedThreadSafe<TabletMetadata> {
 
 extern const std::string kIntentsSubdir;
 extern const std::string kIntentsDBSuffix;
+// Suffix of the directory where the RocksDB files of a tombstoned tablet are retained for reuse by
+// remote bootstrap.
+extern const std::string kTombstonedDBSuffix;
 
 } // namespace tablet
 } // namespace yb
@@ -57,9 +57,10 @@ METRIC_DEFINE_histogram(tablet, write_op_duration_client_propagated_consistency,
   60000000LU, 2);
 
 METRIC_DEFINE_histogram(tablet, snapshot_read_inflight_wait_duration,
-  "Time Waiting For Snapshot Reads",
+  "Time Waiting For In-Flight Writes",
   yb::MetricUnit::kMicroseconds,
-  "Time spent waiting for in-flight writes to complete for READ_AT_SNAPSHOT scans.",
+  "Time spent by strongly consistent reads waiting for the hybrid time leader lease and for "
+  "in-flight writes to complete.",
   60000000LU, 2);
 
 METRIC_DEFINE_histogram(
@@ -119,11 +120,28 @@ METRIC_DEFINE_counter(tablet, expired_transactions,
   yb::MetricUnit::kRequests,
   "Number of expired distributed transactions.");
 
+METRIC_DEFINE_histogram(tablet, transaction_status_batch_size,
+  "Transaction Status Batch Size",
+  yb::MetricUnit::kTransactions,
+  "Number of transactions whose status is resolved by a single request to a status tablet.",
+  10000LU, 2);
+
+METRIC_DEFINE_histogram(tablet, transaction_status_resolution_latency,
+  "Transaction Status Resolution Latency",
+  yb::MetricUnit::kMicroseconds,
+  "Time taken to resolve the status of a transaction from its status tablet.",
+  60000000LU, 2);
+
 METRIC_DEFINE_counter(tablet, restart_read_requests,
   "Read Requests Requiring Restart",
   yb::MetricUnit::kRequests,
   "Number of read requests that require restart.");
 
+METRIC_DEFINE_counter(tablet, aborted_transaction_intents_removed,
+  "Aborted Transaction Intents Removed",
+  yb::MetricUnit::kEntries,
+  "Number of intents of aborted distributed transactions removed from the intents DB.");
+
 using strings::Substitute;
 
 namespace yb {
@@ -136,10 +154,13 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(ql_read_latency),
     MINIT(write_lock_latency),
     MINIT(write_op_duration_client_propagated_consistency),
+    MINIT(transaction_status_batch_size),
+    MINIT(transaction_status_resolution_latency),
     MINIT(leader_memory_pressure_rejections),
     MINIT(transaction_conflicts),
     MINIT(expired_transactions),
-    MINIT(restart_read_requests) {
+    MINIT(restart_read_requests),
+    MINIT(aborted_transaction_intents_removed) {
 }
 #undef MINIT
 
@@ -59,11 +59,14 @@ struct TabletMetrics {
   scoped_refptr<Histogram> write_lock_latency;
   scoped_refptr<Histogram> write_op_duration_client_propagated_consistency;
   scoped_refptr<Histogram> write_op_duration_commit_wait_consistency;
+  scoped_refptr<Histogram> transaction_status_batch_size;
+  scoped_refptr<Histogram> transaction_status_resolution_latency;
 
   scoped_refptr<Counter> leader_memory_pressure_rejections;
   scoped_refptr<Counter> transaction_conflicts;
   scoped_refptr<Counter> expired_transactions;
   scoped_refptr<Counter> restart_read_requests;
+  scoped_refptr<Counter> aborted_transaction_intents_removed;
 };
 
 class ScopedTabletMetricsTracker {
@@ -731,6 +731,14 @@ void TabletPeer::SetPropagatedSafeTime(HybridTime ht) {
   (**driver).ExecuteAsync();
 }
 
+void TabletPeer::StartApplyGroup() {
+  tablet_->StartApplyGroup();
+}
+
+void TabletPeer::FinishApplyGroup() {
+  tablet_->FinishApplyGroup();
+}
+
 const std::string& TabletPeer::permanent_uuid() const {
   if (cached_permanent_uuid_initialized_.load(std::memory_order_acquire)) {
     return cached_permanent_uuid_;
@@ -161,6 +161,11 @@ class TabletPeer : public consensus::ReplicaOperationFactory,
   // UpdateReplica -> EnqueuePreparesUnlocked on Raft heartbeats.
   void SetPropagatedSafeTime(HybridTime ht) override;
 
+  // These are overrides of ReplicaOperationFactory methods. They are called by consensus around
+  // applying a run of committed operations, which lets the tablet write them together.
+  void StartApplyGroup() override;
+  void FinishApplyGroup() override;
+
   consensus::Consensus* consensus() const;
 
   std::shared_ptr<consensus::Consensus> shared_consensus() const;
@@ -211,7 +211,8 @@ class TestRandomAccess : public YBTabletTest {
 
     EXPECT_EQ(QLResponsePB::YQL_STATUS_OK, result.response.status());
 
-    auto row_block = CreateRowBlock(QLClient::YQL_CLIENT_CQL, schema_, result.rows_data);
+    auto row_block = CreateRowBlock(
+        QLClient::YQL_CLIENT_CQL, schema_, result.rows_data.ToBuffer());
     if (row_block->row_count() == 0) {
       return VALUE_NOT_FOUND;
     }
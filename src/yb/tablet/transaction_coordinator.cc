@@ -48,6 +48,7 @@
 #include "yb/tserver/tserver_service.pb.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/kernel_stack_watchdog.h"
 #include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
@@ -64,6 +65,12 @@ DEFINE_double(transaction_max_missed_heartbeat_periods, 10.0 * yb::kTimeMultipli
 DEFINE_uint64(transaction_check_interval_usec, 500000, "Transaction check interval in usec.");
 DEFINE_double(transaction_ignore_applying_probability_in_tests, 0,
               "Probability to ignore APPLYING update in tests.");
+DEFINE_bool(transaction_cleanup_aborted_intents, false,
+            "Whether intents of aborted transactions are removed by CLEANUP updates, that are sent "
+            "to the involved tablets and replicated by them. Should be enabled only after all "
+            "tablet servers are upgraded to a version that supports CLEANUP.");
+TAG_FLAG(transaction_cleanup_aborted_intents, runtime);
+TAG_FLAG(transaction_cleanup_aborted_intents, advanced);
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -87,6 +94,11 @@ struct NotifyApplyingData {
   HybridTime commit_time;
 };
 
+struct NotifyCleanupData {
+  TabletId tablet;
+  TransactionId transaction;
+};
+
 // Context for transaction state. I.e. access to external facilities required by
 // transaction state to do its job.
 class TransactionStateContext {
@@ -95,6 +107,8 @@ class TransactionStateContext {
 
   virtual void NotifyApplying(NotifyApplyingData data) = 0;
 
+  virtual void NotifyCleanup(NotifyCleanupData data) = 0;
+
   virtual Counter& expired_metric() = 0;
 
   // Submits update transaction to the RAFT log. Returns false if was not able to submit.
@@ -218,15 +232,17 @@ class TransactionState {
     NotifyAbortWaiters(status);
   }
 
-  CHECKED_STATUS GetStatus(tserver::GetTransactionStatusResponsePB* response) const {
+  // Appends status of this transaction to the response.
+  void GetStatus(tserver::GetTransactionStatusResponsePB* response) const {
     if (status_ == TransactionStatus::COMMITTED) {
-      response->set_status(TransactionStatus::COMMITTED);
-      response->set_status_hybrid_time(commit_time_.ToUint64());
+      response->add_status(TransactionStatus::COMMITTED);
+      response->add_status_hybrid_time(commit_time_.ToUint64());
     } else if (status_ == TransactionStatus::ABORTED) {
-      response->set_status(TransactionStatus::ABORTED);
+      response->add_status(TransactionStatus::ABORTED);
+      response->add_status_hybrid_time(HybridTime::kMax.ToUint64());
     } else {
       CHECK_EQ(TransactionStatus::PENDING, status_);
-      response->set_status(TransactionStatus::PENDING);
+      response->add_status(TransactionStatus::PENDING);
       HybridTime status_ht = context_.coordinator_context().clock().Now();
       if (replicating_) {
         auto replicating_status = replicating_->request()->status();
@@ -239,20 +255,23 @@ class TransactionState {
         }
       }
       status_ht = std::min(status_ht, context_.coordinator_context().HtLeaseExpiration());
-      response->set_status_hybrid_time(status_ht.Decremented().ToUint64());
+      response->add_status_hybrid_time(status_ht.Decremented().ToUint64());
     }
-    return Status::OK();
   }
 
-  TransactionStatus Abort(TransactionAbortCallback* callback) {
+  TransactionStatus Abort(TransactionAbortCallback* callback,
+                          const std::vector<TabletId>& involved_tablets) {
     if (ShouldBeCommitted()) {
       return TransactionStatus::COMMITTED;
     } else if (status_ == TransactionStatus::ABORTED) {
+      for (const auto& tablet : involved_tablets) {
+        context_.NotifyCleanup({tablet, id_});
+      }
       return TransactionStatus::ABORTED;
     } else {
       CHECK_EQ(TransactionStatus::PENDING, status_);
       abort_waiters_.emplace_back(std::move(*callback));
-      Abort();
+      Abort(involved_tablets);
       return TransactionStatus::PENDING;
     }
   }
@@ -272,8 +291,9 @@ class TransactionState {
     DoHandle(std::move(request));
   }
 
-  // Aborts this transaction.
-  void Abort() {
+  // Aborts this transaction. involved_tablets are the tablets that could have received intents of
+  // this transaction, when known.
+  void Abort(const std::vector<TabletId>& involved_tablets = std::vector<TabletId>()) {
     if (ShouldBeCommitted()) {
       LOG_WITH_PREFIX(DFATAL) << "Transaction abort in wrong state: " << status_;
       return;
@@ -282,7 +302,7 @@ class TransactionState {
       return;
     }
     CHECK_EQ(status_, TransactionStatus::PENDING);
-    SubmitUpdateStatus(TransactionStatus::ABORTED);
+    SubmitUpdateStatus(TransactionStatus::ABORTED, involved_tablets);
   }
 
   // Returns logs prefix for this transaction.
@@ -344,10 +364,11 @@ class TransactionState {
       case TransactionStatus::CREATED: FALLTHROUGH_INTENDED;
       case TransactionStatus::PENDING:
         return PendingReplicationFinished(data);
-      case TransactionStatus::APPLYING:
-        // APPLYING is handled separately, because it is received for transactions not managed by
-        // this tablet as a transaction status tablet, but tablets that are involved in the data
-        // path (receive write intents) for this transactions
+      case TransactionStatus::APPLYING: FALLTHROUGH_INTENDED;
+      case TransactionStatus::CLEANUP:
+        // APPLYING and CLEANUP are handled separately, because they are received for transactions
+        // not managed by this tablet as a transaction status tablet, but tablets that are involved
+        // in the data path (receive write intents) for this transactions
         FATAL_INVALID_ENUM_VALUE(TransactionStatus, data.state.status());
       case TransactionStatus::APPLIED_IN_ONE_OF_INVOLVED_TABLETS:
         // APPLIED_IN_ONE_OF_INVOLVED_TABLETS handled w/o use of RAFT log
@@ -401,12 +422,16 @@ class TransactionState {
     return Status::OK();
   }
 
-  void SubmitUpdateStatus(TransactionStatus status) {
+  void SubmitUpdateStatus(TransactionStatus status,
+                          const std::vector<TabletId>& tablets = std::vector<TabletId>()) {
     VLOG_WITH_PREFIX(4) << "SubmitUpdateStatus(" << TransactionStatus_Name(status) << ")";
 
     tserver::TransactionStatePB state;
     state.set_transaction_id(id_.begin(), id_.size());
     state.set_status(status);
+    for (const auto& tablet : tablets) {
+      state.add_tablets(tablet);
+    }
 
     auto request = context_.coordinator_context().CreateUpdateTransactionState(&state);
     if (replicating_) {
@@ -438,6 +463,9 @@ class TransactionState {
 
     status_ = TransactionStatus::ABORTED;
     first_entry_raft_index_ = data.op_id.index();
+    for (const auto& tablet : data.state.tablets()) {
+      context_.NotifyCleanup({tablet, id_});
+    }
     NotifyAbortWaiters(TransactionStatusResult{status_});
     return Status::OK();
   }
@@ -521,12 +549,15 @@ struct PostponedLeaderActions {
   // List of tablets with transaction id, that should be notified that this transaction
   // is applying.
   std::vector<NotifyApplyingData> notify_applying;
+  // List of tablets with transaction id, that should remove intents of this aborted transaction.
+  std::vector<NotifyCleanupData> notify_cleanup;
   // List of update transaction records, that should be replicated via RAFT.
   std::vector<std::unique_ptr<UpdateTxnOperationState>> updates;
 
   void Swap(PostponedLeaderActions* other) {
     std::swap(leader, other->leader);
     notify_applying.swap(other->notify_applying);
+    notify_cleanup.swap(other->notify_cleanup);
     updates.swap(other->updates);
   }
 };
@@ -568,45 +599,72 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
     rpcs_.Shutdown();
   }
 
-  CHECKED_STATUS GetStatus(const std::string& transaction_id,
+  CHECKED_STATUS GetStatus(const google::protobuf::RepeatedPtrField<std::string>& transaction_ids,
                            tserver::GetTransactionStatusResponsePB* response) {
-    auto id = FullyDecodeTransactionId(transaction_id);
-    if (!id.ok()) {
-      return std::move(id.status());
+    std::vector<TransactionId> ids;
+    ids.reserve(transaction_ids.size());
+    for (const auto& transaction_id : transaction_ids) {
+      auto id = FullyDecodeTransactionId(transaction_id);
+      if (!id.ok()) {
+        return std::move(id.status());
+      }
+      ids.push_back(*id);
     }
 
     std::lock_guard<std::mutex> lock(managed_mutex_);
-    auto it = managed_transactions_.find(*id);
-    if (it == managed_transactions_.end()) {
-      response->set_status(TransactionStatus::ABORTED);
-      return Status::OK();
+    for (const auto& id : ids) {
+      auto it = managed_transactions_.find(id);
+      if (it == managed_transactions_.end()) {
+        response->add_status(TransactionStatus::ABORTED);
+        response->add_status_hybrid_time(HybridTime::kMax.ToUint64());
+        response->add_status_known(recently_aborted_ids_.count(id) != 0);
+      } else {
+        it->GetStatus(response);
+        response->add_status_known(true);
+      }
     }
-    return it->GetStatus(response);
+    return Status::OK();
   }
 
-  void Abort(const std::string& transaction_id, TransactionAbortCallback callback) {
+  void Abort(const std::string& transaction_id,
+             std::vector<TabletId> involved_tablets,
+             TransactionAbortCallback callback) {
     auto id = FullyDecodeTransactionId(transaction_id);
     if (!id.ok()) {
       callback(id.status());
       return;
     }
+    // Involved tablets are replicated with abort only to send them CLEANUP.
+    if (!GetAtomicFlag(&FLAGS_transaction_cleanup_aborted_intents)) {
+      involved_tablets.clear();
+    }
 
     PostponedLeaderActions actions;
     {
       std::unique_lock<std::mutex> lock(managed_mutex_);
+      postponed_leader_actions_.leader = true;
       auto it = managed_transactions_.find(*id);
       if (it == managed_transactions_.end()) {
+        // Transaction that was aborted before, e.g. because it expired.
+        if (recently_aborted_ids_.count(*id)) {
+          for (const auto& tablet : involved_tablets) {
+            NotifyCleanup({tablet, *id});
+          }
+        }
+        actions.Swap(&postponed_leader_actions_);
         lock.unlock();
+        ExecutePostponedLeaderActions(&actions);
         callback(TransactionStatusResult{TransactionStatus::ABORTED});
         return;
       }
-      postponed_leader_actions_.leader = true;
-      auto status = Modify(it).Abort(&callback);
+      auto status = Modify(it).Abort(&callback, involved_tablets);
+      actions.Swap(&postponed_leader_actions_);
       if (callback) {
+        lock.unlock();
+        ExecutePostponedLeaderActions(&actions);
         callback(TransactionStatusResult{status});
         return;
       }
-      actions.Swap(&postponed_leader_actions_);
     }
 
     ExecutePostponedLeaderActions(&actions);
@@ -637,6 +695,14 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
             data.state.tablets(0) });
     }
 
+    // CLEANUP is handled separately for the same reason.
+    if (data.state.status() == TransactionStatus::CLEANUP) {
+      DCHECK(transaction_participant_);
+      return transaction_participant_->ProcessCleanup(
+          { data.mode, data.applier, *id, data.op_id, HybridTime::kInvalid, data.hybrid_time,
+            TabletId() });
+    }
+
     PostponedLeaderActions actions;
     Status result;
     {
@@ -715,6 +781,11 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
       return;
     }
 
+    if (state.status() == TransactionStatus::CLEANUP) {
+      context_.SubmitUpdateTransaction(std::move(request));
+      return;
+    }
+
     PostponedLeaderActions actions;
     {
       std::unique_lock<std::mutex> lock(managed_mutex_);
@@ -789,34 +860,25 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
       return;
     }
 
-    if (!actions->notify_applying.empty()) {
-      auto deadline = TransactionRpcDeadline();
-      for (const auto& p : actions->notify_applying) {
-        tserver::UpdateTransactionRequestPB req;
-        req.set_tablet_id(p.tablet);
-        auto& state = *req.mutable_state();
-        state.set_transaction_id(p.transaction.begin(), p.transaction.size());
-        state.set_status(TransactionStatus::APPLYING);
-        state.add_tablets(context_.tablet_id());
-        state.set_commit_hybrid_time(p.commit_time.ToUint64());
-
-        auto handle = rpcs_.Prepare();
-        if (handle != rpcs_.InvalidHandle()) {
-          *handle = UpdateTransaction(
-              deadline,
-              nullptr /* remote_tablet */,
-              context_.client_future().get().get(),
-              &req,
-              [this, handle](const Status& status, HybridTime propagated_hybrid_time) {
-                if (propagated_hybrid_time.is_valid()) {
-                  context_.UpdateClock(propagated_hybrid_time);
-                }
-                rpcs_.Unregister(handle);
-                LOG_IF(WARNING, !status.ok()) << "Failed to send apply: " << status;
-              });
-          (**handle).SendRpc();
-        }
-      }
+    auto deadline = TransactionRpcDeadline();
+    for (const auto& p : actions->notify_applying) {
+      tserver::UpdateTransactionRequestPB req;
+      req.set_tablet_id(p.tablet);
+      auto& state = *req.mutable_state();
+      state.set_transaction_id(p.transaction.begin(), p.transaction.size());
+      state.set_status(TransactionStatus::APPLYING);
+      state.add_tablets(context_.tablet_id());
+      state.set_commit_hybrid_time(p.commit_time.ToUint64());
+      SendUpdateTransaction(deadline, &req);
+    }
+
+    for (const auto& p : actions->notify_cleanup) {
+      tserver::UpdateTransactionRequestPB req;
+      req.set_tablet_id(p.tablet);
+      auto& state = *req.mutable_state();
+      state.set_transaction_id(p.transaction.begin(), p.transaction.size());
+      state.set_status(TransactionStatus::CLEANUP);
+      SendUpdateTransaction(deadline, &req);
     }
 
     for (auto& update : actions->updates) {
@@ -824,6 +886,28 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
     }
   }
 
+  void SendUpdateTransaction(MonoTime deadline, tserver::UpdateTransactionRequestPB* req) {
+    auto handle = rpcs_.Prepare();
+    if (handle == rpcs_.InvalidHandle()) {
+      return;
+    }
+    auto status = req->state().status();
+    *handle = UpdateTransaction(
+        deadline,
+        nullptr /* remote_tablet */,
+        context_.client_future().get().get(),
+        req,
+        [this, handle, status](const Status& result, HybridTime propagated_hybrid_time) {
+          if (propagated_hybrid_time.is_valid()) {
+            context_.UpdateClock(propagated_hybrid_time);
+          }
+          rpcs_.Unregister(handle);
+          LOG_IF(WARNING, !result.ok())
+              << "Failed to send " << TransactionStatus_Name(status) << ": " << result;
+        });
+    (**handle).SendRpc();
+  }
+
   ManagedTransactions::iterator GetTransaction(const TransactionId& id,
                                                TransactionStatus status,
                                                HybridTime hybrid_time) {
@@ -845,6 +929,12 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
     postponed_leader_actions_.notify_applying.push_back(std::move(data));
   }
 
+  void NotifyCleanup(NotifyCleanupData data) override {
+    if (GetAtomicFlag(&FLAGS_transaction_cleanup_aborted_intents)) {
+      postponed_leader_actions_.notify_cleanup.push_back(std::move(data));
+    }
+  }
+
   MUST_USE_RESULT bool SubmitUpdateTransaction(
       std::unique_ptr<UpdateTxnOperationState> state) override {
     if (postponed_leader_actions_.leader) {
@@ -890,8 +980,16 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
 
       auto& index = managed_transactions_.get<LastTouchTag>();
 
+      while (!recently_aborted_.empty() &&
+             std::chrono::microseconds(now.PhysicalDiff(recently_aborted_.front().second)) >
+                 GetTransactionTimeout()) {
+        recently_aborted_ids_.erase(recently_aborted_.front().first);
+        recently_aborted_.pop_front();
+      }
+
       for (auto it = index.begin(); it != index.end() && it->ExpiredAt(now);) {
         if (it->status() == TransactionStatus::ABORTED) {
+          RememberAborted(it->id());
           it = index.erase(it);
         } else {
           bool modified = index.modify(it, [](TransactionState& state) {
@@ -916,10 +1014,19 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
       auto status = STATUS_FORMAT(Aborted, "Transaction completed: $0", *it);
       VLOG_WITH_PREFIX(1) << status;
       Modify(it).ClearRequests(status);
+      if (it->status() == TransactionStatus::ABORTED) {
+        RememberAborted(it->id());
+      }
       managed_transactions_.erase(it);
     }
   }
 
+  void RememberAborted(const TransactionId& id) {
+    if (recently_aborted_ids_.insert(id).second) {
+      recently_aborted_.emplace_back(id, context_.clock().Now());
+    }
+  }
+
   TransactionCoordinatorContext& context_;
   TransactionParticipant* transaction_participant_;
   Counter& expired_metric_;
@@ -928,6 +1035,12 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
   std::mutex managed_mutex_;
   ManagedTransactions managed_transactions_;
 
+  // Aborted transactions are removed from managed_transactions_ right away. They are remembered
+  // here, in order of removal, for the transaction timeout. So during this time their status is
+  // reported as known ABORTED, not just as unknown.
+  std::deque<std::pair<TransactionId, HybridTime>> recently_aborted_;
+  std::unordered_set<TransactionId, TransactionIdHash> recently_aborted_ids_;
+
   // Actions that should be executed after mutex is unlocked.
   PostponedLeaderActions postponed_leader_actions_;
 
@@ -981,14 +1094,16 @@ void TransactionCoordinator::Shutdown() {
   impl_->Shutdown();
 }
 
-Status TransactionCoordinator::GetStatus(const std::string& transaction_id,
-                                         tserver::GetTransactionStatusResponsePB* response) {
-  return impl_->GetStatus(transaction_id, response);
+Status TransactionCoordinator::GetStatus(
+    const google::protobuf::RepeatedPtrField<std::string>& transaction_ids,
+    tserver::GetTransactionStatusResponsePB* response) {
+  return impl_->GetStatus(transaction_ids, response);
 }
 
 void TransactionCoordinator::Abort(const std::string& transaction_id,
+                                   std::vector<TabletId> involved_tablets,
                                    TransactionAbortCallback callback) {
-  impl_->Abort(transaction_id, std::move(callback));
+  impl_->Abort(transaction_id, std::move(involved_tablets), std::move(callback));
 }
 
 } // namespace tablet
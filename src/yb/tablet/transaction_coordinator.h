@@ -18,6 +18,7 @@
 
 #include <future>
 #include <memory>
+#include <vector>
 
 #include "yb/client/client_fwd.h"
 
@@ -133,10 +134,15 @@ class TransactionCoordinator {
   // And like most of other Shutdowns in our codebase it wait until shutdown completes.
   void Shutdown();
 
-  CHECKED_STATUS GetStatus(const std::string& transaction_id,
+  // Fills the response with status of every transaction in transaction_ids, in the same order.
+  CHECKED_STATUS GetStatus(const google::protobuf::RepeatedPtrField<std::string>& transaction_ids,
                            tserver::GetTransactionStatusResponsePB* response);
 
-  void Abort(const std::string& transaction_id, TransactionAbortCallback callback);
+  // Aborts the transaction. involved_tablets are the tablets that could have received its intents.
+  // When transaction_cleanup_aborted_intents is set, they are notified to remove the intents.
+  void Abort(const std::string& transaction_id,
+             std::vector<TabletId> involved_tablets,
+             TransactionAbortCallback callback);
 
   // Returns count of managed transactions. Used in tests.
   size_t test_count_transactions() const;
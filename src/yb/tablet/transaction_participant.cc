@@ -16,6 +16,7 @@
 #include "yb/tablet/transaction_participant.h"
 
 #include <mutex>
+#include <unordered_map>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -37,7 +38,10 @@
 
 #include "yb/tserver/tserver_service.pb.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/locks.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 
 using namespace std::literals;
@@ -46,6 +50,14 @@ using namespace std::placeholders;
 DEFINE_uint64(transaction_delay_status_reply_usec_in_tests, 0,
               "For tests only. Delay handling status reply by specified amount of usec.");
 
+DEFINE_int32(transaction_status_max_batch_size, 500,
+             "Max number of transactions whose status is requested from a status tablet by a "
+             "single GetTransactionStatus RPC.");
+TAG_FLAG(transaction_status_max_batch_size, runtime);
+TAG_FLAG(transaction_status_max_batch_size, advanced);
+
+DECLARE_bool(transaction_cleanup_aborted_intents);
+
 namespace yb {
 namespace tablet {
 
@@ -116,24 +128,204 @@ class Delayer {
   std::deque<std::pair<MonoTime, std::function<void()>>> queue_;
 };
 
+// For how long to request status of single transactions after a status tablet was found to not
+// support batches, e.g. during a rolling upgrade.
+constexpr auto kSingleTransactionRequestsTime = 60s;
+
+// Invoked when status tablet reports that transaction is known to be aborted.
+typedef std::function<void(const TransactionId&)> TransactionAbortedCallback;
+
+// Resolves status of transactions of a participant. Status requests of transactions that use the
+// same status tablet are coalesced: there is at most one GetTransactionStatus RPC in flight per
+// status tablet, and requests that arrive while it is running are sent together by the next RPC.
+class TransactionStatusResolver {
+ public:
+  TransactionStatusResolver(rpc::Rpcs* rpcs,
+                            TransactionParticipantContext* context,
+                            Histogram* batch_size_metric,
+                            Histogram* resolution_latency_metric,
+                            TransactionAbortedCallback aborted_callback)
+      : rpcs_(*rpcs),
+        context_(*context),
+        batch_size_metric_(batch_size_metric),
+        resolution_latency_metric_(resolution_latency_metric),
+        aborted_callback_(std::move(aborted_callback)) {
+  }
+
+  void Request(client::YBClient* client,
+               const TabletId& status_tablet,
+               const TransactionId& id,
+               TransactionStatusCallback callback) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& queue = queues_.emplace(status_tablet, rpcs_.InvalidHandle()).first->second;
+      queue.waiters.push_back(Waiter{id, std::move(callback), MonoTime::Now()});
+      if (queue.in_flight) {
+        return;
+      }
+      queue.in_flight = true;
+    }
+    SendBatch(client, status_tablet);
+  }
+
+ private:
+  struct Waiter {
+    TransactionId id;
+    TransactionStatusCallback callback;
+    MonoTime start;
+  };
+
+  struct Queue {
+    explicit Queue(rpc::Rpcs::Handle invalid_handle) : handle(invalid_handle) {}
+
+    std::vector<Waiter> waiters;
+    bool in_flight = false;
+    rpc::Rpcs::Handle handle;
+    // Until this time, status of a single transaction is requested by every RPC, because the
+    // status tablet runs a version that does not support batches.
+    MonoTime single_transaction_until;
+  };
+
+  void SendBatch(client::YBClient* client, const TabletId& status_tablet) {
+    std::vector<Waiter> batch;
+    rpc::Rpcs::Handle* handle;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& queue = queues_.find(status_tablet)->second;
+      const bool single_transaction = queue.single_transaction_until.Initialized() &&
+                                      MonoTime::Now() < queue.single_transaction_until;
+      auto size = std::min<size_t>(
+          queue.waiters.size(),
+          single_transaction ? 1 : std::max(FLAGS_transaction_status_max_batch_size, 1));
+      batch.assign(std::make_move_iterator(queue.waiters.begin()),
+                   std::make_move_iterator(queue.waiters.begin() + size));
+      queue.waiters.erase(queue.waiters.begin(), queue.waiters.begin() + size);
+      handle = &queue.handle;
+    }
+
+    tserver::GetTransactionStatusRequestPB req;
+    req.set_tablet_id(status_tablet);
+    for (const auto& waiter : batch) {
+      req.add_transaction_id(waiter.id.begin(), waiter.id.size());
+    }
+    req.set_propagated_hybrid_time(context_.Now().ToUint64());
+    if (batch_size_metric_) {
+      batch_size_metric_->Increment(batch.size());
+    }
+    rpcs_.RegisterAndStart(
+        client::GetTransactionStatus(
+            TransactionRpcDeadline(),
+            nullptr /* tablet */,
+            client,
+            &req,
+            std::bind(&TransactionStatusResolver::StatusReceived, this, client, status_tablet,
+                      std::move(batch), _1, _2)),
+        handle);
+  }
+
+  void StatusReceived(client::YBClient* client,
+                      const TabletId& status_tablet,
+                      const std::vector<Waiter>& batch,
+                      Status status,
+                      const tserver::GetTransactionStatusResponsePB& response) {
+    if (response.has_propagated_hybrid_time()) {
+      context_.UpdateClock(HybridTime(response.propagated_hybrid_time()));
+    }
+
+    // A status tablet that does not support batches answers only for the last transaction of the
+    // request, so the transactions of the batch are requested again one by one.
+    const bool batch_not_supported =
+        status.ok() && batch.size() > 1 && response.status_size() == 1;
+
+    bool send_next_batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& queue = queues_.find(status_tablet)->second;
+      rpcs_.Unregister(&queue.handle);
+      if (batch_not_supported) {
+        queue.single_transaction_until = MonoTime::Now() + kSingleTransactionRequestsTime;
+        queue.waiters.insert(queue.waiters.begin(), batch.begin(), batch.end());
+      }
+      send_next_batch = !queue.waiters.empty();
+      queue.in_flight = send_next_batch;
+    }
+    if (batch_not_supported) {
+      YB_LOG_EVERY_N_SECS(INFO, 10) << "Status tablet " << status_tablet
+                                    << " does not support batches, requesting status of "
+                                    << batch.size() << " transactions one by one";
+    }
+    if (send_next_batch) {
+      SendBatch(client, status_tablet);
+    }
+    if (batch_not_supported) {
+      return;
+    }
+
+    // Older status tablets do not send hybrid time for an aborted transaction.
+    const bool missing_hybrid_time = batch.size() == 1 && response.status_size() == 1 &&
+                                     response.status_hybrid_time_size() == 0 &&
+                                     response.status(0) == TransactionStatus::ABORTED;
+    if (status.ok() && (static_cast<size_t>(response.status_size()) != batch.size() ||
+                        (static_cast<size_t>(response.status_hybrid_time_size()) != batch.size() &&
+                         !missing_hybrid_time))) {
+      status = STATUS_FORMAT(
+          IllegalState, "Wrong number of transaction statuses: $0 and $1, expected: $2",
+          response.status_size(), response.status_hybrid_time_size(), batch.size());
+    }
+    auto now = MonoTime::Now();
+    for (size_t i = 0; i != batch.size(); ++i) {
+      const auto& waiter = batch[i];
+      if (resolution_latency_metric_) {
+        resolution_latency_metric_->Increment(now.GetDeltaSince(waiter.start).ToMicroseconds());
+      }
+      if (!status.ok()) {
+        waiter.callback(status);
+        continue;
+      }
+      waiter.callback(TransactionStatusResult{
+          response.status(i),
+          missing_hybrid_time ? HybridTime::kMax : HybridTime(response.status_hybrid_time(i))});
+      // Unknown transaction is also reported as ABORTED, but it could be one that was committed
+      // and then forgotten by status tablet after apply. So callback is invoked only for known
+      // abort.
+      if (response.status(i) == TransactionStatus::ABORTED &&
+          static_cast<size_t>(response.status_known_size()) == batch.size() &&
+          response.status_known(i)) {
+        aborted_callback_(waiter.id);
+      }
+    }
+  }
+
+  rpc::Rpcs& rpcs_;
+  TransactionParticipantContext& context_;
+  Histogram* const batch_size_metric_;
+  Histogram* const resolution_latency_metric_;
+  TransactionAbortedCallback aborted_callback_;
+
+  std::mutex mutex_;
+  // Pending status requests by status tablet.
+  std::unordered_map<TabletId, Queue> queues_;
+};
+
 class RunningTransaction {
  public:
   RunningTransaction(TransactionMetadata metadata,
                      IntraTxnWriteId last_write_id,
                      rpc::Rpcs* rpcs,
                      TransactionParticipantContext* context,
+                     TransactionStatusResolver* status_resolver,
                      std::atomic<int64_t>* request_serial)
       : metadata_(std::move(metadata)),
         last_write_id_(last_write_id),
         rpcs_(*rpcs),
         context_(*context),
+        status_resolver_(*status_resolver),
         request_serial_(request_serial),
-        get_status_handle_(rpcs->InvalidHandle()),
         abort_handle_(rpcs->InvalidHandle()) {
   }
 
   ~RunningTransaction() {
-    rpcs_.Abort({&get_status_handle_, &abort_handle_});
+    rpcs_.Abort({&abort_handle_});
   }
 
   const TransactionId& id() const {
@@ -160,6 +352,20 @@ class RunningTransaction {
     local_commit_time_ = time;
   }
 
+  // Returns true when cleanup of intents of this aborted transaction should be requested, i.e. it
+  // was not requested yet and transaction was not applied.
+  bool StartCleanup() const {
+    if (cleanup_requested_ || local_commit_time_.is_valid()) {
+      return false;
+    }
+    cleanup_requested_ = true;
+    return true;
+  }
+
+  void CleanupFailed() const {
+    cleanup_requested_ = false;
+  }
+
   void RequestStatusAt(client::YBClient* client,
                        const StatusRequest& request,
                        std::unique_lock<std::mutex>* lock) const {
@@ -229,63 +435,42 @@ class RunningTransaction {
   }
 
   void SendStatusRequest(client::YBClient* client, std::mutex* mutex) const {
-    tserver::GetTransactionStatusRequestPB req;
-    req.set_tablet_id(metadata_.status_tablet);
-    req.set_transaction_id(metadata_.transaction_id.begin(), metadata_.transaction_id.size());
-    req.set_propagated_hybrid_time(context_.Now().ToUint64());
     int64_t serial_no = ++*request_serial_;
-    rpcs_.RegisterAndStart(
-        client::GetTransactionStatus(
-            TransactionRpcDeadline(),
-            nullptr /* tablet */,
-            client,
-            &req,
-            std::bind(&RunningTransaction::StatusReceived, this, client, _1, _2, serial_no, mutex)),
-        &get_status_handle_);
+    status_resolver_.Request(
+        client, metadata_.status_tablet, metadata_.transaction_id,
+        std::bind(&RunningTransaction::StatusReceived, this, client, _1, serial_no, mutex));
   }
 
   void StatusReceived(client::YBClient* client,
-                      const Status& status,
-                      const tserver::GetTransactionStatusResponsePB& response,
+                      const Result<TransactionStatusResult>& result,
                       int64_t serial_no,
                       std::mutex* mutex) const {
     auto delay_usec = FLAGS_transaction_delay_status_reply_usec_in_tests;
     if (delay_usec > 0) {
       delayer_.Delay(
           MonoTime::Now() + MonoDelta::FromMicroseconds(delay_usec),
-          std::bind(&RunningTransaction::DoStatusReceived, this, client, status, response,
-                    serial_no, mutex));
+          std::bind(&RunningTransaction::DoStatusReceived, this, client, result, serial_no, mutex));
     } else {
-      DoStatusReceived(client, status, response, serial_no, mutex);
+      DoStatusReceived(client, result, serial_no, mutex);
     }
   }
 
   void DoStatusReceived(client::YBClient* client,
-                        const Status& status,
-                        const tserver::GetTransactionStatusResponsePB& response,
+                        const Result<TransactionStatusResult>& result,
                         int64_t serial_no,
                         std::mutex* mutex) const {
-    if (response.has_propagated_hybrid_time()) {
-      context_.UpdateClock(HybridTime(response.propagated_hybrid_time()));
-    }
-
-    rpcs_.Unregister(&get_status_handle_);
     decltype(status_waiters_) status_waiters;
     HybridTime time;
     TransactionStatus transaction_status;
-    const bool ok = status.ok();
+    const bool ok = result.ok();
     bool send_new_request;
     {
       std::unique_lock<std::mutex> lock(*mutex);
       if (ok) {
-        DCHECK(response.has_status_hybrid_time() ||
-               response.status() == TransactionStatus::ABORTED);
-        time = response.has_status_hybrid_time()
-            ? HybridTime(response.status_hybrid_time())
-            : HybridTime::kMax;
+        time = result->status_time;
         if (last_known_status_hybrid_time_ <= time) {
           last_known_status_hybrid_time_ = time;
-          last_known_status_ = response.status();
+          last_known_status_ = result->status;
         }
         time = last_known_status_hybrid_time_;
         transaction_status = last_known_status_;
@@ -315,7 +500,7 @@ class RunningTransaction {
     }
     if (!ok) {
       for (const auto& waiter : status_waiters) {
-        waiter.callback(status);
+        waiter.callback(result.status());
       }
       return;
     }
@@ -379,15 +564,17 @@ class RunningTransaction {
   IntraTxnWriteId last_write_id_ = 0;
   rpc::Rpcs& rpcs_;
   TransactionParticipantContext& context_;
+  TransactionStatusResolver& status_resolver_;
   std::atomic<int64_t>* request_serial_;
   HybridTime local_commit_time_ = HybridTime::kInvalid;
 
   mutable TransactionStatus last_known_status_;
   mutable HybridTime last_known_status_hybrid_time_ = HybridTime::kMin;
   mutable std::vector<StatusRequest> status_waiters_;
-  mutable rpc::Rpcs::Handle get_status_handle_;
   mutable rpc::Rpcs::Handle abort_handle_;
   mutable std::vector<TransactionStatusCallback> abort_waiters_;
+  // Whether cleanup of intents was requested for this aborted transaction.
+  mutable bool cleanup_requested_ = false;
 
   // Used only in tests.
   mutable Delayer delayer_;
@@ -397,12 +584,20 @@ class RunningTransaction {
 
 class TransactionParticipant::Impl {
  public:
-  explicit Impl(TransactionParticipantContext* context)
-      : context_(*context), log_prefix_(context->tablet_id() + ": ") {}
+  Impl(TransactionParticipantContext* context,
+       Histogram* status_batch_size_metric,
+       Histogram* status_resolution_latency_metric)
+      : context_(*context),
+        log_prefix_(context->tablet_id() + ": "),
+        status_resolver_(
+            &rpcs_, context, status_batch_size_metric, status_resolution_latency_metric,
+            std::bind(&Impl::TransactionAborted, this, _1)) {}
 
   ~Impl() {
-    transactions_.clear();
+    // Status requests refer to running transactions, so should be completed before they are
+    // destroyed.
     rpcs_.Shutdown();
+    transactions_.clear();
   }
 
   // Adds new running transaction.
@@ -417,7 +612,8 @@ class TransactionParticipant::Impl {
       std::lock_guard<std::mutex> lock(mutex_);
       auto it = transactions_.find(metadata->transaction_id);
       if (it == transactions_.end()) {
-        transactions_.emplace(*metadata, 0, &rpcs_, &context_, &request_serial_);
+        transactions_.emplace(
+            *metadata, 0, &rpcs_, &context_, &status_resolver_, &request_serial_);
         store = true;
       } else {
         DCHECK_EQ(it->metadata(), *metadata);
@@ -551,6 +747,19 @@ class TransactionParticipant::Impl {
     return Status::OK();
   }
 
+  CHECKED_STATUS ProcessCleanup(const TransactionApplyData& data) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = FindOrLoad(data.transaction_id);
+      if (it != transactions_.end() && it->local_commit_time().is_valid()) {
+        LOG_WITH_PREFIX(DFATAL) << "Cleanup of applied transaction: " << data.transaction_id;
+        return Status::OK();
+      }
+    }
+
+    return data.applier->RemoveIntents(data);
+  }
+
   void SetDB(rocksdb::DB* db) {
     db_ = db;
   }
@@ -633,11 +842,62 @@ class TransactionParticipant::Impl {
     }
 
     it = transactions_.emplace(
-        std::move(*metadata), next_write_id, &rpcs_, &context_, &request_serial_).first;
+        std::move(*metadata), next_write_id, &rpcs_, &context_, &status_resolver_,
+        &request_serial_).first;
 
     return it;
   }
 
+  // Invoked when status tablet reports that transaction is known to be aborted.
+  // Intents of aborted transaction are never read, so they could be removed instead of waiting
+  // for compaction. Removal is replicated, so the tablet leader submits CLEANUP to its own RAFT
+  // log. Followers don't act on status they resolved, because they could lag behind the leader.
+  // Usually the status tablet already sent CLEANUP on abort, this covers tablets it did not know
+  // about, e.g. when transaction expired.
+  void TransactionAborted(const TransactionId& id) {
+    if (!GetAtomicFlag(&FLAGS_transaction_cleanup_aborted_intents) ||
+        context_.LeaderStatus() != consensus::Consensus::LeaderStatus::LEADER_AND_READY) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = transactions_.find(id);
+      if (it == transactions_.end() || !it->StartCleanup()) {
+        return;
+      }
+    }
+
+    tserver::UpdateTransactionRequestPB req;
+    req.set_tablet_id(context_.tablet_id());
+    auto& state = *req.mutable_state();
+    state.set_transaction_id(id.begin(), id.size());
+    state.set_status(TransactionStatus::CLEANUP);
+
+    auto handle = rpcs_.Prepare();
+    if (handle == rpcs_.InvalidHandle()) {
+      return;
+    }
+    *handle = UpdateTransaction(
+        TransactionRpcDeadline(),
+        nullptr /* remote_tablet */,
+        client(),
+        &req,
+        [this, handle, id](const Status& status, HybridTime propagated_hybrid_time) {
+          context_.UpdateClock(propagated_hybrid_time);
+          rpcs_.Unregister(handle);
+          if (!status.ok()) {
+            LOG_WITH_PREFIX(WARNING) << "Failed to request cleanup of " << id << ": " << status;
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = transactions_.find(id);
+            if (it != transactions_.end()) {
+              it->CleanupFailed();
+            }
+          }
+        });
+    (**handle).SendRpc();
+  }
+
   client::YBClient* client() const {
     return context_.client_future().get().get();
   }
@@ -652,12 +912,15 @@ class TransactionParticipant::Impl {
   rocksdb::DB* db_ = nullptr;
   std::mutex mutex_;
   rpc::Rpcs rpcs_;
+  TransactionStatusResolver status_resolver_;
   Transactions transactions_;
   std::atomic<int64_t> request_serial_{0};
 };
 
-TransactionParticipant::TransactionParticipant(TransactionParticipantContext* context)
-    : impl_(new Impl(context)) {
+TransactionParticipant::TransactionParticipant(TransactionParticipantContext* context,
+                                               Histogram* status_batch_size_metric,
+                                               Histogram* status_resolution_latency_metric)
+    : impl_(new Impl(context, status_batch_size_metric, status_resolution_latency_metric)) {
 }
 
 TransactionParticipant::~TransactionParticipant() {
@@ -703,6 +966,10 @@ CHECKED_STATUS TransactionParticipant::ProcessApply(const TransactionApplyData&
   return impl_->ProcessApply(data);
 }
 
+CHECKED_STATUS TransactionParticipant::ProcessCleanup(const TransactionApplyData& data) {
+  return impl_->ProcessCleanup(data);
+}
+
 void TransactionParticipant::SetDB(rocksdb::DB* db) {
   impl_->SetDB(db);
 }
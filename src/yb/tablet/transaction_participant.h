@@ -30,6 +30,7 @@
 
 #include "yb/server/server_fwd.h"
 
+#include "yb/consensus/consensus.h"
 #include "yb/consensus/opid_util.h"
 
 #include "yb/util/opid.pb.h"
@@ -44,6 +45,7 @@ class WriteBatch;
 
 namespace yb {
 
+class Histogram;
 class HybridTime;
 class TransactionMetadataPB;
 
@@ -62,10 +64,13 @@ struct TransactionApplyData {
   TabletId status_tablet;
 };
 
-// Interface to object that should apply intents in RocksDB when transaction is applying.
+// Interface to object that should apply intents in RocksDB when transaction is applying,
+// and remove them when transaction is aborted.
 class TransactionIntentApplier {
  public:
   virtual CHECKED_STATUS ApplyIntents(const TransactionApplyData& data) = 0;
+  // commit_ht and status_tablet of data are not used by removal.
+  virtual CHECKED_STATUS RemoveIntents(const TransactionApplyData& data) = 0;
 
  protected:
   ~TransactionIntentApplier() {}
@@ -78,6 +83,7 @@ class TransactionParticipantContext {
   virtual const server::ClockPtr& clock_ptr() const = 0;
   virtual HybridTime Now() = 0;
   virtual void UpdateClock(HybridTime hybrid_time) = 0;
+  virtual consensus::Consensus::LeaderStatus LeaderStatus() const = 0;
 
  protected:
   ~TransactionParticipantContext() {}
@@ -88,7 +94,11 @@ class TransactionParticipantContext {
 // instance per tablet.
 class TransactionParticipant : public TransactionStatusManager {
  public:
-  explicit TransactionParticipant(TransactionParticipantContext* context);
+  // Status requests of transactions are sent in batches, whose sizes are recorded to
+  // status_batch_size_metric. Metrics could be null.
+  TransactionParticipant(TransactionParticipantContext* context,
+                         Histogram* status_batch_size_metric,
+                         Histogram* status_resolution_latency_metric);
   virtual ~TransactionParticipant();
 
   // Adds new running transaction.
@@ -111,6 +121,9 @@ class TransactionParticipant : public TransactionStatusManager {
 
   CHECKED_STATUS ProcessApply(const TransactionApplyData& data);
 
+  // Removes intents of aborted transaction, when CLEANUP is replicated.
+  CHECKED_STATUS ProcessCleanup(const TransactionApplyData& data);
+
   void SetDB(rocksdb::DB* db);
 
   TransactionParticipantContext* context() const;
@@ -0,0 +1,141 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/memstore_flush_scheduler.h"
+
+#include "yb/util/size_literals.h"
+#include "yb/util/test_util.h"
+
+using namespace yb::size_literals;  // NOLINT.
+
+DECLARE_int32(memstore_flush_max_parallel);
+DECLARE_uint64(memstore_flush_max_bytes_per_round);
+DECLARE_int32(memstore_flush_target_percentage);
+
+namespace yb {
+namespace tserver {
+
+class MemStoreFlushSchedulerTest : public YBTest {
+ protected:
+  static MemStoreFlushCandidate Candidate(
+      uint64_t memstore_bytes, MonoDelta age = MonoDelta::kZero, int64_t retained_wal_ops = 0) {
+    MemStoreFlushCandidate result;
+    result.memstore_bytes = memstore_bytes;
+    result.age = age;
+    result.retained_wal_ops = retained_wal_ops;
+    return result;
+  }
+
+  static std::vector<uint64_t> Sizes(const std::vector<MemStoreFlushCandidate>& candidates) {
+    std::vector<uint64_t> result;
+    for (const auto& candidate : candidates) {
+      result.push_back(candidate.memstore_bytes);
+    }
+    return result;
+  }
+
+  MemStoreFlushScheduler scheduler_{nullptr};
+};
+
+TEST_F(MemStoreFlushSchedulerTest, NothingToFlushBelowLimit) {
+  auto picked = scheduler_.PickMemStoresToFlush(
+      {Candidate(64_MB)}, 50_MB, 100_MB, /* flushing_bytes */ 0, /* running_flushes */ 0);
+  ASSERT_TRUE(picked.empty());
+
+  picked = scheduler_.PickMemStoresToFlush(
+      {Candidate(64_MB)}, 50_MB, 100_MB, /* flushing_bytes */ 0, /* running_flushes */ 0,
+      /* force */ true);
+  ASSERT_EQ(std::vector<uint64_t>{64_MB}, Sizes(picked));
+}
+
+TEST_F(MemStoreFlushSchedulerTest, PrefersLargeMemStores) {
+  FLAGS_memstore_flush_target_percentage = 80;
+  // 100 MB over the target, so the two largest memstores are enough.
+  auto picked = scheduler_.PickMemStoresToFlush(
+      {Candidate(1_MB), Candidate(60_MB), Candidate(2_MB), Candidate(50_MB), Candidate(40_MB)},
+      900_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 0);
+  ASSERT_EQ((std::vector<uint64_t>{60_MB, 50_MB}), Sizes(picked));
+
+  // Memory of the flushes in progress is going to be freed anyway.
+  picked = scheduler_.PickMemStoresToFlush(
+      {Candidate(1_MB), Candidate(60_MB), Candidate(2_MB), Candidate(50_MB), Candidate(40_MB)},
+      900_MB, 1000_MB, /* flushing_bytes */ 80_MB, /* running_flushes */ 1);
+  ASSERT_EQ(std::vector<uint64_t>{60_MB}, Sizes(picked));
+}
+
+TEST_F(MemStoreFlushSchedulerTest, OldAndWalRetainingMemStoresAreBoosted) {
+  auto picked = scheduler_.PickMemStoresToFlush(
+      {Candidate(20_MB), Candidate(16_MB, MonoDelta::FromSeconds(3600)), Candidate(24_MB)},
+      1000_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 0);
+  ASSERT_EQ((std::vector<uint64_t>{16_MB, 24_MB, 20_MB}), Sizes(picked));
+
+  picked = scheduler_.PickMemStoresToFlush(
+      {Candidate(20_MB), Candidate(16_MB, MonoDelta::kZero, 1000000), Candidate(24_MB)},
+      1000_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 0);
+  ASSERT_EQ((std::vector<uint64_t>{16_MB, 24_MB, 20_MB}), Sizes(picked));
+}
+
+TEST_F(MemStoreFlushSchedulerTest, ParallelismAndIOBudget) {
+  FLAGS_memstore_flush_max_parallel = 3;
+  FLAGS_memstore_flush_max_bytes_per_round = 0;
+  std::vector<MemStoreFlushCandidate> candidates = {
+      Candidate(100_MB), Candidate(90_MB), Candidate(80_MB), Candidate(10_MB)};
+
+  auto picked = scheduler_.PickMemStoresToFlush(
+      candidates, 2000_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 0);
+  ASSERT_EQ((std::vector<uint64_t>{100_MB, 90_MB, 80_MB}), Sizes(picked));
+
+  picked = scheduler_.PickMemStoresToFlush(
+      candidates, 2000_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 2);
+  ASSERT_EQ(std::vector<uint64_t>{100_MB}, Sizes(picked));
+
+  picked = scheduler_.PickMemStoresToFlush(
+      candidates, 2000_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 3);
+  ASSERT_TRUE(picked.empty());
+
+  // Memstores that do not fit in the budget are skipped in favor of smaller ones.
+  FLAGS_memstore_flush_max_bytes_per_round = 150_MB;
+  picked = scheduler_.PickMemStoresToFlush(
+      candidates, 2000_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 0);
+  ASSERT_EQ((std::vector<uint64_t>{100_MB, 10_MB}), Sizes(picked));
+
+  // The best memstore is flushed even if it is larger than the budget.
+  FLAGS_memstore_flush_max_bytes_per_round = 50_MB;
+  picked = scheduler_.PickMemStoresToFlush(
+      candidates, 2000_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 0);
+  ASSERT_EQ(std::vector<uint64_t>{100_MB}, Sizes(picked));
+}
+
+// The regular memstore flushed along with an intents memstore counts towards the freed memory and
+// the IO budget.
+TEST_F(MemStoreFlushSchedulerTest, RegularMemStoreFlushedAlongWithIntents) {
+  FLAGS_memstore_flush_target_percentage = 80;
+  FLAGS_memstore_flush_max_bytes_per_round = 0;
+  auto intents = Candidate(30_MB);
+  intents.db = tablet::FlushFlags::kIntents;
+  intents.flushed_along_bytes = 50_MB;
+  std::vector<MemStoreFlushCandidate> candidates = {Candidate(60_MB), intents, Candidate(40_MB)};
+
+  // 70 MB over the target, freed by flushing the intents and the regular memstore of one tablet.
+  auto picked = scheduler_.PickMemStoresToFlush(
+      candidates, 870_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 0);
+  ASSERT_EQ(std::vector<uint64_t>{30_MB}, Sizes(picked));
+
+  FLAGS_memstore_flush_max_bytes_per_round = 100_MB;
+  picked = scheduler_.PickMemStoresToFlush(
+      candidates, 2000_MB, 1000_MB, /* flushing_bytes */ 0, /* running_flushes */ 0);
+  ASSERT_EQ(std::vector<uint64_t>{30_MB}, Sizes(picked));
+}
+
+}  // namespace tserver
+}  // namespace yb
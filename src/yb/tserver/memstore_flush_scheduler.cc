@@ -0,0 +1,181 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/memstore_flush_scheduler.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "yb/tablet/tablet_peer.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;  // NOLINT.
+
+DEFINE_int32(memstore_flush_max_parallel, 4,
+             "Maximum number of memstore flushes that the global memstore flush scheduler keeps "
+             "in progress at the same time.");
+TAG_FLAG(memstore_flush_max_parallel, runtime);
+
+DEFINE_uint64(memstore_flush_max_bytes_per_round, 512_MB,
+              "Maximum total size of the memstores that the global memstore flush scheduler "
+              "schedules for flush at once, which bounds the IO burst of a round. At least one "
+              "memstore is flushed per round regardless of its size. 0 for no limit.");
+TAG_FLAG(memstore_flush_max_bytes_per_round, runtime);
+
+DEFINE_int32(memstore_flush_target_percentage, 80,
+             "Once the global memstore limit is exceeded, memstores are flushed until the memstore "
+             "memory usage would fall to this percentage of the limit.");
+TAG_FLAG(memstore_flush_target_percentage, runtime);
+
+DEFINE_uint64(memstore_flush_file_overhead_bytes, 4_MB,
+              "Fixed IO cost of a memstore flush, in bytes, used by the global memstore flush "
+              "scheduler to prefer flushing large memstores over many small ones.");
+TAG_FLAG(memstore_flush_file_overhead_bytes, advanced);
+
+DEFINE_int32(memstore_flush_age_boost_secs, 600,
+             "The flush priority of a memstore grows by its size every this many seconds since "
+             "its oldest write, so that cold memstores get flushed eventually. 0 to disable.");
+TAG_FLAG(memstore_flush_age_boost_secs, advanced);
+
+DEFINE_int64(memstore_flush_wal_boost_ops, 100000,
+             "The flush priority of a memstore grows by its size for every this many WAL "
+             "operations that it keeps from being garbage collected. 0 to disable.");
+TAG_FLAG(memstore_flush_wal_boost_ops, advanced);
+
+METRIC_DEFINE_counter(server, memstore_flushes_scheduled,
+                      "Memstore Flushes Scheduled", yb::MetricUnit::kOperations,
+                      "Number of memstore flushes scheduled because the global memstore limit "
+                      "was exceeded.");
+METRIC_DEFINE_counter(server, memstore_flush_bytes_scheduled,
+                      "Memstore Bytes Scheduled For Flush", yb::MetricUnit::kBytes,
+                      "Total size of the memstores scheduled for flush because the global "
+                      "memstore limit was exceeded.");
+METRIC_DEFINE_histogram(server, memstore_flush_scheduled_size,
+                        "Size Of Memstores Scheduled For Flush", yb::MetricUnit::kBytes,
+                        "Size of the memstores chosen for flush by the global memstore flush "
+                        "scheduler.",
+                        16_GB, 2);
+METRIC_DEFINE_histogram(server, memstore_flush_scheduled_age,
+                        "Age Of Memstores Scheduled For Flush", yb::MetricUnit::kSeconds,
+                        "Time since the oldest write to the memstores chosen for flush by the "
+                        "global memstore flush scheduler.",
+                        7 * 24 * 3600, 2);
+
+namespace yb {
+namespace tserver {
+
+std::string MemStoreFlushCandidate::ToString() const {
+  return Format("{ tablet_id: $0 db: $1 memstore_bytes: $2 flushed_along_bytes: $3 age: $4 "
+                    "retained_wal_ops: $5 score: $6 }",
+                tablet_peer ? tablet_peer->tablet_id() : "<none>",
+                db == tablet::FlushFlags::kIntents ? "intents" : "regular", memstore_bytes,
+                flushed_along_bytes, age, retained_wal_ops, score);
+}
+
+MemStoreFlushScheduler::MemStoreFlushScheduler(
+    const scoped_refptr<MetricEntity>& metric_entity) {
+  if (metric_entity) {
+    flushes_scheduled_ = METRIC_memstore_flushes_scheduled.Instantiate(metric_entity);
+    flush_bytes_scheduled_ = METRIC_memstore_flush_bytes_scheduled.Instantiate(metric_entity);
+    flush_memstore_size_ = METRIC_memstore_flush_scheduled_size.Instantiate(metric_entity);
+    flush_memstore_age_ = METRIC_memstore_flush_scheduled_age.Instantiate(metric_entity);
+  }
+}
+
+double MemStoreFlushScheduler::Score(const MemStoreFlushCandidate& candidate) {
+  if (candidate.memstore_bytes == 0) {
+    return 0;
+  }
+  const double bytes = candidate.total_bytes();
+  // Memory freed per byte written by the flush.
+  const double efficiency = bytes / (bytes + FLAGS_memstore_flush_file_overhead_bytes);
+  double boost = 1;
+  if (FLAGS_memstore_flush_age_boost_secs > 0) {
+    boost += candidate.age.ToSeconds() / FLAGS_memstore_flush_age_boost_secs;
+  }
+  if (FLAGS_memstore_flush_wal_boost_ops > 0) {
+    boost += static_cast<double>(candidate.retained_wal_ops) / FLAGS_memstore_flush_wal_boost_ops;
+  }
+  return bytes * efficiency * boost;
+}
+
+std::vector<MemStoreFlushCandidate> MemStoreFlushScheduler::PickMemStoresToFlush(
+    std::vector<MemStoreFlushCandidate> candidates, uint64_t memory_usage, uint64_t memory_limit,
+    uint64_t flushing_bytes, size_t running_flushes, bool force) {
+  std::vector<MemStoreFlushCandidate> result;
+
+  const uint64_t target_usage = memory_limit * FLAGS_memstore_flush_target_percentage / 100;
+  uint64_t bytes_to_free = memory_usage > target_usage ? memory_usage - target_usage : 0;
+  // Memory of the memstores being flushed is freed without further flushes.
+  bytes_to_free = bytes_to_free > flushing_bytes ? bytes_to_free - flushing_bytes : 0;
+  if (bytes_to_free == 0 && !force) {
+    return result;
+  }
+
+  const size_t max_parallel = std::max(FLAGS_memstore_flush_max_parallel, 1);
+  size_t max_flushes = max_parallel > running_flushes ? max_parallel - running_flushes : 0;
+  if (max_flushes == 0) {
+    if (!force) {
+      VLOG(2) << "Memstore flushes in progress: " << running_flushes << ", not scheduling more";
+      return result;
+    }
+    max_flushes = 1;
+  }
+
+  for (auto& candidate : candidates) {
+    candidate.score = Score(candidate);
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const MemStoreFlushCandidate& lhs, const MemStoreFlushCandidate& rhs) {
+    return lhs.score > rhs.score;
+  });
+
+  const uint64_t max_bytes = FLAGS_memstore_flush_max_bytes_per_round;
+  uint64_t scheduled_bytes = 0;
+  std::unordered_set<const tablet::TabletPeer*> picked_tablets;
+  for (auto& candidate : candidates) {
+    if (result.size() >= max_flushes || (!result.empty() && scheduled_bytes >= bytes_to_free)) {
+      break;
+    }
+    if (candidate.memstore_bytes == 0) {
+      continue;
+    }
+    const auto bytes = candidate.total_bytes();
+    // A smaller memstore further down the list might still fit in the budget.
+    if (max_bytes != 0 && !result.empty() && scheduled_bytes + bytes > max_bytes) {
+      continue;
+    }
+    // The other memstore of an already picked tablet is either flushed along with it, or has a
+    // lower score and waits for the next round.
+    if (candidate.tablet_peer && !picked_tablets.insert(candidate.tablet_peer.get()).second) {
+      continue;
+    }
+    scheduled_bytes += bytes;
+    VLOG(1) << "Scheduling memstore flush: " << candidate.ToString();
+    if (flushes_scheduled_) {
+      flushes_scheduled_->Increment();
+      flush_bytes_scheduled_->IncrementBy(bytes);
+      flush_memstore_size_->Increment(bytes);
+      flush_memstore_age_->Increment(candidate.age.ToSeconds());
+    }
+    result.push_back(std::move(candidate));
+  }
+
+  return result;
+}
+
+}  // namespace tserver
+}  // namespace yb
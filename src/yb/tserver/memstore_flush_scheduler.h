@@ -0,0 +1,103 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_MEMSTORE_FLUSH_SCHEDULER_H_
+#define YB_TSERVER_MEMSTORE_FLUSH_SCHEDULER_H_
+
+#include <memory>
+#include <vector>
+
+#include "yb/tablet/tablet.h"
+
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+
+namespace tablet {
+
+class TabletPeer;
+
+}
+
+namespace tserver {
+
+// The memstore of one RocksDB instance of a tablet, considered for a flush when the memstores of
+// the server use more memory than the global memstore limit.
+struct MemStoreFlushCandidate {
+  std::shared_ptr<tablet::TabletPeer> tablet_peer;
+
+  // The RocksDB instance: FlushFlags::kRegular or FlushFlags::kIntents.
+  tablet::FlushFlags db = tablet::FlushFlags::kRegular;
+
+  // Memory freed by flushing the memstore.
+  uint64_t memstore_bytes = 0;
+
+  // Memory of the regular memstore of the tablet, which is flushed along with its intents memstore.
+  uint64_t flushed_along_bytes = 0;
+
+  // Time since the oldest write to the memstore.
+  MonoDelta age = MonoDelta::kZero;
+
+  // Number of WAL operations that the RocksDB instance did not persist yet, i.e. that the WAL has
+  // to retain until the memstore is flushed.
+  int64_t retained_wal_ops = 0;
+
+  // Flush priority, set by MemStoreFlushScheduler.
+  double score = 0;
+
+  // Memory freed by the flush, including the memstores flushed along.
+  uint64_t total_bytes() const { return memstore_bytes + flushed_along_bytes; }
+
+  std::string ToString() const;
+};
+
+// Chooses which memstores to flush to bring the memstore memory of the server back under the
+// global limit.
+//
+// Every memstore is scored by the memory its flush frees per byte of IO, since a flush writes the
+// memstore plus a fixed per-file cost that tiny memstores mostly pay for nothing. The score is
+// boosted for old memstores and for memstores that retain a lot of WAL, so that large cold
+// tablets do not stay resident forever while hot ones keep being flushed into small files. The
+// best memstores are flushed in parallel until enough memory will be freed, within a limit on
+// the number of flushes in progress and on the bytes written per scheduling round. At most one
+// memstore is picked per tablet, since a flush of the intents memstore also flushes the regular
+// one.
+class MemStoreFlushScheduler {
+ public:
+  explicit MemStoreFlushScheduler(const scoped_refptr<MetricEntity>& metric_entity);
+
+  // Returns the memstores to flush, best first, out of the given candidates.
+  //
+  // memory_usage and memory_limit are the global memstore usage and limit. flushing_bytes is the
+  // memory of the memstores already being flushed, which is going to be freed anyway, and
+  // running_flushes is the number of those flushes. With force, at least one memstore is flushed
+  // even if the usage is below the limit.
+  std::vector<MemStoreFlushCandidate> PickMemStoresToFlush(
+      std::vector<MemStoreFlushCandidate> candidates, uint64_t memory_usage,
+      uint64_t memory_limit, uint64_t flushing_bytes, size_t running_flushes, bool force = false);
+
+  // Computes the flush priority of the given memstore.
+  static double Score(const MemStoreFlushCandidate& candidate);
+
+ private:
+  scoped_refptr<Counter> flushes_scheduled_;
+  scoped_refptr<Counter> flush_bytes_scheduled_;
+  scoped_refptr<Histogram> flush_memstore_size_;
+  scoped_refptr<Histogram> flush_memstore_age_;
+};
+
+}  // namespace tserver
+}  // namespace yb
+
+#endif  // YB_TSERVER_MEMSTORE_FLUSH_SCHEDULER_H_
@@ -32,6 +32,9 @@
 
 #include "yb/tserver/remote_bootstrap_client.h"
 
+#include <deque>
+
+#include <boost/scope_exit.hpp>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -44,6 +47,8 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/strings/util.h"
 #include "yb/gutil/walltime.h"
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/rate_limiter.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/tablet/tablet.pb.h"
@@ -55,6 +60,7 @@
 #include "yb/tserver/remote_bootstrap.proxy.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crc.h"
 #include "yb/util/env.h"
 #include "yb/util/env_util.h"
@@ -63,6 +69,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 
 using namespace yb::size_literals;
 
@@ -96,9 +103,36 @@ DEFINE_test_flag(double, fault_crash_bootstrap_client_before_changing_role, 0.0,
                  "a ChangeConfig request to change this tserver role *(from PRE_VOTER or "
                  "PRE_OBSERVER to VOTER or OBSERVER respectively).");
 
-DEFINE_int32(remote_bootstrap_max_chunk_size, 1_MB,
+DEFINE_int32(remote_bootstrap_max_chunk_size, 8_MB,
              "Maximum chunk size to be transferred at a time during remote bootstrap.");
 
+DEFINE_int32(remote_bootstrap_min_chunk_size, 1_MB,
+             "Minimum and initial chunk size to be transferred at a time during remote bootstrap. "
+             "The chunk size grows up to --remote_bootstrap_max_chunk_size while chunks are "
+             "fetched faster than --remote_bootstrap_chunk_target_latency_ms, and shrinks back "
+             "when they are fetched slower than twice that.");
+TAG_FLAG(remote_bootstrap_min_chunk_size, advanced);
+
+DEFINE_int32(remote_bootstrap_chunk_target_latency_ms, 500,
+             "Target time to fetch one chunk during remote bootstrap, used to adapt the chunk "
+             "size.");
+TAG_FLAG(remote_bootstrap_chunk_target_latency_ms, advanced);
+
+DEFINE_int32(remote_bootstrap_max_concurrent_files, 4,
+             "Maximum number of files downloaded in parallel by a remote bootstrap session.");
+TAG_FLAG(remote_bootstrap_max_concurrent_files, advanced);
+
+DEFINE_int32(remote_bootstrap_max_chunks_in_flight_per_file, 4,
+             "Maximum number of chunks of a file requested ahead of the one being written "
+             "during remote bootstrap.");
+TAG_FLAG(remote_bootstrap_max_chunks_in_flight_per_file, advanced);
+
+DEFINE_int64(remote_bootstrap_rate_limit_bytes_per_sec, 0,
+             "Maximum rate at which a tablet server downloads data for remote bootstrap, shared "
+             "by all its remote bootstrap sessions. 0 for no limit.");
+TAG_FLAG(remote_bootstrap_rate_limit_bytes_per_sec, advanced);
+TAG_FLAG(remote_bootstrap_rate_limit_bytes_per_sec, runtime);
+
 // RETURN_NOT_OK_PREPEND() with a remote-error unwinding step.
 #define RETURN_NOT_OK_UNWIND_PREPEND(status, controller, msg) \
   RETURN_NOT_OK_PREPEND(UnwindRemoteError(status, controller), msg)
@@ -126,6 +160,46 @@ using tablet::TabletSuperBlockPB;
 
 constexpr int kBytesReservedForMessageHeaders = 16384;
 
+namespace {
+
+// Returns the rate limiter shared by all remote bootstrap sessions of this process, or nullptr if
+// remote bootstrap is not rate limited.
+rocksdb::RateLimiter* SharedRateLimiter() {
+  static std::mutex mutex;
+  static std::unique_ptr<rocksdb::RateLimiter> rate_limiter;
+  static int64_t rate_bytes_per_sec = 0;
+
+  const int64_t new_rate_bytes_per_sec = FLAGS_remote_bootstrap_rate_limit_bytes_per_sec;
+  if (new_rate_bytes_per_sec <= 0) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!rate_limiter) {
+    rate_limiter.reset(rocksdb::NewGenericRateLimiter(new_rate_bytes_per_sec));
+  } else if (rate_bytes_per_sec != new_rate_bytes_per_sec) {
+    rate_limiter->SetBytesPerSecond(new_rate_bytes_per_sec);
+  }
+  rate_bytes_per_sec = new_rate_bytes_per_sec;
+  return rate_limiter.get();
+}
+
+// Blocks until the given number of downloaded bytes fits within the remote bootstrap rate limit.
+void ThrottleDownload(int64_t bytes) {
+  auto* rate_limiter = SharedRateLimiter();
+  if (rate_limiter == nullptr) {
+    return;
+  }
+  // The rate limiter only grants up to a single burst at a time.
+  const int64_t burst = rate_limiter->GetSingleBurstBytes();
+  while (bytes > 0) {
+    const int64_t request = std::min(bytes, burst);
+    rate_limiter->Request(request, rocksdb::Env::IO_LOW);
+    bytes -= request;
+  }
+}
+
+} // namespace
+
 RemoteBootstrapClient::RemoteBootstrapClient(std::string tablet_id,
                                              FsManager* fs_manager,
                                              string client_permanent_uuid)
@@ -140,7 +214,8 @@ RemoteBootstrapClient::RemoteBootstrapClient(std::string tablet_id,
       status_listener_(nullptr),
       session_idle_timeout_millis_(0),
       start_time_micros_(0),
-      succeeded_(false) {}
+      succeeded_(false),
+      chunk_size_(FLAGS_remote_bootstrap_min_chunk_size) {}
 
 RemoteBootstrapClient::~RemoteBootstrapClient() {
   // Note: Ending the remote bootstrap session releases anchors on the remote.
@@ -206,6 +281,9 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
   BeginRemoteBootstrapSessionRequestPB req;
   req.set_requestor_uuid(permanent_uuid_);
   req.set_tablet_id(tablet_id_);
+  if (replace_tombstoned_tablet_) {
+    RETURN_NOT_OK(FindTombstonedFiles());
+  }
 
   rpc::RpcController controller;
   controller.set_timeout(MonoDelta::FromMilliseconds(
@@ -348,8 +426,13 @@ Status RemoteBootstrapClient::FetchAll(TabletStatusListener* status_listener) {
   status_listener_ = CHECK_NOTNULL(status_listener);
 
   VLOG_WITH_PREFIX(2) << "Fetching table_type: " << TableType_Name(meta_->table_type());
+  const MonoTime start = MonoTime::Now();
   RETURN_NOT_OK(DownloadRocksDBFiles());
   RETURN_NOT_OK(DownloadWALs());
+
+  const double elapsed_sec = std::max((MonoTime::Now() - start).ToSeconds(), 1e-6);
+  LOG_WITH_PREFIX(INFO) << "Downloaded " << downloaded_bytes() << " bytes in " << elapsed_sec
+                        << " s (" << downloaded_bytes() / elapsed_sec / 1_MB << " MB/s)";
   return Status::OK();
 }
 
@@ -515,13 +598,17 @@ Status RemoteBootstrapClient::DownloadWALs() {
   // Download the WAL segments.
   int num_segments = wal_seqnos_.size();
   LOG_WITH_PREFIX(INFO) << "Starting download of " << num_segments << " WAL segments...";
-  uint64_t counter = 0;
-  for (uint64_t seg_seqno : wal_seqnos_) {
-    UpdateStatusMessage(Substitute("Downloading WAL segment with seq. number $0 ($1/$2)",
-                                   seg_seqno, counter + 1, num_segments));
-    RETURN_NOT_OK(DownloadWAL(seg_seqno));
-    ++counter;
+  std::vector<std::function<Status()>> downloads;
+  downloads.reserve(num_segments);
+  for (int i = 0; i != num_segments; ++i) {
+    const uint64_t seg_seqno = wal_seqnos_[i];
+    downloads.push_back([this, seg_seqno, i, num_segments] {
+      UpdateStatusMessage(Substitute("Downloading WAL segment with seq. number $0 ($1/$2)",
+                                     seg_seqno, i + 1, num_segments));
+      return DownloadWAL(seg_seqno);
+    });
   }
+  RETURN_NOT_OK(DownloadInParallel(downloads));
 
   downloaded_wal_ = true;
   return Status::OK();
@@ -532,21 +619,6 @@ Status RemoteBootstrapClient::DownloadFile(
   auto file_path = JoinPathSegments(dir, file_pb.name());
   RETURN_NOT_OK(fs_manager_->env()->CreateDirs(DirName(file_path)));
 
-  if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
-      VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = fs_manager_->env()->LinkFile(it->second, file_path);
-      if (link_status.ok()) {
-        return Status::OK();
-      }
-      // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
-                             << ": " << link_status;
-    }
-  }
-
   WritableFileOptions opts;
   opts.sync_on_close = true;
   gscoped_ptr<WritableFile> file;
@@ -558,13 +630,134 @@ Status RemoteBootstrapClient::DownloadFile(
                                DataIdPB::IdType_Name(data_id->type()), file_path));
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
-  if (file_pb.inode() != 0) {
-    inode2file_.emplace(file_pb.inode(), file_path);
+  return Status::OK();
+}
+
+Status RemoteBootstrapClient::FindTombstonedFiles() {
+  auto* env = fs_manager_->env();
+  auto dir = meta_->rocksdb_dir() + tablet::kTombstonedDBSuffix;
+  if (!env->FileExists(dir)) {
+    return Status::OK();
   }
 
+  std::vector<std::string> files;
+  RETURN_NOT_OK(env->GetChildren(dir, ExcludeDots::kTrue, &files));
+  for (const auto& file : files) {
+    auto path = JoinPathSegments(dir, file);
+    if (VERIFY_RESULT(env->IsDirectory(path))) {
+      continue;
+    }
+    tombstoned_file_sizes_.emplace(file, VERIFY_RESULT(env->GetFileSize(path)));
+  }
+  LOG_WITH_PREFIX(INFO) << "Found " << tombstoned_file_sizes_.size()
+                        << " RocksDB files of the tombstoned replica in " << dir;
+  tombstoned_rocksdb_dir_ = std::move(dir);
   return Status::OK();
 }
 
+Result<uint32_t> RemoteBootstrapClient::FetchRemoteFileCrc32c(const tablet::FilePB& file_pb) {
+  FetchDataRequestPB req;
+  req.set_session_id(session_id_);
+  req.mutable_data_id()->set_type(DataIdPB::ROCKSDB_FILE);
+  req.mutable_data_id()->set_file_name(file_pb.name());
+  req.set_file_crc32c_only(true);
+
+  FetchDataResponsePB resp;
+  rpc::RpcController controller;
+  controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
+  RETURN_NOT_OK_UNWIND_PREPEND(proxy_->FetchData(req, &resp, &controller), controller,
+                               "Unable to fetch checksum from remote");
+  if (!resp.chunk().has_file_crc32c()) {
+    return STATUS_FORMAT(NotSupported, "Remote did not send checksum of $0", file_pb.name());
+  }
+  return resp.chunk().file_crc32c();
+}
+
+Result<bool> RemoteBootstrapClient::ReuseTombstonedFile(
+    const tablet::FilePB& file_pb, const std::string& dir) {
+  // Only the files that match a retained one by name and size are checksummed, on both sides.
+  auto size_it = tombstoned_file_sizes_.find(file_pb.name());
+  if (size_it == tombstoned_file_sizes_.end() || size_it->second != file_pb.size_bytes()) {
+    return false;
+  }
+  auto remote_crc32c = FetchRemoteFileCrc32c(file_pb);
+  if (!remote_crc32c.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Unable to get checksum of remote file " << file_pb.name() << ": "
+                             << remote_crc32c.status();
+    return false;
+  }
+  auto* env = fs_manager_->env();
+  auto tombstoned_path = JoinPathSegments(tombstoned_rocksdb_dir_, file_pb.name());
+  auto crc32c = env_util::Crc32cOfFile(env, tombstoned_path);
+  if (!crc32c.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Unable to checksum " << tombstoned_path << ": "
+                             << crc32c.status();
+    return false;
+  }
+  if (*crc32c != *remote_crc32c) {
+    VLOG_WITH_PREFIX(2) << "Tombstoned file " << tombstoned_path << " differs from the remote one";
+    return false;
+  }
+
+  auto file_path = JoinPathSegments(dir, file_pb.name());
+  RETURN_NOT_OK(env->CreateDirs(DirName(file_path)));
+  auto link_status = env->LinkFile(tombstoned_path, file_path);
+  if (!link_status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to link file: " << file_path << " => " << tombstoned_path
+                             << ": " << link_status;
+    return false;
+  }
+  VLOG_WITH_PREFIX(2) << "Reused file " << file_path << " of the tombstoned replica";
+  reused_files_.fetch_add(1, std::memory_order_acq_rel);
+  reused_bytes_.fetch_add(file_pb.size_bytes(), std::memory_order_acq_rel);
+  return true;
+}
+
+Status RemoteBootstrapClient::DownloadInParallel(
+    const std::vector<std::function<Status()>>& downloads) {
+  const int max_threads = std::max(
+      1, std::min<int>(FLAGS_remote_bootstrap_max_concurrent_files, downloads.size()));
+  if (max_threads == 1) {
+    for (const auto& download : downloads) {
+      RETURN_NOT_OK(download());
+    }
+    return Status::OK();
+  }
+
+  std::unique_ptr<ThreadPool> pool;
+  RETURN_NOT_OK(ThreadPoolBuilder("rb-download")
+                    .set_min_threads(0)
+                    .set_max_threads(max_threads)
+                    .Build(&pool));
+
+  std::mutex mutex;
+  Status result;
+  // Once a download has failed, the ones that did not start yet are skipped.
+  std::atomic<bool> failed(false);
+  for (const auto& download : downloads) {
+    Status s = pool->SubmitFunc([&download, &mutex, &result, &failed] {
+      if (failed.load(std::memory_order_acquire)) {
+        return;
+      }
+      Status status = download();
+      if (!status.ok()) {
+        failed.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (result.ok()) {
+          result = std::move(status);
+        }
+      }
+    });
+    if (!s.ok()) {
+      pool->Wait();
+      return s;
+    }
+  }
+  pool->Wait();
+  pool->Shutdown();
+  return result;
+}
+
 Status RemoteBootstrapClient::CreateTabletDirectories(const string& db_dir, FsManager* fs) {
   // Create the directory table-uuid first.
   RETURN_NOT_OK_PREPEND(fs->CreateDirIfMissing(DirName(db_dir)),
@@ -586,10 +779,48 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   RETURN_NOT_OK(CreateTabletDirectories(rocksdb_dir, meta_->fs_manager()));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::ROCKSDB_FILE);
+  // Files that share an inode with another file of the checkpoint are downloaded once, then
+  // hard linked. The others are downloaded in parallel.
+  std::vector<std::function<Status()>> downloads;
+  std::vector<std::pair<const tablet::FilePB*, std::string>> links;
   for (auto const& file_pb : new_sb->rocksdb_files()) {
-    RETURN_NOT_OK(DownloadFile(file_pb, rocksdb_dir, &data_id));
+    if (file_pb.inode() != 0) {
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        links.emplace_back(&file_pb, it->second);
+        continue;
+      }
+      inode2file_.emplace(file_pb.inode(), JoinPathSegments(rocksdb_dir, file_pb.name()));
+    }
+    downloads.push_back([this, &file_pb, &rocksdb_dir]() -> Status {
+      if (VERIFY_RESULT(ReuseTombstonedFile(file_pb, rocksdb_dir))) {
+        return Status::OK();
+      }
+      DataIdPB data_id;
+      data_id.set_type(DataIdPB::ROCKSDB_FILE);
+      return DownloadFile(file_pb, rocksdb_dir, &data_id);
+    });
+  }
+  RETURN_NOT_OK(DownloadInParallel(downloads));
+  if (!tombstoned_rocksdb_dir_.empty()) {
+    LOG_WITH_PREFIX(INFO) << "Reused " << reused_files_.load(std::memory_order_acquire)
+                          << " files (" << reused_bytes() << " bytes) of the tombstoned replica";
+  }
+
+  for (const auto& link : links) {
+    const auto& file_pb = *link.first;
+    auto file_path = JoinPathSegments(rocksdb_dir, file_pb.name());
+    VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
+                        << " => " << link.second;
+    RETURN_NOT_OK(fs_manager_->env()->CreateDirs(DirName(file_path)));
+    auto link_status = fs_manager_->env()->LinkFile(link.second, file_path);
+    if (!link_status.ok()) {
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << link.second
+                             << ": " << link_status;
+      DataIdPB data_id;
+      data_id.set_type(DataIdPB::ROCKSDB_FILE);
+      RETURN_NOT_OK(DownloadFile(file_pb, rocksdb_dir, &data_id));
+    }
   }
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
@@ -599,6 +830,12 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
     LOG(INFO) << "Moving intents DB: " << intents_tmp_dir << " => " << intents_dir;
     RETURN_NOT_OK(fs_manager_->env()->RenameFile(intents_tmp_dir, intents_dir));
   }
+  // The reused files are hard linked, so the rest of the tombstoned replica can go.
+  if (!tombstoned_rocksdb_dir_.empty()) {
+    WARN_NOT_OK(fs_manager_->env()->DeleteRecursively(tombstoned_rocksdb_dir_),
+                Format("Unable to delete tombstoned RocksDB files in $0", tombstoned_rocksdb_dir_));
+    tombstoned_rocksdb_dir_.clear();
+  }
   new_superblock_.swap(new_sb);
   downloaded_rocksdb_files_ = true;
   return Status::OK();
@@ -671,42 +908,126 @@ Status RemoteBootstrapClient::DownloadBlock(const BlockId& old_block_id,
 template<class Appendable>
 Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
                                            Appendable* appendable) {
-  uint64_t offset = 0;
-  int32_t max_length = std::min(FLAGS_remote_bootstrap_max_chunk_size,
-                                FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
-
-  rpc::RpcController controller;
-  controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
-  FetchDataRequestPB req;
+  // A chunk requested from the remote. Several chunks of the file are requested ahead of the one
+  // being written, and written in order as they arrive.
+  struct ChunkFetch {
+    FetchDataRequestPB req;
+    FetchDataResponsePB resp;
+    rpc::RpcController controller;
+    CountDownLatch latch{1};
+    // The chunk size of the session when the chunk was requested.
+    int64_t chunk_size;
+    MonoTime start;
+  };
+
+  const int64_t max_message_length =
+      FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders;
+  const size_t max_in_flight = std::max(FLAGS_remote_bootstrap_max_chunks_in_flight_per_file, 1);
+
+  std::deque<std::unique_ptr<ChunkFetch>> fetches;
+  // Wait for the chunks still in flight when returning early, since their responses are written
+  // into the fetches.
+  BOOST_SCOPE_EXIT_TPL(&fetches) {
+    for (auto& fetch : fetches) {
+      fetch->latch.Wait();
+    }
+  } BOOST_SCOPE_EXIT_END;
 
-  bool done = false;
-  while (!done) {
-    controller.Reset();
-    req.set_session_id(session_id_);
-    req.mutable_data_id()->CopyFrom(data_id);
-    req.set_offset(offset);
-    req.set_max_length(max_length);
+  uint64_t offset = 0;
+  uint64_t next_offset = 0;
+  // The length of the data is not known until the first chunk arrives, so until then only the
+  // first chunk is requested.
+  int64_t total_data_length = -1;
+  for (;;) {
+    while (fetches.size() < max_in_flight &&
+           (total_data_length < 0 ? next_offset == 0
+                                  : next_offset < static_cast<uint64_t>(total_data_length))) {
+      const int64_t chunk_size = chunk_size_.load(std::memory_order_acquire);
+      int64_t max_length = std::min(chunk_size, max_message_length);
+      if (total_data_length >= 0) {
+        max_length = std::min<int64_t>(max_length, total_data_length - next_offset);
+      }
+      fetches.emplace_back(new ChunkFetch);
+      auto* fetch = fetches.back().get();
+      fetch->chunk_size = chunk_size;
+      fetch->req.set_session_id(session_id_);
+      fetch->req.mutable_data_id()->CopyFrom(data_id);
+      fetch->req.set_offset(next_offset);
+      fetch->req.set_max_length(max_length);
+      fetch->controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
+      fetch->start = MonoTime::Now();
+      proxy_->FetchDataAsync(fetch->req, &fetch->resp, &fetch->controller,
+                             [fetch] { fetch->latch.CountDown(); });
+      next_offset += max_length;
+    }
+    if (fetches.empty()) {
+      break;
+    }
 
-    FetchDataResponsePB resp;
-    RETURN_NOT_OK_UNWIND_PREPEND(proxy_->FetchData(req, &resp, &controller),
-                                controller,
-                                "Unable to fetch data from remote");
+    auto& fetch = *fetches.front();
+    fetch.latch.Wait();
+    RETURN_NOT_OK_UNWIND_PREPEND(fetch.controller.status(),
+                                 fetch.controller,
+                                 "Unable to fetch data from remote");
+    const auto& chunk = fetch.resp.chunk();
     // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
+    RETURN_NOT_OK_PREPEND(VerifyData(offset, chunk),
                           Substitute("Error validating data item $0", data_id.ShortDebugString()));
+    if (static_cast<int64_t>(chunk.data().size()) == fetch.chunk_size) {
+      // Only full chunks tell how fast chunks of the current size are fetched.
+      AdjustChunkSize(fetch.chunk_size, MonoTime::Now() - fetch.start);
+    }
+    ThrottleDownload(chunk.data().size());
 
     // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
+    RETURN_NOT_OK(appendable->Append(chunk.data()));
 
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
-      done = true;
+    offset += chunk.data().size();
+    downloaded_bytes_.fetch_add(chunk.data().size(), std::memory_order_acq_rel);
+    if (total_data_length < 0) {
+      total_data_length = chunk.total_data_length();
+    }
+    const bool short_chunk =
+        static_cast<int64_t>(chunk.data().size()) < fetch.req.max_length();
+    fetches.pop_front();
+
+    // The remote could send less than asked for, e.g. when its own rpc_max_message_size is lower.
+    // Then the chunks requested after this one start at wrong offsets, so they are dropped, and
+    // the rest of the data is requested right after what was received.
+    if (short_chunk && next_offset != offset) {
+      for (auto& dropped_fetch : fetches) {
+        dropped_fetch->latch.Wait();
+      }
+      fetches.clear();
+      next_offset = offset;
     }
-    offset += resp.chunk().data().size();
   }
 
+  if (offset != static_cast<uint64_t>(total_data_length)) {
+    return STATUS(Corruption, "Downloaded data size does not match the data length",
+                  Substitute("$0 vs $1", offset, total_data_length));
+  }
   return Status::OK();
 }
 
+void RemoteBootstrapClient::AdjustChunkSize(int64_t chunk_size, MonoDelta latency) {
+  const int64_t min_chunk_size = FLAGS_remote_bootstrap_min_chunk_size;
+  const int64_t max_chunk_size = std::max<int64_t>(FLAGS_remote_bootstrap_max_chunk_size,
+                                                   min_chunk_size);
+  const int64_t target_latency_ms = FLAGS_remote_bootstrap_chunk_target_latency_ms;
+  int64_t new_chunk_size;
+  if (latency.ToMilliseconds() < target_latency_ms) {
+    new_chunk_size = std::min(chunk_size * 2, max_chunk_size);
+  } else if (latency.ToMilliseconds() > target_latency_ms * 2) {
+    new_chunk_size = std::max(chunk_size / 2, min_chunk_size);
+  } else {
+    return;
+  }
+  // Only adjust from the chunk size that was measured, the other downloads may already have
+  // changed it.
+  chunk_size_.compare_exchange_strong(chunk_size, new_chunk_size, std::memory_order_acq_rel);
+}
+
 Status RemoteBootstrapClient::VerifyData(uint64_t offset, const DataChunkPB& chunk) {
   // Verify the offset is what we expected.
   if (offset != chunk.offset()) {
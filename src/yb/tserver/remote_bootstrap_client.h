@@ -32,6 +32,8 @@
 #ifndef YB_TSERVER_REMOTE_BOOTSTRAP_CLIENT_H
 #define YB_TSERVER_REMOTE_BOOTSTRAP_CLIENT_H
 
+#include <atomic>
+#include <functional>
 #include <string>
 #include <memory>
 #include <vector>
@@ -45,6 +47,8 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/tserver/remote_bootstrap.pb.h"
+#include "yb/util/monotime.h"
+#include "yb/util/result.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -77,8 +81,10 @@ class TSTabletManager;
 // Client class for using remote bootstrap to copy a tablet from another host.
 // This class is not thread-safe.
 //
-// TODO:
-// * Parallelize download of blocks and WAL segments.
+// Up to --remote_bootstrap_max_concurrent_files files are downloaded in parallel, and each file is
+// fetched with several chunk requests in flight. The chunk size adapts to how fast chunks are
+// fetched, and the download rate of all the sessions of the process can be limited with
+// --remote_bootstrap_rate_limit_bytes_per_sec.
 //
 class RemoteBootstrapClient {
  public:
@@ -131,9 +137,21 @@ class RemoteBootstrapClient {
   CHECKED_STATUS VerifyChangeRoleSucceeded(
       const std::shared_ptr<consensus::Consensus>& shared_consensus);
 
+  // Number of bytes of data downloaded by this session.
+  uint64_t downloaded_bytes() const {
+    return downloaded_bytes_.load(std::memory_order_acquire);
+  }
+
+  // Number of bytes of RocksDB files reused from the tombstoned replica instead of downloaded.
+  uint64_t reused_bytes() const {
+    return reused_bytes_.load(std::memory_order_acquire);
+  }
+
  protected:
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestBeginEndSession);
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadWithChunksCappedByRemote);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestReuseTombstonedFiles);
 
   // Extract the embedded Status message from the given ErrorStatusPB.
   // The given ErrorStatusPB must extend RemoteBootstrapErrorPB.
@@ -149,7 +167,7 @@ class RemoteBootstrapClient {
   // End the remote bootstrap session.
   CHECKED_STATUS EndRemoteSession();
 
-  // Download all WAL files sequentially.
+  // Download all WAL files.
   CHECKED_STATUS DownloadWALs();
 
   // Download a single WAL file.
@@ -177,6 +195,14 @@ class RemoteBootstrapClient {
   template<class Appendable>
   CHECKED_STATUS DownloadFile(const DataIdPB& data_id, Appendable* appendable);
 
+  // Run the given downloads, up to --remote_bootstrap_max_concurrent_files at a time. Returns the
+  // first error, after which the downloads that did not start yet are skipped.
+  CHECKED_STATUS DownloadInParallel(const std::vector<std::function<Status()>>& downloads);
+
+  // Grow or shrink the chunk size of the session depending on the time it took to fetch a chunk
+  // of the given size.
+  void AdjustChunkSize(int64_t chunk_size, MonoDelta latency);
+
   virtual CHECKED_STATUS CreateTabletDirectories(const string& db_dir, FsManager* fs);
 
   CHECKED_STATUS DownloadRocksDBFiles();
@@ -186,6 +212,16 @@ class RemoteBootstrapClient {
   CHECKED_STATUS DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
+  // Find the RocksDB files retained by the tombstoned replica being replaced, if any.
+  CHECKED_STATUS FindTombstonedFiles();
+
+  // Get the CRC32C of the whole remote RocksDB file.
+  Result<uint32_t> FetchRemoteFileCrc32c(const tablet::FilePB& file_pb);
+
+  // Hard link the file retained by the tombstoned replica into 'dir' if it is identical to the
+  // remote one. Returns false if the file needs to be downloaded.
+  Result<bool> ReuseTombstonedFile(const tablet::FilePB& file_pb, const std::string& dir);
+
   // Return standard log prefix.
   std::string LogPrefix();
 
@@ -225,6 +261,18 @@ class RemoteBootstrapClient {
   // EndRemoteBootstrapSessionRequestPB request.
   bool succeeded_;
 
+  // Size of the chunks requested from the remote, shared by the parallel downloads.
+  std::atomic<int64_t> chunk_size_;
+
+  std::atomic<uint64_t> downloaded_bytes_{0};
+
+  // Directory of the RocksDB files retained by the tombstoned replica being replaced, if any.
+  std::string tombstoned_rocksdb_dir_;
+  // Sizes of the files in tombstoned_rocksdb_dir_, by name.
+  std::unordered_map<std::string, uint64_t> tombstoned_file_sizes_;
+  std::atomic<size_t> reused_files_{0};
+  std::atomic<uint64_t> reused_bytes_{0};
+
  private:
   std::unordered_map<uint64_t, std::string> inode2file_;
 
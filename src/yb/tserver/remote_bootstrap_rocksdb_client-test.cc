@@ -14,7 +14,19 @@
 #include <algorithm>
 
 #include "yb/tserver/remote_bootstrap_client-test.h"
+#include "yb/util/size_literals.h"
 
+using namespace yb::size_literals;
+
+DEFINE_int32(remote_bootstrap_benchmark_num_rows, 100000,
+             "Number of rows to write to the tablet before benchmarking remote bootstrap.");
+
+DECLARE_int32(remote_bootstrap_max_chunk_size);
+DECLARE_int32(remote_bootstrap_min_chunk_size);
+DECLARE_int32(remote_bootstrap_max_concurrent_files);
+DECLARE_int32(remote_bootstrap_max_chunks_in_flight_per_file);
+DECLARE_int64(remote_bootstrap_session_max_chunk_size);
+DECLARE_bool(retain_tombstoned_rocksdb_files);
 
 using std::shared_ptr;
 
@@ -33,19 +45,13 @@ class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
   void SetUp() override {
     RemoteBootstrapClientTest::SetUp();
   }
-};
 
-// Basic begin / end remote bootstrap session.
-TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
-  TabletStatusListener listener(meta_);
-  ASSERT_OK(client_->FetchAll(&listener));
-  ASSERT_OK(client_->Finish());
-}
+ protected:
+  // Verify that the client has the same RocksDB files that the leader has.
+  void VerifyRocksDBFiles();
+};
 
-// Basic RocksDB files download unit test.
-TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
-  TabletStatusListener listener(meta_);
-  ASSERT_OK(client_->DownloadRocksDBFiles());
+void RemoteBootstrapRocksDBClientTest::VerifyRocksDBFiles() {
   auto tablet_peer_checkpoint_dir = tablet_peer_->tablet()->GetLastRocksDBCheckpointDirForTest();
 
   vector<std::string> rocksdb_files;
@@ -58,7 +64,6 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size());
   std::sort(rocksdb_files.begin(), rocksdb_files.end());
   std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
-  // Verify that the client has the same files that the leader has.
   for (int i = 0; i < rocksdb_files.size(); ++i) {
     auto local_rocksdb_file = rocksdb_files[i];
     auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
@@ -78,5 +83,108 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   }
 }
 
+// Basic begin / end remote bootstrap session.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->FetchAll(&listener));
+  ASSERT_OK(client_->Finish());
+}
+
+// Basic RocksDB files download unit test.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  ASSERT_NO_FATALS(VerifyRocksDBFiles());
+}
+
+// The remote sends smaller chunks than requested, while several chunks of each file are in flight.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadWithChunksCappedByRemote) {
+  FLAGS_remote_bootstrap_max_chunks_in_flight_per_file = 4;
+  FLAGS_remote_bootstrap_session_max_chunk_size = 3000;
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  ASSERT_NO_FATALS(VerifyRocksDBFiles());
+}
+
+// Bootstrap a replica again after tombstoning it: its SST files are hard linked, not downloaded.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestReuseTombstonedFiles) {
+  FLAGS_retain_tombstoned_rocksdb_files = true;
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->FetchAll(&listener));
+  ASSERT_OK(client_->Finish());
+  ASSERT_EQ(0, client_->reused_bytes());
+  const auto full_download_bytes = client_->downloaded_bytes();
+
+  auto term = client_->remote_committed_cstate_->current_term();
+  client_.reset();
+  ASSERT_OK(meta_->DeleteTabletData(tablet::TABLET_DATA_TOMBSTONED, yb::OpId()));
+  ASSERT_TRUE(fs_manager_->env()->FileExists(meta_->rocksdb_dir() + tablet::kTombstonedDBSuffix));
+
+  client_.reset(new RemoteBootstrapClient(GetTabletId(), fs_manager_.get(), fs_manager_->uuid()));
+  ASSERT_OK(client_->SetTabletToReplace(meta_, term));
+  HostPort host_port = HostPortFromPB(leader_.last_known_addr());
+  ASSERT_OK(client_->Start(leader_.permanent_uuid(), proxy_cache_.get(), host_port, &meta_));
+  TabletStatusListener new_listener(meta_);
+  ASSERT_OK(client_->FetchAll(&new_listener));
+  ASSERT_OK(client_->Finish());
+
+  LOG(INFO) << "Downloaded " << client_->downloaded_bytes() << " bytes, reused "
+            << client_->reused_bytes() << " bytes, instead of " << full_download_bytes;
+  ASSERT_GT(client_->reused_bytes(), 0);
+  ASSERT_LT(client_->downloaded_bytes(), full_download_bytes);
+  ASSERT_FALSE(fs_manager_->env()->FileExists(meta_->rocksdb_dir() + tablet::kTombstonedDBSuffix));
+  ASSERT_NO_FATALS(VerifyRocksDBFiles());
+}
+
+// Compare the throughput of sequential chunk by chunk downloads with parallel, pipelined ones.
+TEST_F(RemoteBootstrapRocksDBClientTest, BenchmarkParallelDownload) {
+  constexpr int kNumFlushes = 4;
+  const int rows_per_flush = FLAGS_remote_bootstrap_benchmark_num_rows / kNumFlushes;
+  LOG_TIMING(INFO, "Loading benchmark data") {
+    for (int i = 0; i != kNumFlushes; ++i) {
+      InsertTestRowsDirect(1000 + i * rows_per_flush, rows_per_flush);
+      ASSERT_OK(tablet_peer_->tablet()->Flush(tablet::FlushMode::kSync));
+    }
+  }
+
+  struct DownloadMode {
+    const char* name;
+    int max_concurrent_files;
+    int max_chunks_in_flight_per_file;
+    int min_chunk_size;
+    int max_chunk_size;
+  };
+  const DownloadMode kModes[] = {
+    { "sequential", 1, 1, 1_MB, 1_MB },
+    { "parallel", 4, 4, 1_MB, 8_MB },
+  };
+
+  for (const auto& mode : kModes) {
+    FLAGS_remote_bootstrap_max_concurrent_files = mode.max_concurrent_files;
+    FLAGS_remote_bootstrap_max_chunks_in_flight_per_file = mode.max_chunks_in_flight_per_file;
+    FLAGS_remote_bootstrap_min_chunk_size = mode.min_chunk_size;
+    FLAGS_remote_bootstrap_max_chunk_size = mode.max_chunk_size;
+
+    // Bootstrap a new replica from scratch with a new session.
+    client_.reset();
+    fs_manager_.reset(new FsManager(
+        Env::Default(), GetTestPath(Format("client_tablet_$0", mode.name)), "tserver_test"));
+    ASSERT_OK(fs_manager_->CreateInitialFileSystemLayout());
+    ASSERT_OK(fs_manager_->Open());
+    ASSERT_NO_FATALS(SetUpRemoteBootstrapClient());
+
+    TabletStatusListener listener(meta_);
+    const MonoTime start = MonoTime::Now();
+    ASSERT_OK(client_->FetchAll(&listener));
+    const double elapsed_sec = std::max((MonoTime::Now() - start).ToSeconds(), 1e-6);
+    LOG(INFO) << "Remote bootstrap " << mode.name << ": " << client_->downloaded_bytes()
+              << " bytes in " << elapsed_sec << " s, "
+              << client_->downloaded_bytes() / elapsed_sec / 1_MB << " MB/s";
+
+    ASSERT_OK(client_->Finish());
+    ASSERT_NO_FATALS(VerifyRocksDBFiles());
+  }
+}
+
 } // namespace tserver
 } // namespace yb
@@ -288,9 +288,23 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   DataChunkPB* data_chunk = resp->mutable_chunk();
   string* data = data_chunk->mutable_data();
   int64_t total_data_length = 0;
-  RPC_RETURN_NOT_OK(GetDataFilePiece(data_id, session, offset, client_maxlen, data,
-                                     &total_data_length, &error_code),
-                    error_code, "Unable to get piece of data file");
+  if (req->file_crc32c_only()) {
+    if (data_id.type() != DataIdPB::ROCKSDB_FILE) {
+      RPC_RETURN_APP_ERROR(RemoteBootstrapErrorPB::INVALID_REMOTE_BOOTSTRAP_REQUEST,
+                           "Invalid DataId",
+                           STATUS(InvalidArgument, "Only RocksDB files can be checksummed",
+                                  data_id.ShortDebugString()));
+    }
+    uint32_t file_crc32c = 0;
+    RPC_RETURN_NOT_OK(session->GetRocksDBFileCrc32c(data_id.file_name(), &file_crc32c,
+                                                    &total_data_length, &error_code),
+                      error_code, "Unable to checksum RocksDB file");
+    data_chunk->set_file_crc32c(file_crc32c);
+  } else {
+    RPC_RETURN_NOT_OK(GetDataFilePiece(data_id, session, offset, client_maxlen, data,
+                                       &total_data_length, &error_code),
+                      error_code, "Unable to get piece of data file");
+  }
 
   data_chunk->set_total_data_length(total_data_length);
   data_chunk->set_offset(offset);
@@ -43,11 +43,17 @@
 #include "yb/server/metadata.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
+#include "yb/util/env_util.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
 
 DECLARE_int32(rpc_max_message_size);
 
+DEFINE_test_flag(int64, remote_bootstrap_session_max_chunk_size, 0,
+                 "When positive, data chunks sent by remote bootstrap sessions are limited to this "
+                 "size, as if the server had a lower rpc_max_message_size.");
+
 namespace yb {
 namespace tserver {
 
@@ -308,6 +314,9 @@ static int64_t DetermineReadLength(int64_t bytes_remaining, int64_t requested_le
   // The min of the {requested, system} maxes is the effective max.
   int64_t maxlen = (requested_len > 0) ? std::min<int64_t>(requested_len, system_max_chunk_size) :
                                         system_max_chunk_size;
+  if (PREDICT_FALSE(FLAGS_remote_bootstrap_session_max_chunk_size > 0)) {
+    maxlen = std::min(maxlen, FLAGS_remote_bootstrap_session_max_chunk_size);
+  }
   return std::min(bytes_remaining, maxlen);
 }
 
@@ -421,6 +430,21 @@ Status RemoteBootstrapSession::GetRocksDBFilePiece(const std::string file_name,
       checkpoint_dir_, file_name, offset, client_maxlen, data, log_file_size, error_code);
 }
 
+Status RemoteBootstrapSession::GetRocksDBFileCrc32c(const std::string& file_name,
+                                                    uint32_t* crc32c, int64_t* file_size,
+                                                    RemoteBootstrapErrorPB::Code* error_code) {
+  // Like GetFilePiece(), does not take session_lock_: reading the whole file may take a while.
+  auto file_path = JoinPathSegments(checkpoint_dir_, file_name);
+  if (!fs_manager_->env()->FileExists(file_path)) {
+    *error_code = RemoteBootstrapErrorPB::ROCKSDB_FILE_NOT_FOUND;
+    return STATUS(NotFound, Substitute("Unable to find RocksDB file $0 in directory $1",
+                                       file_name, checkpoint_dir_));
+  }
+  *file_size = VERIFY_RESULT(fs_manager_->env()->GetFileSize(file_path));
+  *crc32c = VERIFY_RESULT(env_util::Crc32cOfFile(fs_manager_->env(), file_path));
+  return Status::OK();
+}
+
 Status RemoteBootstrapSession::GetFilePiece(const std::string path,
                                             const std::string file_name,
                                             uint64_t offset, int64_t client_maxlen,
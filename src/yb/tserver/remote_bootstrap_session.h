@@ -143,6 +143,11 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
       const std::string file_name, uint64_t offset, int64_t client_maxlen,
       std::string* data, int64_t* log_file_size, RemoteBootstrapErrorPB::Code* error_code);
 
+  // Get the CRC32C and the size of a whole RocksDB checkpoint file.
+  CHECKED_STATUS GetRocksDBFileCrc32c(
+      const std::string& file_name, uint32_t* crc32c, int64_t* file_size,
+      RemoteBootstrapErrorPB::Code* error_code);
+
   // Get a piece of a RocksDB file.
   // The behavior and params are very similar to GetBlockPiece(), but this one
   // is only for sending rocksdb files.
@@ -121,6 +121,8 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
 
   const scoped_refptr<MetricEntity>& MetricEnt() const override { return metric_entity(); }
 
+  std::shared_ptr<TabletServerServiceProxy> LocalProxy() const override { return proxy_; }
+
   CHECKED_STATUS PopulateLiveTServers(const master::TSHeartbeatResponsePB& heartbeat_resp);
 
   CHECKED_STATUS GetLiveTServers(std::vector<master::TSInformationPB> *live_tservers) const {
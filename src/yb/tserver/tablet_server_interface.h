@@ -21,6 +21,8 @@
 namespace yb {
 namespace tserver {
 
+class TabletServerServiceProxy;
+
 class TabletServerIf {
  public:
 
@@ -30,6 +32,9 @@ class TabletServerIf {
 
   virtual server::Clock* Clock() = 0;
   virtual const scoped_refptr<MetricEntity>& MetricEnt() const = 0;
+
+  // Returns the proxy to call the tablet server service of this server locally, if there is one.
+  virtual std::shared_ptr<TabletServerServiceProxy> LocalProxy() const { return nullptr; }
 };
 
 } // namespace tserver
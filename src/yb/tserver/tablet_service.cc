@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -136,6 +137,7 @@ DEFINE_test_flag(bool, assert_reads_served_by_follower, false, "If set, we verif
                  "for the tablet");
 
 DECLARE_uint64(max_clock_skew_usec);
+DECLARE_bool(leader_read_safe_time_per_key);
 
 namespace yb {
 namespace tserver {
@@ -206,6 +208,54 @@ Status GetTabletRef(const TabletPeerPtr& tablet_peer,
   return Status::OK();
 }
 
+// Collects results of transaction heartbeats received in one UpdateTransaction request, and
+// responds when all of them are processed.
+class HeartbeatsCompletion {
+ public:
+  HeartbeatsCompletion(rpc::RpcContext context,
+                       UpdateTransactionResponsePB* response,
+                       const server::ClockPtr& clock,
+                       size_t num_heartbeats)
+      : context_(std::move(context)), response_(response), clock_(clock),
+        left_(num_heartbeats) {
+    for (size_t i = 0; i != num_heartbeats; ++i) {
+      response_->add_heartbeat_status();
+    }
+  }
+
+  void Completed(size_t idx, const Status& status) {
+    StatusToPB(status, response_->mutable_heartbeat_status(idx));
+    if (left_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      response_->set_propagated_hybrid_time(clock_->Now().ToUint64());
+      context_.RespondSuccess();
+    }
+  }
+
+ private:
+  rpc::RpcContext context_;
+  UpdateTransactionResponsePB* const response_;
+  server::ClockPtr clock_;
+  std::atomic<size_t> left_;
+};
+
+class HeartbeatCompletionCallback : public tablet::OperationCompletionCallback {
+ public:
+  HeartbeatCompletionCallback(std::shared_ptr<HeartbeatsCompletion> completion, size_t idx)
+      : completion_(std::move(completion)), idx_(idx) {}
+
+  void OperationCompleted() override {
+    bool expected = false;
+    if (responded_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+      completion_->Completed(idx_, status_);
+    }
+  }
+
+ private:
+  std::shared_ptr<HeartbeatsCompletion> completion_;
+  const size_t idx_;
+  std::atomic<bool> responded_{false};
+};
+
 } // namespace
 
 // Prepares modification operation, checks limits, fetches tablet_peer and tablet etc.
@@ -462,6 +512,31 @@ void TabletServiceImpl::UpdateTransaction(const UpdateTransactionRequestPB* req,
     return;
   }
 
+  if (req->heartbeat_transaction_ids_size() != 0) {
+    // Heartbeats are handled as separate operations, that are replicated together by the group
+    // replication of the tablet.
+    auto* coordinator = tablet_peer->tablet()->transaction_coordinator();
+    auto completion = std::make_shared<HeartbeatsCompletion>(
+        std::move(context), resp, server_->Clock(), req->heartbeat_transaction_ids_size());
+    for (int i = 0; i != req->heartbeat_transaction_ids_size(); ++i) {
+      const auto& transaction_id = req->heartbeat_transaction_ids(i);
+      auto id = FullyDecodeTransactionId(transaction_id);
+      if (!id.ok()) {
+        completion->Completed(i, id.status());
+        continue;
+      }
+      tserver::TransactionStatePB heartbeat;
+      heartbeat.set_transaction_id(transaction_id);
+      heartbeat.set_status(TransactionStatus::PENDING);
+      auto state = std::make_unique<tablet::UpdateTxnOperationState>(tablet_peer->tablet());
+      state->TakeRequest(&heartbeat);
+      state->set_completion_callback(std::make_unique<HeartbeatCompletionCallback>(
+          completion, i));
+      coordinator->Handle(std::move(state));
+    }
+    return;
+  }
+
   auto state = std::make_unique<tablet::UpdateTxnOperationState>(tablet_peer->tablet(),
                                                                  &req->state());
   state->set_completion_callback(MakeRpcOperationCompletionCallback(
@@ -517,6 +592,7 @@ void TabletServiceImpl::AbortTransaction(const AbortTransactionRequestPB* req,
   auto context_ptr = std::make_shared<rpc::RpcContext>(std::move(context));
   tablet_peer->tablet()->transaction_coordinator()->Abort(
       req->transaction_id(),
+      std::vector<TabletId>(req->involved_tablets().begin(), req->involved_tablets().end()),
       [resp, context_ptr, clock](Result<TransactionStatusResult> result) {
         resp->set_propagated_hybrid_time(clock->Now().ToUint64());
         if (result.ok()) {
@@ -905,6 +981,40 @@ bool TabletServiceImpl::DoGetTabletOrRespond(const Req* req, Resp* resp, rpc::Rp
   return true;
 }
 
+namespace {
+
+// Fills hashed_keys with the hashed key parts of the documents read by the request. Returns false
+// if some of the reads are not limited to a single hash key.
+bool ReadHashedKeys(
+    const tablet::AbstractTablet& tablet, const ReadRequestPB& req,
+    std::vector<std::string>* hashed_keys) {
+  auto add = [hashed_keys](std::string hashed_key) {
+    if (hashed_key.empty()) {
+      return false;
+    }
+    hashed_keys->push_back(std::move(hashed_key));
+    return true;
+  };
+  for (const auto& redis_read_req : req.redis_batch()) {
+    if (!add(tablet::AbstractTablet::ReadHashedKey(redis_read_req))) {
+      return false;
+    }
+  }
+  for (const auto& ql_read_req : req.ql_batch()) {
+    if (!add(tablet.ReadHashedKey(ql_read_req))) {
+      return false;
+    }
+  }
+  for (const auto& pgsql_read_req : req.pgsql_batch()) {
+    if (!add(tablet.ReadHashedKey(pgsql_read_req))) {
+      return false;
+    }
+  }
+  return !hashed_keys->empty();
+}
+
+} // namespace
+
 void TabletServiceImpl::Read(const ReadRequestPB* req,
                              ReadResponsePB* resp,
                              rpc::RpcContext context) {
@@ -939,8 +1049,14 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   bool allow_retry = !read_time;
   tablet::RequireLease require_lease(req->consistency_level() == YBConsistencyLevel::STRONG);
   bool transactional = tablet->SchemaRef().table_properties().is_transactional();
+  // Strongly consistent reads of single hash keys don't wait for in-flight writes of other keys.
+  std::vector<std::string> hashed_keys;
+  const std::vector<std::string>* read_hashed_keys =
+      require_lease && FLAGS_leader_read_safe_time_per_key &&
+      ReadHashedKeys(*tablet, *req, &hashed_keys) ? &hashed_keys : nullptr;
   if (!read_time) {
-    safe_ht_to_read = tablet->SafeTime(require_lease);
+    safe_ht_to_read = tablet->SafeTime(
+        require_lease, HybridTime::kMin, MonoTime::kMax, read_hashed_keys);
     // If the read time is not specified, then it is non transactional read.
     // So we should restart it in server in case of failure.
     read_time.read = safe_ht_to_read;
@@ -954,7 +1070,8 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
       read_time.global_limit = read_time.read;
     }
   } else {
-    safe_ht_to_read = tablet->SafeTime(require_lease, read_time.read, context.GetClientDeadline());
+    safe_ht_to_read = tablet->SafeTime(
+        require_lease, read_time.read, context.GetClientDeadline(), read_hashed_keys);
     if (!safe_ht_to_read.is_valid()) { // Timed out
       SetupErrorAndRespond(resp->mutable_error(), STATUS(TimedOut, ""),
                            TabletServerErrorPB::UNKNOWN_ERROR, &context);
@@ -1016,6 +1133,110 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   TRACE("Done Read");
 }
 
+namespace {
+
+// Executes the reads of a MultiRead call as local Read calls to this server, so every read goes
+// through the regular read path, and the reads run in parallel on the service threads. Sidecars of
+// the reads are moved to the MultiRead response once they complete.
+class MultiReadCall : public std::enable_shared_from_this<MultiReadCall> {
+ public:
+  MultiReadCall(const MultiReadRequestPB* req, MultiReadResponsePB* resp, rpc::RpcContext context)
+      : req_(req), resp_(resp), context_(std::move(context)), controllers_(req->reads_size()),
+        pending_reads_(req->reads_size()) {
+  }
+
+  void Start(TabletServerServiceProxy* proxy) {
+    const auto count = req_->reads_size();
+    for (int i = 0; i != count; ++i) {
+      resp_->add_reads();
+    }
+    if (count == 0) {
+      context_.RespondSuccess();
+      return;
+    }
+
+    auto self = shared_from_this();
+    for (int i = 0; i != count; ++i) {
+      auto& controller = controllers_[i];
+      controller.set_deadline(context_.GetClientDeadline());
+      // The last read could be executed in this thread, the others are queued to the service pool.
+      controller.set_allow_local_calls_in_curr_thread(i == count - 1);
+      proxy->ReadAsync(req_->reads(i), resp_->mutable_reads(i), &controller,
+                       [self, i] { self->ReadDone(i); });
+    }
+  }
+
+ private:
+  void ReadDone(int idx) {
+    auto* read_resp = resp_->mutable_reads(idx);
+    auto status = controllers_[idx].status();
+    if (status.ok()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      status = MoveSidecars(idx, read_resp);
+    }
+    if (!status.ok()) {
+      read_resp->Clear();
+      StatusToPB(status, read_resp->mutable_error()->mutable_status());
+      read_resp->mutable_error()->set_code(TabletServerErrorPB::UNKNOWN_ERROR);
+    }
+    if (pending_reads_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      context_.RespondSuccess();
+    }
+  }
+
+  // Moves the sidecars of the read with the given index to the MultiRead response, updating the
+  // sidecar indexes in its response.
+  CHECKED_STATUS MoveSidecars(int idx, ReadResponsePB* read_resp) {
+    for (auto& ql_resp : *read_resp->mutable_ql_batch()) {
+      if (ql_resp.has_rows_data_sidecar()) {
+        int sidecar_idx = 0;
+        RETURN_NOT_OK(MoveSidecar(idx, ql_resp.rows_data_sidecar(), &sidecar_idx));
+        ql_resp.set_rows_data_sidecar(sidecar_idx);
+      }
+    }
+    for (auto& pgsql_resp : *read_resp->mutable_pgsql_batch()) {
+      if (pgsql_resp.has_rows_data_sidecar()) {
+        int sidecar_idx = 0;
+        RETURN_NOT_OK(MoveSidecar(idx, pgsql_resp.rows_data_sidecar(), &sidecar_idx));
+        pgsql_resp.set_rows_data_sidecar(sidecar_idx);
+      }
+    }
+    return Status::OK();
+  }
+
+  CHECKED_STATUS MoveSidecar(int idx, int read_sidecar_idx, int* sidecar_idx) {
+    Slice sidecar;
+    RETURN_NOT_OK(controllers_[idx].GetSidecar(read_sidecar_idx, &sidecar));
+    return context_.AddRpcSidecar(RefCntBuffer(sidecar.data(), sidecar.size()), sidecar_idx);
+  }
+
+  const MultiReadRequestPB* const req_;
+  MultiReadResponsePB* const resp_;
+  rpc::RpcContext context_;
+  std::vector<rpc::RpcController> controllers_;
+  std::atomic<int> pending_reads_;
+  std::mutex mutex_;
+};
+
+} // namespace
+
+void TabletServiceImpl::MultiRead(const MultiReadRequestPB* req,
+                                  MultiReadResponsePB* resp,
+                                  rpc::RpcContext context) {
+  TRACE_EVENT1("tserver", "TabletServiceImpl::MultiRead", "num_reads", req->reads_size());
+  DVLOG(3) << "Received MultiRead RPC: " << req->ShortDebugString();
+
+  auto proxy = server_ ? server_->LocalProxy() : nullptr;
+  if (!proxy) {
+    SetupErrorAndRespond(resp->mutable_error(),
+                         STATUS(NotSupported, "MultiRead is not supported by this server"),
+                         TabletServerErrorPB::UNKNOWN_ERROR, &context);
+    return;
+  }
+
+  std::make_shared<MultiReadCall>(req, resp, std::move(context))->Start(proxy.get());
+}
+
 void HandleRedisReadRequestAsync(
     tablet::AbstractTablet* tablet,
     MonoTime deadline,
@@ -1108,8 +1329,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(tablet::AbstractTablet* tablet,
           return read_time;
         }
         int rows_data_sidecar_idx = 0;
-        RETURN_NOT_OK(context->AddRpcSidecar(
-            RefCntBuffer(result.rows_data), &rows_data_sidecar_idx));
+        RETURN_NOT_OK(context->AddRpcSidecar(&result.rows_data, &rows_data_sidecar_idx));
         result.response.set_rows_data_sidecar(rows_data_sidecar_idx);
         resp->add_ql_batch()->Swap(&result.response);
       }
@@ -67,6 +67,10 @@ class TabletServiceImpl : public TabletServerServiceIf {
 
   void Read(const ReadRequestPB* req, ReadResponsePB* resp, rpc::RpcContext context) override;
 
+  void MultiRead(const MultiReadRequestPB* req,
+                 MultiReadResponsePB* resp,
+                 rpc::RpcContext context) override;
+
   void NoOp(const NoOpRequestPB* req, NoOpResponsePB* resp, rpc::RpcContext context) override;
 
   void ListTablets(const ListTabletsRequestPB* req,
@@ -73,6 +73,7 @@
 #include "yb/tablet/tablet_options.h"
 
 #include "yb/tserver/heartbeater.h"
+#include "yb/tserver/memstore_flush_scheduler.h"
 #include "yb/tserver/remote_bootstrap_client.h"
 #include "yb/tserver/tablet_server.h"
 
@@ -105,10 +106,29 @@ DEFINE_int32(tablet_start_warn_threshold_ms, 500,
              "a warning with a trace.");
 TAG_FLAG(tablet_start_warn_threshold_ms, hidden);
 
-DEFINE_int32(db_block_cache_num_shard_bits, 4,
-             "Number of bits to use for sharding the block cache (defaults to 4 bits)");
+DEFINE_int32(db_block_cache_num_shard_bits, -1,
+             "Number of bits to use for sharding the block cache. -1 picks the default of the "
+             "cache type: 4 bits for the lru cache, enough shards for two per core, with a minimum "
+             "of 4 bits, for the clock cache.");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_string(db_block_cache_type, "lru",
+              "Eviction policy of the block cache shared by the tablets: 'lru' or 'clock'. The "
+              "clock cache serves hits without reordering an LRU list under an exclusive shard "
+              "lock, which scales better with many cores.");
+TAG_FLAG(db_block_cache_type, advanced);
+
+static bool ValidateBlockCacheType(const char* flagname, const std::string& value) {
+  if (value == "lru" || value == "clock") {
+    return true;
+  }
+  LOG(ERROR) << strings::Substitute(
+      "$0 must be 'lru' or 'clock', value '$1' is invalid", flagname, value);
+  return false;
+}
+static bool block_cache_type_dummy __attribute__((unused)) = google::RegisterFlagValidator(
+    &FLAGS_db_block_cache_type, &ValidateBlockCacheType);
+
 DEFINE_test_flag(double, fault_crash_after_blocks_deleted, 0.0,
                  "Fraction of the time when the tablet will crash immediately "
                  "after deleting the data blocks during tablet deletion.");
@@ -252,37 +272,102 @@ using tablet::TabletStatusPB;
 
 // Only called from the background task to ensure it's synchronized
 void TSTabletManager::MaybeFlushTablet() {
-  int iteration = 0;
-  while (memory_monitor()->Exceeded() ||
-         (iteration++ == 0 && FLAGS_pretend_memory_exceeded_enforce_flush)) {
-    TabletPeerPtr tablet_to_flush = TabletToFlush();
-    // TODO(bojanserafimov): If tablet_to_flush flushes now because of other reasons,
-    // we will schedule a second flush, which will unnecessarily stall writes for a short time. This
-    // will not happen often, but should be fixed.
-    if (tablet_to_flush) {
-      WARN_NOT_OK(tablet_to_flush->tablet()->Flush(tablet::FlushMode::kAsync),
-          Substitute("Flush failed on $0", tablet_to_flush->tablet_id()));
+  const bool force = FLAGS_pretend_memory_exceeded_enforce_flush;
+  if (!memory_monitor()->Exceeded() && !force) {
+    return;
+  }
+
+  uint64_t flushing_bytes = 0;
+  size_t running_flushes = 0;
+  auto candidates = MemStoreFlushCandidates(&flushing_bytes, &running_flushes);
+  auto memstores_to_flush = flush_scheduler_->PickMemStoresToFlush(
+      std::move(candidates), memory_monitor()->memory_usage(), memory_monitor()->limit(),
+      flushing_bytes, running_flushes, force);
+  for (const auto& memstore : memstores_to_flush) {
+    auto tablet = memstore.tablet_peer->shared_tablet();
+    if (tablet) {
+      // IntentsDbFlushFilter holds back an intents memstore until the regular DB has flushed the
+      // writes of the applied transactions, so the regular DB is flushed along with it.
+      auto flags = memstore.db;
+      if (tablet::HasFlags(flags, tablet::FlushFlags::kIntents)) {
+        flags = tablet::FlushFlags::kAll;
+      }
+      WARN_NOT_OK(tablet->Flush(tablet::FlushMode::kAsync, flags),
+                  Substitute("Flush failed on $0", memstore.tablet_peer->tablet_id()));
     }
   }
 }
 
-// Return the tablet with the oldest write in memstore, or nullptr if all
-// tablet memstores are empty or about to flush.
-TabletPeerPtr TSTabletManager::TabletToFlush() {
-  boost::shared_lock<RWMutex> lock(lock_); // For using the tablet map
-  HybridTime oldest_write_in_memstores = HybridTime::kMax;
-  TabletPeerPtr tablet_to_flush;
-  for (const TabletMap::value_type& entry : tablet_map_) {
-    const auto tablet = entry.second->shared_tablet();
-    if (tablet) {
-      const HybridTime oldest_write_in_memstore = tablet->flush_stats()->oldest_write_in_memstore();
-      if (oldest_write_in_memstore < oldest_write_in_memstores) {
-        oldest_write_in_memstores = oldest_write_in_memstore;
-        tablet_to_flush = entry.second;
+std::vector<MemStoreFlushCandidate> TSTabletManager::MemStoreFlushCandidates(
+    uint64_t* flushing_bytes, size_t* running_flushes) {
+  std::vector<TabletPeerPtr> peers;
+  {
+    boost::shared_lock<RWMutex> lock(lock_); // For using the tablet map
+    peers.reserve(tablet_map_.size());
+    for (const TabletMap::value_type& entry : tablet_map_) {
+      peers.push_back(entry.second);
+    }
+  }
+
+  std::vector<MemStoreFlushCandidate> result;
+  for (const auto& peer : peers) {
+    const auto tablet = peer->shared_tablet();
+    if (!tablet || peer->state() != tablet::RUNNING) {
+      continue;
+    }
+
+    // Only the oldest write of the tablet as a whole is tracked.
+    const HybridTime oldest_write = tablet->flush_stats()->oldest_write_in_memstore();
+    MonoDelta age = MonoDelta::kZero;
+    if (oldest_write != HybridTime::kMax) {
+      const auto now = tablet->clock()->Now();
+      if (now > oldest_write) {
+        age = MonoDelta::FromMicroseconds(
+            now.GetPhysicalValueMicros() - oldest_write.GetPhysicalValueMicros());
+      }
+    }
+
+    int64_t latest_index = peer->log() ? peer->log()->GetLatestEntryOpId().index : 0;
+    auto max_persistent_op_id = tablet->MaxPersistentOpId();
+    if (!max_persistent_op_id.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 10)
+          << "Failed to get max persistent op id of " << peer->tablet_id() << ": "
+          << max_persistent_op_id.status();
+      continue;
+    }
+
+    const auto regular_usage = tablet->GetMemStoreUsage(tablet::FlushFlags::kRegular);
+    for (auto db : {tablet::FlushFlags::kRegular, tablet::FlushFlags::kIntents}) {
+      const auto usage = db == tablet::FlushFlags::kIntents
+          ? tablet->GetMemStoreUsage(db) : regular_usage;
+      if (usage.immutable_bytes != 0) {
+        // Flushing a memstore while the previous flush is in progress would stall the writes.
+        *flushing_bytes += usage.immutable_bytes;
+        ++*running_flushes;
+        continue;
+      }
+      if (usage.active_bytes == 0) {
+        continue;
+      }
+      // The regular DB is flushed along with the intents DB, see MaybeFlushTablet.
+      if (db == tablet::FlushFlags::kIntents && regular_usage.immutable_bytes != 0) {
+        continue;
       }
+      const auto& persistent_op_id = db == tablet::FlushFlags::kIntents
+          ? max_persistent_op_id->intents : max_persistent_op_id->regular;
+      MemStoreFlushCandidate candidate;
+      candidate.tablet_peer = peer;
+      candidate.db = db;
+      candidate.memstore_bytes = usage.active_bytes;
+      if (db == tablet::FlushFlags::kIntents) {
+        candidate.flushed_along_bytes = regular_usage.active_bytes;
+      }
+      candidate.age = age;
+      candidate.retained_wal_ops = std::max<int64_t>(latest_index - persistent_op_id.index, 0);
+      result.push_back(std::move(candidate));
     }
   }
-  return tablet_to_flush;
+  return result;
 }
 
 TSTabletManager::TSTabletManager(FsManager* fs_manager,
@@ -349,8 +434,17 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
     block_cache_size_bytes = total_ram_avail * FLAGS_db_block_cache_size_percentage / 100;
   }
   if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    tablet_options_.block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                       FLAGS_db_block_cache_num_shard_bits);
+    if (FLAGS_db_block_cache_type == "clock") {
+      tablet_options_.block_cache = rocksdb::NewClockCache(block_cache_size_bytes,
+                                                           FLAGS_db_block_cache_num_shard_bits);
+    } else {
+      // Sharding of the lru cache does not depend on the number of cores, as it did before the
+      // clock cache was added.
+      constexpr int kDefaultLRUCacheShardBits = 4;
+      const int num_shard_bits = FLAGS_db_block_cache_num_shard_bits;
+      tablet_options_.block_cache = rocksdb::NewLRUCache(
+          block_cache_size_bytes, num_shard_bits < 0 ? kDefaultLRUCacheShardBits : num_shard_bits);
+    }
     tablet_options_.block_cache->SetMetrics(server_->metric_entity());
   }
 
@@ -370,6 +464,7 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
 
   // Add memory monitor and background thread for flushing
   if (should_count_memory) {
+    flush_scheduler_ = std::make_unique<MemStoreFlushScheduler>(server_->metric_entity());
     background_task_.reset(new BackgroundTask(
       std::function<void()>([this](){ MaybeFlushTablet(); }),
       "tablet manager",
@@ -80,8 +80,10 @@ class TabletReportPB;
 } // namespace master
 
 namespace tserver {
+class MemStoreFlushScheduler;
 class TabletServer;
 class TSMemoryMonitorListener;
+struct MemStoreFlushCandidate;
 
 using rocksdb::MemoryMonitor;
 
@@ -281,7 +283,8 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   MemoryMonitor* memory_monitor() { return tablet_options_.memory_monitor.get(); }
 
-  // Flush some tablet if the memstore memory limit is exceeded
+  // Flush the memstores picked by the memstore flush scheduler if the memstore memory limit is
+  // exceeded.
   void MaybeFlushTablet();
 
  private:
@@ -373,8 +376,11 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // TABLET_DATA_READY state. Generally, we tombstone the replica.
   CHECKED_STATUS HandleNonReadyTabletOnStartup(const scoped_refptr<tablet::TabletMetadata>& meta);
 
-  // Return the tablet with oldest write still in its memstore
-  std::shared_ptr<tablet::TabletPeer> TabletToFlush();
+  // Returns the memstores of the running tablets that could be flushed to free memory. Memstores
+  // that are already being flushed are not returned, instead their memory is added to
+  // flushing_bytes and their number to running_flushes.
+  std::vector<MemStoreFlushCandidate> MemStoreFlushCandidates(
+      uint64_t* flushing_bytes, size_t* running_flushes);
 
   TSTabletManagerStatePB state() const {
     boost::shared_lock<RWMutex> lock(lock_);
@@ -451,6 +457,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
+  // Picks the memstores to flush when the memstore memory limit is exceeded.
+  std::unique_ptr<MemStoreFlushScheduler> flush_scheduler_;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
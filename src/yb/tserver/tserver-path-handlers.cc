@@ -55,6 +55,7 @@
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/jsonwriter.h"
 #include "yb/util/url-coding.h"
 
 namespace yb {
@@ -65,6 +66,7 @@ using yb::consensus::CONSENSUS_CONFIG_COMMITTED;
 using yb::consensus::ConsensusStatePB;
 using yb::consensus::RaftPeerPB;
 using yb::consensus::OperationStatusPB;
+using yb::tablet::HotKeyStats;
 using yb::tablet::MaintenanceManagerStatusPB;
 using yb::tablet::MaintenanceManagerStatusPB_CompletedOpPB;
 using yb::tablet::MaintenanceManagerStatusPB_MaintenanceOpPB;
@@ -112,6 +114,12 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
       "/maintenance-manager", "",
       std::bind(&TabletServerPathHandlers::HandleMaintenanceManagerPage, this, _1, _2),
       true /* styled */, false /* is_on_nav_bar */);
+  server->RegisterPathHandler(
+      "/hot-keys", "", std::bind(&TabletServerPathHandlers::HandleHotKeysPage, this, _1, _2),
+      true /* styled */, false /* is_on_nav_bar */);
+  server->RegisterPathHandler(
+      "/hot-keysz", "", std::bind(&TabletServerPathHandlers::HandleHotKeysJson, this, _1, _2),
+      false /* styled */, false /* is_on_nav_bar */);
 
   return Status::OK();
 }
@@ -349,6 +357,12 @@ void TabletServerPathHandlers::HandleTabletPage(const Webserver::WebRequest& req
                                   "Tablet Log Anchors")
           << "</li>" << endl;
 
+  // Hot keys page.
+  *output << "<li>" << Substitute("<a href=\"/hot-keys?id=$0\">$1</a>",
+                                  UrlEncodeToString(tablet_id),
+                                  "Hot Keys")
+          << "</li>" << endl;
+
   // End list
   *output << "</ul>\n";
 }
@@ -405,6 +419,8 @@ void TabletServerPathHandlers::HandleDashboardsPage(const Webserver::WebRequest&
   *output << GetDashboardLine("maintenance-manager", "Maintenance Manager",
                               "List of operations that are currently running and those "
                               "that are registered.");
+  *output << GetDashboardLine("hot-keys", "Hot Keys",
+                              "Most frequently read and written keys of every tablet.");
 }
 
 string TabletServerPathHandlers::GetDashboardLine(const std::string& link,
@@ -474,5 +490,101 @@ void TabletServerPathHandlers::HandleMaintenanceManagerPage(const Webserver::Web
   *output << "</table>\n";
 }
 
+namespace {
+
+const size_t kDefaultHotKeysLimit = 10;
+
+// Returns the running tablets requested by the optional "id" argument, all of them by default.
+vector<std::shared_ptr<TabletPeer>> HotKeysPeers(TabletServer* tserver,
+                                                 const Webserver::WebRequest& req) {
+  vector<std::shared_ptr<TabletPeer>> peers;
+  tserver->tablet_manager()->GetTabletPeers(&peers);
+  std::sort(peers.begin(), peers.end(), &CompareByTabletId);
+  auto id = FindOrNull(req.parsed_args, "id");
+  peers.erase(std::remove_if(peers.begin(), peers.end(),
+                             [id](const std::shared_ptr<TabletPeer>& peer) {
+                               return peer->tablet() == nullptr ||
+                                      (id != nullptr && peer->tablet_id() != *id);
+                             }),
+              peers.end());
+  return peers;
+}
+
+size_t HotKeysLimit(const Webserver::WebRequest& req) {
+  string arg = FindWithDefault(req.parsed_args, "limit", "");
+  uint64 limit;
+  return safe_strtou64(arg, &limit) && limit > 0 ? limit : kDefaultHotKeysLimit;
+}
+
+}  // anonymous namespace
+
+void TabletServerPathHandlers::HandleHotKeysPage(const Webserver::WebRequest& req,
+                                                 std::stringstream* output) {
+  const size_t limit = HotKeysLimit(req);
+
+  *output << "<h1>Hot Keys</h1>\n";
+  *output << "<p>Estimated recent accesses of the most frequently read and written partition "
+             "keys of every tablet. The error is the possible overestimation of the accesses."
+             "</p>\n";
+  for (const auto& peer : HotKeysPeers(tserver_, req)) {
+    const auto& hot_keys = peer->tablet()->hot_keys();
+    const auto total_accesses = hot_keys.TotalAccesses();
+    auto top_keys = hot_keys.TopKeys(limit);
+    if (top_keys.empty()) {
+      continue;
+    }
+
+    *output << "<h3>" << EscapeForHtmlToString(peer->tablet_metadata()->table_name()) << " "
+            << TabletLink(peer->tablet_id()) << "</h3>\n";
+    *output << "<table class='table table-striped'>\n";
+    *output << "  <tr><th>Key</th><th>Reads</th><th>Writes</th><th>Error</th>"
+               "<th>Share of accesses</th></tr>\n";
+    for (const HotKeyStats& stats : top_keys) {
+      *output << Substitute(
+          "  <tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td><td>$4%</td></tr>\n",
+          EscapeForHtmlToString(stats.KeyToString()), stats.reads, stats.writes, stats.error,
+          total_accesses ? stats.accesses() * 100 / total_accesses : 0);
+    }
+    *output << "</table>\n";
+  }
+}
+
+void TabletServerPathHandlers::HandleHotKeysJson(const Webserver::WebRequest& req,
+                                                 std::stringstream* output) {
+  const size_t limit = HotKeysLimit(req);
+
+  JsonWriter writer(output, JsonWriter::PRETTY);
+  writer.StartArray();
+  for (const auto& peer : HotKeysPeers(tserver_, req)) {
+    const auto& hot_keys = peer->tablet()->hot_keys();
+    writer.StartObject();
+    writer.String("tablet_id");
+    writer.String(peer->tablet_id());
+    writer.String("table_name");
+    writer.String(peer->tablet_metadata()->table_name());
+    writer.String("total_accesses");
+    writer.Uint64(hot_keys.TotalAccesses());
+    writer.String("keys");
+    writer.StartArray();
+    for (const HotKeyStats& stats : hot_keys.TopKeys(limit)) {
+      writer.StartObject();
+      writer.String("key");
+      writer.String(stats.KeyToString());
+      writer.String("encoded_key");
+      writer.String(Slice(stats.key).ToDebugHexString());
+      writer.String("reads");
+      writer.Uint64(stats.reads);
+      writer.String("writes");
+      writer.Uint64(stats.writes);
+      writer.String("error");
+      writer.Uint64(stats.error);
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+  }
+  writer.EndArray();
+}
+
 }  // namespace tserver
 }  // namespace yb
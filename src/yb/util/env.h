@@ -179,6 +179,11 @@ class Env {
   // Synchronize the entry for a specific directory.
   virtual CHECKED_STATUS SyncDir(const std::string& dirname) = 0;
 
+  // Synchronize all the data and metadata of the file system that contains the given path, i.e.
+  // the equivalent of syncing every file of the file system. Returns NotSupported if the platform
+  // cannot do that in a single call.
+  virtual CHECKED_STATUS SyncFileSystem(const std::string& path) = 0;
+
   // Recursively delete the specified directory.
   // This should operate safely, not following any symlinks, etc.
   virtual CHECKED_STATUS DeleteRecursively(const std::string &dirname) = 0;
@@ -377,12 +382,18 @@ struct WritableFileOptions {
 
   bool o_direct;
 
+  // Only used with o_direct. If true, the file is opened with O_SYNC, so each write is durable
+  // once it returns. Otherwise the writes bypass the page cache but may stay in the volatile cache
+  // of the device until Sync() is called.
+  bool o_direct_sync_writes;
+
   // See CreateMode for details.
   Env::CreateMode mode;
 
   WritableFileOptions()
     : sync_on_close(false),
       o_direct(false),
+      o_direct_sync_writes(true),
       mode(Env::CREATE_IF_NON_EXISTING_TRUNCATE) { }
 };
 
@@ -601,6 +612,9 @@ class EnvWrapper : public Env {
   CHECKED_STATUS DeleteFile(const std::string& f) override { return target_->DeleteFile(f); }
   CHECKED_STATUS CreateDir(const std::string& d) override { return target_->CreateDir(d); }
   CHECKED_STATUS SyncDir(const std::string& d) override { return target_->SyncDir(d); }
+  CHECKED_STATUS SyncFileSystem(const std::string& p) override {
+    return target_->SyncFileSystem(p);
+  }
   CHECKED_STATUS DeleteDir(const std::string& d) override { return target_->DeleteDir(d); }
   CHECKED_STATUS DeleteRecursively(const std::string& d) override {
     return target_->DeleteRecursively(d);
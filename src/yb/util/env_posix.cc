@@ -532,8 +532,9 @@ class PosixWritableFile : public WritableFile {
 class PosixDirectIOWritableFile : public PosixWritableFile {
  public:
   PosixDirectIOWritableFile(const std::string &fname, int fd, uint64_t file_size,
-                            bool sync_on_close)
-      : PosixWritableFile(fname, fd, file_size, false /* sync_on_close */) {
+                            bool sync_on_close, bool sync_writes)
+      : PosixWritableFile(fname, fd, file_size, false /* sync_on_close */),
+        sync_writes_(sync_writes) {
 
     if (file_size != 0) {
       // For now, we don't support appending to an already existing file (of non-zero size).
@@ -573,7 +574,7 @@ class PosixDirectIOWritableFile : public PosixWritableFile {
 
       if (data_slice.size() >= max_data) {
         data_slice.remove_prefix(max_data);
-        RETURN_NOT_OK(Sync());
+        RETURN_NOT_OK(DoWrite());
       } else {
         break;
       }
@@ -616,14 +617,21 @@ class PosixDirectIOWritableFile : public PosixWritableFile {
     return Status::OK();
   }
 
+  // Writes out the buffered blocks. Unless the file was opened with O_SYNC, the written data is
+  // only durable after Sync().
   Status Flush(FlushMode mode) override {
     ThreadRestrictions::AssertIOAllowed();
-    return Sync();
+    return DoWrite();
   }
 
   Status Sync() override {
     ThreadRestrictions::AssertIOAllowed();
-    return DoWrite();
+    RETURN_NOT_OK(DoWrite());
+    if (!sync_writes_ && pending_sync_) {
+      pending_sync_ = false;
+      RETURN_NOT_OK(DoSync(fd_, filename_));
+    }
+    return Status::OK();
   }
 
   uint64_t Size() const override {
@@ -726,6 +734,7 @@ class PosixDirectIOWritableFile : public PosixWritableFile {
     }
     last_block_idx_ = 0;
     has_new_data_ = false;
+    pending_sync_ = true;
     return Status::OK();
   }
 
@@ -759,6 +768,9 @@ class PosixDirectIOWritableFile : public PosixWritableFile {
   int block_size_;
   bool has_new_data_;
   size_t real_size_;
+
+  // Whether the file was opened with O_SYNC, so that Sync() does not need to call fdatasync().
+  const bool sync_writes_;
 };
 #endif
 
@@ -1028,7 +1040,7 @@ class PosixEnv : public Env {
     int extra_flags = 0;
 #if defined(__linux__)
     if (opts.o_direct) {
-      extra_flags = O_DIRECT | O_NOATIME | O_SYNC;
+      extra_flags = O_DIRECT | O_NOATIME | (opts.o_direct_sync_writes ? O_SYNC : 0);
     }
 #endif
     RETURN_NOT_OK(DoOpen(fname, opts.mode, &fd, extra_flags));
@@ -1046,7 +1058,8 @@ class PosixEnv : public Env {
     int fd = -1;
 #if defined(__linux__)
     if (opts.o_direct)
-      fd = ::mkostemp(fname.get(), O_DIRECT | O_NOATIME | O_SYNC);
+      fd = ::mkostemp(fname.get(),
+                      O_DIRECT | O_NOATIME | (opts.o_direct_sync_writes ? O_SYNC : 0));
     else
 #endif
       fd = ::mkstemp(fname.get());
@@ -1147,6 +1160,25 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  Status SyncFileSystem(const std::string& path) override {
+    TRACE_EVENT1("io", "SyncFileSystem", "path", path);
+    ThreadRestrictions::AssertIOAllowed();
+    if (FLAGS_never_fsync) return Status::OK();
+#if defined(__linux__)
+    int fd;
+    if ((fd = open(path.c_str(), O_RDONLY)) == -1) {
+      return STATUS_IO_ERROR(path, errno);
+    }
+    ScopedFdCloser fd_closer(fd);
+    if (syncfs(fd) != 0) {
+      return STATUS_IO_ERROR(path, errno);
+    }
+    return Status::OK();
+#else
+    return STATUS(NotSupported, "syncfs() is not available", path);
+#endif
+  }
+
   Status DeleteRecursively(const std::string &name) override {
     return Walk(name, POST_ORDER, Bind(&PosixEnv::DeleteRecursivelyCb,
                                        Unretained(this)));
@@ -1448,7 +1480,8 @@ class PosixEnv : public Env {
     PosixWritableFile *posix_writable_file;
 #if defined(__linux)
     if (opts.o_direct)
-      posix_writable_file = new PosixDirectIOWritableFile(fname, fd, file_size, opts.sync_on_close);
+      posix_writable_file = new PosixDirectIOWritableFile(
+          fname, fd, file_size, opts.sync_on_close, opts.o_direct_sync_writes);
     else
 #endif
       posix_writable_file = new PosixWritableFile(fname, fd, file_size, opts.sync_on_close);
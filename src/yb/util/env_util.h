@@ -85,6 +85,9 @@ Status CreateDirIfMissing(Env* env, const std::string& path,
 Status CopyFile(Env* env, const std::string& source_path, const std::string& dest_path,
                 WritableFileOptions opts);
 
+// Compute the CRC32C checksum of the whole contents of the given file.
+Result<uint32_t> Crc32cOfFile(Env* env, const std::string& path);
+
 // Deletes a file or directory when this object goes out of scope.
 //
 // The deletion may be cancelled by calling .Cancel().
@@ -89,6 +89,31 @@ TEST_F(RefCntBufferTest, TestVector) {
   }
 }
 
+// Test appending data of random sizes to a chain of buffers.
+TEST_F(RefCntBufferTest, TestChain) {
+  unsigned int seed = SeedRandom();
+  constexpr size_t kMaxChunkSize = 4096;
+  RefCntBufferChain chain(kMaxChunkSize);
+  std::string expected;
+  for (auto i = 1000; i--;) {
+    size_t size = rand_r(&seed) % (kSizeLimit * 3);
+    std::string data(size, static_cast<char>(i));
+    chain.Append(data.c_str(), data.size());
+    expected += data;
+  }
+  ASSERT_EQ(expected.size(), chain.size());
+
+  const auto& chunks = chain.Finish();
+  size_t total_size = 0;
+  for (const auto& chunk : chunks) {
+    ASSERT_LE(chunk.size(), kMaxChunkSize);
+    total_size += chunk.size();
+  }
+  ASSERT_EQ(expected.size(), total_size);
+  ASSERT_EQ(expected, chain.ToBuffer());
+  ASSERT_EQ(expected, chain.Flatten().ToBuffer());
+}
+
 namespace {
 
 const size_t kInitialBuffers = 1000;
@@ -13,11 +13,14 @@
 //
 //
 
+#include <algorithm>
+
 #include <glog/logging.h>
 
 #include "yb/util/ref_cnt_buffer.h"
 
 #include "yb/util/faststring.h"
+#include "yb/util/slice.h"
 
 namespace yb {
 
@@ -81,4 +84,71 @@ void RefCntBuffer::DoReset(char* data) {
   data_ = data;
 }
 
+void RefCntBuffer::Shrink(size_t new_size) {
+  DCHECK_LE(new_size, size());
+  DCHECK_EQ(counter_reference(), 1);
+  size_reference() = new_size;
+}
+
+void RefCntBufferChain::Append(const char* data, size_t size) {
+  size_ += size;
+  while (size > 0) {
+    if (chunks_.empty() || last_chunk_used_ == chunks_.back().size()) {
+      // Grow the chunk size geometrically, but allocate at least enough for the remaining data up
+      // to the maximum chunk size.
+      size_t chunk_size = chunks_.empty() ? kMinChunkSize
+                                          : std::min(chunks_.back().size() * 2, max_chunk_size_);
+      chunk_size = std::max(chunk_size, std::min(size, max_chunk_size_));
+      chunks_.emplace_back(chunk_size);
+      last_chunk_used_ = 0;
+    }
+    RefCntBuffer& chunk = chunks_.back();
+    const size_t len = std::min(size, chunk.size() - last_chunk_used_);
+    memcpy(chunk.data() + last_chunk_used_, data, len);
+    last_chunk_used_ += len;
+    data += len;
+    size -= len;
+  }
+}
+
+void RefCntBufferChain::Append(const faststring& data) {
+  Append(data.c_str(), data.size());
+}
+
+void RefCntBufferChain::Append(const Slice& data) {
+  Append(data.cdata(), data.size());
+}
+
+const std::vector<RefCntBuffer>& RefCntBufferChain::Finish() {
+  if (!chunks_.empty() && last_chunk_used_ < chunks_.back().size()) {
+    chunks_.back().Shrink(last_chunk_used_);
+  }
+  return chunks_;
+}
+
+RefCntBuffer RefCntBufferChain::Flatten() const {
+  RefCntBuffer result(size_);
+  char* out = result.data();
+  size_t left = size_;
+  for (const auto& chunk : chunks_) {
+    const size_t len = std::min(left, chunk.size());
+    memcpy(out, chunk.data(), len);
+    out += len;
+    left -= len;
+  }
+  return result;
+}
+
+std::string RefCntBufferChain::ToBuffer() const {
+  std::string result;
+  result.reserve(size_);
+  size_t left = size_;
+  for (const auto& chunk : chunks_) {
+    const size_t len = std::min(left, chunk.size());
+    result.append(chunk.data(), len);
+    left -= len;
+  }
+  return result;
+}
+
 } // namespace yb
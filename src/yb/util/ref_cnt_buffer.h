@@ -21,10 +21,12 @@
 
 #include <atomic>
 #include <string>
+#include <vector>
 
 namespace yb {
 
 class faststring;
+class Slice;
 
 // Byte buffer with reference counting. It embeds reference count, size and data in a single block.
 class RefCntBuffer {
@@ -86,6 +88,10 @@ class RefCntBuffer {
 
   void Reset() { DoReset(nullptr); }
 
+  // Reduces the size of the buffer without reallocating it. Should only be called while the buffer
+  // is not shared yet.
+  void Shrink(size_t new_size);
+
   explicit operator bool() const {
     return data_ != nullptr;
   }
@@ -115,6 +121,55 @@ class RefCntBuffer {
   char *data_;
 };
 
+// Byte sequence stored in a chain of reference counted chunks. Appended data is written into the
+// last chunk and a new chunk is allocated when it is full, so the data already written is never
+// moved. The chunks can be sent as an RPC sidecar and handed to writev() as they are, without
+// being flattened into a single contiguous buffer first.
+//
+// Chunk sizes start small, so that small sequences do not waste memory, and double up to
+// max_chunk_size.
+class RefCntBufferChain {
+ public:
+  static constexpr size_t kMinChunkSize = 256;
+  static constexpr size_t kDefaultMaxChunkSize = 64 * 1024;
+
+  explicit RefCntBufferChain(size_t max_chunk_size = kDefaultMaxChunkSize)
+      : max_chunk_size_(max_chunk_size) {}
+
+  void Append(const char* data, size_t size);
+
+  void Append(const uint8_t* data, size_t size) {
+    Append(static_cast<const char*>(static_cast<const void*>(data)), size);
+  }
+
+  void Append(const faststring& data);
+  void Append(const Slice& data);
+
+  // Total number of bytes appended.
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  // Shrinks the last chunk to the used size and returns the chunks. No more data should be appended
+  // after that.
+  const std::vector<RefCntBuffer>& Finish();
+
+  const std::vector<RefCntBuffer>& chunks() const { return chunks_; }
+
+  // Copies the data into a single contiguous buffer.
+  RefCntBuffer Flatten() const;
+
+  std::string ToBuffer() const;
+
+ private:
+  const size_t max_chunk_size_;
+  std::vector<RefCntBuffer> chunks_;
+
+  // Number of bytes used in the last chunk.
+  size_t last_chunk_used_ = 0;
+  size_t size_ = 0;
+};
+
 } // namespace yb
 
 #endif // YB_UTIL_REF_CNT_BUFFER_H
@@ -120,7 +120,8 @@ CQLProcessor::CQLProcessor(CQLServiceImpl* service_impl, const CQLProcessorListP
           service_impl->cql_metrics().get(),
           service_impl->clock(),
           std::bind(&CQLServiceImpl::GetTransactionManager, service_impl),
-          service_impl->cql_rpc_env()),
+          service_impl->cql_rpc_env(),
+          service_impl->parse_tree_cache()),
       service_impl_(service_impl),
       cql_metrics_(service_impl->cql_metrics()),
       pos_(pos),
@@ -330,7 +331,7 @@ CQLResponse* CQLProcessor::ProcessRequest(const BatchRequest& req) {
     } else {
 
       VLOG(1) << "BATCH QUERY " << query.query;
-      ql::ParseTree::UniPtr parse_tree;
+      ql::ParseTree::SharedPtrConst parse_tree;
       RunBatch(query.query, query.params, &parse_tree, retry_count > 0);
       parse_trees_.insert(std::move(parse_tree));
 
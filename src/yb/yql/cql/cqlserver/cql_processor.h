@@ -105,7 +105,7 @@ class CQLProcessor : public ql::QLProcessor {
   CQLInboundCallPtr call_;
   std::shared_ptr<const CQLRequest> request_;
   std::unordered_set<std::shared_ptr<const CQLStatement>> stmts_;
-  std::unordered_set<ql::ParseTree::UniPtr> parse_trees_;
+  std::unordered_set<ql::ParseTree::SharedPtrConst> parse_trees_;
 
   // Current retry count.
   int retry_count_ = 0;
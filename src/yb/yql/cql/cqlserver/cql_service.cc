@@ -28,12 +28,17 @@
 
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/size_literals.h"
 
 using namespace std::placeholders;
+using namespace yb::size_literals;
 
 DEFINE_int64(cql_service_max_prepared_statement_size_bytes, 0,
              "The maximum amount of memory the CQL proxy should use to maintain prepared "
              "statements. 0 or negative means unlimited.");
+DEFINE_int64(cql_service_parse_tree_cache_size_bytes, 64_MB,
+             "The maximum amount of memory the CQL proxy should use to cache the analyzed parse "
+             "trees of unprepared statements. 0 or negative disables the cache.");
 DEFINE_int32(cql_ybclient_reactor_threads, 24,
              "The number of reactor threads to be used for processing ybclient "
              "requests originating in the cql layer");
@@ -76,6 +81,13 @@ CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts,
       FLAGS_cql_service_max_prepared_statement_size_bytes : -1,
       "CQL prepared statements' memory usage", server->mem_tracker());
 
+  // Setup the cache of analyzed parse trees for unprepared statements.
+  if (FLAGS_cql_service_parse_tree_cache_size_bytes > 0) {
+    parse_tree_cache_ = std::make_unique<ql::ParseTreeCache>(
+        FLAGS_cql_service_parse_tree_cache_size_bytes, server->mem_tracker(),
+        server->metric_entity());
+  }
+
   auth_prepared_stmt_ = std::make_shared<ql::Statement>(
       "",
       // TODO: enhance this once we need the other fields to create an AuthenticatedUser.
@@ -25,6 +25,7 @@
 #include "yb/yql/cql/cqlserver/cql_statement.h"
 #include "yb/yql/cql/cqlserver/cql_service.service.h"
 #include "yb/yql/cql/cqlserver/cql_server_options.h"
+#include "yb/yql/cql/ql/parse_tree_cache.h"
 #include "yb/yql/cql/ql/statement.h"
 
 #include "yb/util/string_case.h"
@@ -82,6 +83,9 @@ class CQLServiceImpl : public CQLServerServiceIf,
     return prepared_stmts_mem_tracker_;
   }
 
+  // Return the server-wide cache of analyzed parse trees of unprepared statements.
+  ql::ParseTreeCache* parse_tree_cache() const { return parse_tree_cache_.get(); }
+
   // Return the YBClient to communicate with either master or tserver.
   const std::shared_ptr<client::YBClient>& client() const;
 
@@ -157,6 +161,9 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Tracker to measure and limit memory usage of prepared statements.
   std::shared_ptr<MemTracker> prepared_stmts_mem_tracker_;
 
+  // Cache of analyzed parse trees of unprepared statements shared by all CQL processors.
+  ql::ParseTreeCache::UniPtr parse_tree_cache_;
+
   // Metrics to be collected and reported.
   yb::rpc::RpcMethodMetrics metrics_;
 
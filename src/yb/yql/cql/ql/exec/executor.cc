@@ -996,6 +996,15 @@ Status Executor::ExecPTNode(const PTUseKeyspace *tnode) {
 void Executor::FlushAsync() {
   batched_writes_by_primary_key_.clear();
   batched_writes_by_hash_key_.clear();
+  // If the transaction is committed right after this flush, let it send a single shard write
+  // without going through the status tablet.
+  const auto& tnode_contexts = *exec_context().tnode_contexts();
+  if (!tnode_contexts.empty() &&
+      tnode_contexts.back().tnode()->opcode() == TreeNodeOpcode::kPTCommit &&
+      std::none_of(tnode_contexts.begin(), tnode_contexts.end(),
+                   [](const TnodeContext& context) { return context.IsDeferred(); })) {
+    ql_env_->ExpectCommitAfterNextFlush();
+  }
   if (!ql_env_->FlushAsync(&flush_async_cb_)) {
     StatementExecuted(Status::OK());
   }
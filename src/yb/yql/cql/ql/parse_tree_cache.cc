@@ -0,0 +1,166 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "yb/yql/cql/ql/parse_tree_cache.h"
+
+METRIC_DEFINE_counter(
+    server, ql_parse_tree_cache_hits,
+    "QL parse tree cache hits", yb::MetricUnit::kCacheHits,
+    "Number of unprepared statements executed with a cached parse tree");
+METRIC_DEFINE_counter(
+    server, ql_parse_tree_cache_misses,
+    "QL parse tree cache misses", yb::MetricUnit::kCacheQueries,
+    "Number of unprepared statements that had to be parsed and analyzed");
+METRIC_DEFINE_counter(
+    server, ql_parse_tree_cache_evictions,
+    "QL parse tree cache evictions", yb::MetricUnit::kEntries,
+    "Number of parse trees evicted from the cache to free up memory");
+
+namespace yb {
+namespace ql {
+
+using std::string;
+
+ParseTreeCache::ParseTreeCache(const int64_t capacity,
+                               const std::shared_ptr<MemTracker>& parent_mem_tracker,
+                               const scoped_refptr<MetricEntity>& metric_entity)
+    : capacity_(capacity),
+      mem_tracker_(MemTracker::CreateTracker("CQL parse tree cache", parent_mem_tracker)) {
+  if (metric_entity != nullptr) {
+    hits_ = METRIC_ql_parse_tree_cache_hits.Instantiate(metric_entity);
+    misses_ = METRIC_ql_parse_tree_cache_misses.Instantiate(metric_entity);
+    evictions_ = METRIC_ql_parse_tree_cache_evictions.Instantiate(metric_entity);
+  }
+}
+
+ParseTreeCache::~ParseTreeCache() {
+}
+
+string ParseTreeCache::MakeKey(const string& keyspace, const string& ql_stmt) {
+  // Keyspace names cannot contain a '\0', so the key is unambiguous.
+  string key;
+  key.reserve(keyspace.size() + 1 + ql_stmt.size());
+  key.append(keyspace).push_back('\0');
+  key.append(ql_stmt);
+  return key;
+}
+
+ParseTree::SharedPtrConst ParseTreeCache::Lookup(const string& keyspace, const string& ql_stmt,
+                                                 QLEnv *ql_env) {
+  const string key = MakeKey(keyspace, ql_stmt);
+  ParseTree::SharedPtrConst parse_tree;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    const auto itr = entries_.find(key);
+    if (itr != entries_.end()) {
+      parse_tree = itr->second->parse_tree;
+      // Move the entry to the front of the LRU list.
+      lru_list_.splice(lru_list_.begin(), lru_list_, itr->second);
+    }
+  }
+
+  // Check the schema versions outside the mutex since it may need to fetch the table metadata.
+  if (parse_tree != nullptr &&
+      (parse_tree->stale() || !parse_tree->AnalyzedTablesUnchanged(ql_env))) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    EraseUnlocked(key, parse_tree.get());
+    parse_tree = nullptr;
+  }
+
+  if (parse_tree != nullptr) {
+    // The parse tree may have been cached after a reparse. Clear the reparsed status so that the
+    // statement can be retried once if it is found to be stale during execution.
+    parse_tree->clear_reparsed();
+    if (hits_ != nullptr) {
+      hits_->Increment();
+    }
+  } else if (misses_ != nullptr) {
+    misses_->Increment();
+  }
+  return parse_tree;
+}
+
+void ParseTreeCache::Insert(const string& keyspace, const string& ql_stmt,
+                            const ParseTree::SharedPtrConst& parse_tree) {
+  if (capacity_ <= 0 || parse_tree->root() == nullptr || parse_tree->stale()) {
+    return;
+  }
+  switch (parse_tree->root()->opcode()) {
+    case TreeNodeOpcode::kPTSelectStmt:
+    case TreeNodeOpcode::kPTInsertStmt:
+    case TreeNodeOpcode::kPTUpdateStmt:
+    case TreeNodeOpcode::kPTDeleteStmt:
+      break;
+    default:
+      return;
+  }
+
+  string key = MakeKey(keyspace, ql_stmt);
+  std::lock_guard<std::mutex> guard(mutex_);
+  const auto itr = entries_.find(key);
+  if (itr != entries_.end()) {
+    itr->second->parse_tree = parse_tree;
+    lru_list_.splice(lru_list_.begin(), lru_list_, itr->second);
+  } else {
+    lru_list_.push_front(Entry{key, parse_tree});
+    entries_.emplace(std::move(key), lru_list_.begin());
+  }
+  EvictUnlocked();
+
+  VLOG(3) << "ParseTreeCache: count = " << entries_.size()
+          << ", memory usage = " << mem_tracker_->consumption();
+}
+
+void ParseTreeCache::InvalidateTable(const client::YBTableName& table_name) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (auto itr = lru_list_.begin(); itr != lru_list_.end();) {
+    if (itr->parse_tree->IsAnalyzedTable(table_name)) {
+      entries_.erase(itr->key);
+      itr = lru_list_.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+}
+
+size_t ParseTreeCache::size() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return entries_.size();
+}
+
+void ParseTreeCache::EraseUnlocked(const string& key, const ParseTree* parse_tree) {
+  // Delete the entry only when it is the same parse tree. It may have been replaced by a newly
+  // analyzed one by another processor in the meantime.
+  const auto itr = entries_.find(key);
+  if (itr != entries_.end() && itr->second->parse_tree.get() == parse_tree) {
+    lru_list_.erase(itr->second);
+    entries_.erase(itr);
+  }
+}
+
+void ParseTreeCache::EvictUnlocked() {
+  // Parse trees in use by a processor are released when the execution completes, so the memory
+  // usage can stay above capacity briefly after the eviction.
+  while (!lru_list_.empty() && mem_tracker_->consumption() > capacity_) {
+    entries_.erase(lru_list_.back().key);
+    lru_list_.pop_back();
+    if (evictions_ != nullptr) {
+      evictions_->Increment();
+    }
+  }
+}
+
+}  // namespace ql
+}  // namespace yb
@@ -0,0 +1,116 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+// This class defines a server-wide cache of analyzed parse trees of unprepared statements. All
+// QLProcessors of a server share one cache, so a statement sent repeatedly as a plain query is
+// parsed and analyzed once instead of once per request.
+//
+// A cached parse tree is keyed by the current keyspace and the statement text. It is reused only
+// while the tables it was analyzed with keep the same schema versions, so a schema change (ALTER
+// TABLE, CREATE INDEX, ...) makes the statement be recompiled. The parse trees are allocated with
+// the cache's memory tracker and the least recently used ones are evicted when the memory usage
+// exceeds the capacity.
+//--------------------------------------------------------------------------------------------------
+
+#ifndef YB_YQL_CQL_QL_PARSE_TREE_CACHE_H_
+#define YB_YQL_CQL_QL_PARSE_TREE_CACHE_H_
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "yb/yql/cql/ql/ptree/parse_tree.h"
+
+#include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
+
+namespace yb {
+namespace ql {
+
+class ParseTreeCache {
+ public:
+  // Public types.
+  typedef std::unique_ptr<ParseTreeCache> UniPtr;
+
+  // Constructor. "capacity" is the maximum memory usage in bytes of the cached parse trees.
+  ParseTreeCache(int64_t capacity,
+                 const std::shared_ptr<MemTracker>& parent_mem_tracker,
+                 const scoped_refptr<MetricEntity>& metric_entity = nullptr);
+  ~ParseTreeCache();
+
+  // Look up the analyzed parse tree of a statement. Nullptr is returned if the statement is not
+  // cached, or if its parse tree is stale or was analyzed with an older schema of its tables.
+  ParseTree::SharedPtrConst Lookup(const std::string& keyspace, const std::string& ql_stmt,
+                                   QLEnv *ql_env);
+
+  // Insert the analyzed parse tree of a statement, replacing the existing one if any. Only DML
+  // statements are cached. Other statements either change the schema or the session state, or are
+  // rarely repeated.
+  void Insert(const std::string& keyspace, const std::string& ql_stmt,
+              const ParseTree::SharedPtrConst& parse_tree);
+
+  // Delete the parse trees analyzed with the given table, e.g. after the table is altered or
+  // dropped.
+  void InvalidateTable(const client::YBTableName& table_name);
+
+  // Return the memory tracker that parse trees to be cached should be allocated with.
+  const std::shared_ptr<MemTracker>& mem_tracker() const {
+    return mem_tracker_;
+  }
+
+  // Return the number of cached parse trees.
+  size_t size() const;
+
+ private:
+  struct Entry;
+  using EntryList = std::list<Entry>;
+  using EntryMap = std::unordered_map<std::string, EntryList::iterator>;
+
+  struct Entry {
+    std::string key;
+    ParseTree::SharedPtrConst parse_tree;
+  };
+
+  static std::string MakeKey(const std::string& keyspace, const std::string& ql_stmt);
+
+  // Delete the entry of the given key if it still holds the given parse tree. "mutex_" needs to be
+  // locked before this call.
+  void EraseUnlocked(const std::string& key, const ParseTree* parse_tree);
+
+  // Delete the least recently used entries until the memory usage is within capacity. "mutex_"
+  // needs to be locked before this call.
+  void EvictUnlocked();
+
+  const int64_t capacity_;
+
+  // Tracker of the memory used by the cached parse trees.
+  std::shared_ptr<MemTracker> mem_tracker_;
+
+  // Cached entries by key and the LRU list of them (least recently used one at the end).
+  EntryMap entries_;
+  EntryList lru_list_;
+
+  // Mutex that protects the map and the LRU list.
+  mutable std::mutex mutex_;
+
+  scoped_refptr<Counter> hits_;
+  scoped_refptr<Counter> misses_;
+  scoped_refptr<Counter> evictions_;
+};
+
+}  // namespace ql
+}  // namespace yb
+
+#endif  // YB_YQL_CQL_QL_PARSE_TREE_CACHE_H_
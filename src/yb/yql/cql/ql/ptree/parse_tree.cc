@@ -84,13 +84,28 @@ CHECKED_STATUS ParseTree::Analyze(SemContext *sem_context) {
   }
 }
 
-void ParseTree::AddAnalyzedTable(const client::YBTableName& table_name) {
-  analyzed_tables_.insert(table_name);
+void ParseTree::AddAnalyzedTable(const client::YBTableName& table_name,
+                                 const std::shared_ptr<client::YBTable>& table) {
+  analyzed_tables_[table_name] = std::make_pair(table->id(), table->schema().version());
+}
+
+bool ParseTree::AnalyzedTablesUnchanged(QLEnv *ql_env) const {
+  for (const auto& table : analyzed_tables_) {
+    bool cache_used = false;
+    const std::shared_ptr<client::YBTable> table_desc =
+        ql_env->GetTableDesc(table.first, &cache_used);
+    if (table_desc == nullptr ||
+        table_desc->id() != table.second.first ||
+        table_desc->schema().version() != table.second.second) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void ParseTree::ClearAnalyzedTableCache(QLEnv* ql_env) const {
-  for (const auto& table_name : analyzed_tables_) {
-    ql_env->RemoveCachedTableDesc(table_name);
+  for (const auto& table : analyzed_tables_) {
+    ql_env->RemoveCachedTableDesc(table.first);
   }
 }
 
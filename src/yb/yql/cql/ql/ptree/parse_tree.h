@@ -35,6 +35,7 @@ class ParseTree {
   // Public types.
   typedef std::unique_ptr<ParseTree> UniPtr;
   typedef std::unique_ptr<const ParseTree> UniPtrConst;
+  typedef std::shared_ptr<const ParseTree> SharedPtrConst;
 
   //------------------------------------------------------------------------------------------------
   // Public functions.
@@ -79,7 +80,18 @@ class ParseTree {
   }
 
   // Add table to the set of tables used during semantic analysis.
-  void AddAnalyzedTable(const client::YBTableName& table_name);
+  void AddAnalyzedTable(const client::YBTableName& table_name,
+                        const std::shared_ptr<client::YBTable>& table);
+
+  // Check if the tables used during semantic analysis are still the same tables with the same
+  // schema versions in the metadata cache, i.e. the analysis result can be reused to execute this
+  // statement again.
+  bool AnalyzedTablesUnchanged(QLEnv *ql_env) const;
+
+  // Check if the table was used during semantic analysis.
+  bool IsAnalyzedTable(const client::YBTableName& table_name) const {
+    return analyzed_tables_.count(table_name) > 0;
+  }
 
   // Clear the metadata cache of the tables used to analyze this parse tree.
   void ClearAnalyzedTableCache(QLEnv *ql_env) const;
@@ -93,8 +105,9 @@ class ParseTree {
  private:
   std::shared_ptr<BufferAllocator> buffer_allocator_;
 
-  // Set of tables used during semantic analysis.
-  std::unordered_set<client::YBTableName, boost::hash<client::YBTableName>> analyzed_tables_;
+  // Tables used during semantic analysis with their ids and schema versions at that time.
+  std::unordered_map<client::YBTableName, std::pair<TableId, uint32_t>,
+                     boost::hash<client::YBTableName>> analyzed_tables_;
 
   // Set of types used during semantic analysis.
   std::unordered_set<std::pair<string, string>,
@@ -454,10 +454,15 @@ Status PTTablePropertyMap::SetTableProperty(yb::TableProperties *table_property)
   }
   switch (iterator->second) {
     case PropertyMapType::kCaching: FALLTHROUGH_INTENDED;
-    case PropertyMapType::kCompaction: FALLTHROUGH_INTENDED;
-    case PropertyMapType::kCompression:
+    case PropertyMapType::kCompaction:
       LOG(WARNING) << "Ignoring table property " << table_property_name;
       break;
+    case PropertyMapType::kCompression: {
+      TableCompressionType compression;
+      RETURN_NOT_OK(GetCompressionType(&compression));
+      table_property->SetCompression(compression);
+      break;
+    }
     case PropertyMapType::kTransactions:
       for (const auto& subproperty : map_elements_->node_list()) {
         string subproperty_name;
@@ -748,6 +753,40 @@ Status PTTablePropertyMap::AnalyzeCompression() {
         break;
     }
   }
+
+  TableCompressionType compression;
+  return GetCompressionType(&compression);
+}
+
+Status PTTablePropertyMap::GetCompressionType(TableCompressionType* compression) const {
+  string class_name;
+  bool enabled = true;
+  for (const auto& subproperty : map_elements_->node_list()) {
+    string subproperty_name;
+    ToLowerCase(subproperty->lhs()->c_str(), &subproperty_name);
+    if (subproperty_name == "class" || subproperty_name == "sstable_compression") {
+      RETURN_NOT_OK(GetStringValueFromExpr(subproperty->rhs(), true, subproperty_name,
+                                           &class_name));
+    } else if (subproperty_name == "enabled") {
+      RETURN_NOT_OK(GetBoolValueFromExpr(subproperty->rhs(), subproperty_name, &enabled));
+    }
+  }
+
+  // An empty 'sstable_compression' disables compression, as does 'enabled' : false.
+  if (!enabled || class_name.empty()) {
+    *compression = TableCompressionType::NO_COMPRESSION;
+    return Status::OK();
+  }
+
+  // Compressor classes may be given with their package name, e.g.
+  // 'org.apache.cassandra.io.compress.LZ4Compressor'.
+  const auto pos = class_name.rfind('.');
+  const auto iter = Compression::kClassCompressionTypes.find(
+      pos == string::npos ? class_name : class_name.substr(pos + 1));
+  if (iter == Compression::kClassCompressionTypes.end()) {
+    return STATUS(InvalidArgument, Substitute("Unsupported compression class $0", class_name));
+  }
+  *compression = iter->second;
   return Status::OK();
 }
 
@@ -780,6 +819,14 @@ const std::map<std::string, Compression::Subproperty> Compression::kSubpropertyD
     {"sstable_compression", Compression::Subproperty::kSstableCompression}
 };
 
+// ZstdCompressor is not accepted: RocksDB is built without ZSTD, so it would silently fall back to
+// snappy.
+const std::map<std::string, TableCompressionType> Compression::kClassCompressionTypes = {
+    {"DeflateCompressor",   TableCompressionType::ZLIB_COMPRESSION},
+    {"LZ4Compressor",       TableCompressionType::LZ4_COMPRESSION},
+    {"SnappyCompressor",    TableCompressionType::SNAPPY_COMPRESSION}
+};
+
 const std::map<std::string, Compaction::Subproperty> Compaction::kSubpropertyDataTypes = {
     {"base_time_seconds", Compaction::Subproperty::kBaseTimeSeconds},
     {"bucket_high", Compaction::Subproperty::kBucketHigh},
@@ -220,6 +220,9 @@ class PTTablePropertyMap : public PTTableProperty {
   Status AnalyzeCompression();
   Status AnalyzeTransactions();
 
+  // Returns the SSTable compression selected by the 'compression' property map in 'compression'.
+  Status GetCompressionType(TableCompressionType* compression) const;
+
   static const std::map<std::string, PTTablePropertyMap::PropertyMapType> kPropertyDataTypes;
   TreeListNode<PTTableProperty>::SharedPtr map_elements_;
 };
@@ -234,6 +237,9 @@ struct Compression {
   };
 
   static const std::map<std::string, Subproperty> kSubpropertyDataTypes;
+
+  // SSTable compression by compressor class name, without the package name.
+  static const std::map<std::string, TableCompressionType> kClassCompressionTypes;
 };
 
 struct Compaction {
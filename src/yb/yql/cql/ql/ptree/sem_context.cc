@@ -197,7 +197,7 @@ shared_ptr<YBTable> SemContext::GetTableDesc(const client::YBTableName& table_na
   bool cache_used = false;
   shared_ptr<YBTable> table = ql_env_->GetTableDesc(table_name, &cache_used);
   if (table != nullptr) {
-    parse_tree_->AddAnalyzedTable(table_name);
+    parse_tree_->AddAnalyzedTable(table_name, table);
     if (cache_used) {
       // Remember cache was used.
       cache_used_ = true;
@@ -210,7 +210,7 @@ shared_ptr<YBTable> SemContext::GetTableDesc(const TableId& table_id) {
   bool cache_used = false;
   shared_ptr<YBTable> table = ql_env_->GetTableDesc(table_id, &cache_used);
   if (table != nullptr) {
-    parse_tree_->AddAnalyzedTable(table->name());
+    parse_tree_->AddAnalyzedTable(table->name(), table);
     if (cache_used) {
       // Remember cache was used.
       cache_used_ = true;
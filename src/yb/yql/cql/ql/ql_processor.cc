@@ -18,6 +18,8 @@
 #include <memory>
 
 #include "yb/yql/cql/ql/statement.h"
+#include "yb/yql/cql/ql/ptree/pt_alter_table.h"
+#include "yb/yql/cql/ql/ptree/pt_drop.h"
 
 METRIC_DEFINE_histogram(
     server, handler_latency_yb_cqlserver_SQLProcessor_ParseRequest,
@@ -123,12 +125,14 @@ QLProcessor::QLProcessor(std::weak_ptr<rpc::Messenger> messenger, shared_ptr<YBC
                          shared_ptr<YBMetaDataCache> cache, QLMetrics* ql_metrics,
                          const server::ClockPtr& clock,
                          TransactionManagerProvider transaction_manager_provider,
-                         cqlserver::CQLRpcServerEnv* cql_rpcserver_env)
+                         cqlserver::CQLRpcServerEnv* cql_rpcserver_env,
+                         ParseTreeCache* parse_tree_cache)
     : ql_env_(messenger, client, cache, clock, std::move(transaction_manager_provider),
               cql_rpcserver_env),
       analyzer_(&ql_env_),
       executor_(&ql_env_, ql_metrics),
-      ql_metrics_(ql_metrics) {
+      ql_metrics_(ql_metrics),
+      parse_tree_cache_(parse_tree_cache) {
 }
 
 QLProcessor::~QLProcessor() {
@@ -181,27 +185,68 @@ void QLProcessor::ExecuteAsync(const string& ql_stmt, const ParseTree& parse_tre
   executor_.ExecuteAsync(ql_stmt, parse_tree, &params, std::move(cb));
 }
 
+Status QLProcessor::PrepareCached(const string& ql_stmt, ParseTree::SharedPtrConst* parse_tree,
+                                  const bool reparsed) {
+  ParseTree::UniPtr new_parse_tree;
+  if (parse_tree_cache_ == nullptr) {
+    RETURN_NOT_OK(Prepare(ql_stmt, &new_parse_tree, reparsed));
+    *parse_tree = std::move(new_parse_tree);
+    return Status::OK();
+  }
+
+  // A statement being reparsed because of stale metadata must not reuse the cached parse tree.
+  const string keyspace = ql_env_.CurrentKeyspace();
+  if (!reparsed) {
+    *parse_tree = parse_tree_cache_->Lookup(keyspace, ql_stmt, &ql_env_);
+    if (*parse_tree != nullptr) {
+      return Status::OK();
+    }
+  }
+  RETURN_NOT_OK(Prepare(ql_stmt, &new_parse_tree, reparsed, parse_tree_cache_->mem_tracker()));
+  *parse_tree = std::move(new_parse_tree);
+  parse_tree_cache_->Insert(keyspace, ql_stmt, *parse_tree);
+  return Status::OK();
+}
+
+void QLProcessor::InvalidateParseTreeCache(const ParseTree& parse_tree) {
+  const TreeNode* root = parse_tree.root().get();
+  if (root == nullptr) {
+    return;
+  }
+  if (root->opcode() == TreeNodeOpcode::kPTAlterTable) {
+    parse_tree_cache_->InvalidateTable(static_cast<const PTAlterTable*>(root)->yb_table_name());
+  } else if (root->opcode() == TreeNodeOpcode::kPTDropStmt) {
+    const PTDropStmt* drop_stmt = static_cast<const PTDropStmt*>(root);
+    if (drop_stmt->drop_type() == OBJECT_TABLE || drop_stmt->drop_type() == OBJECT_INDEX) {
+      parse_tree_cache_->InvalidateTable(drop_stmt->yb_table_name());
+    }
+  }
+}
+
 void QLProcessor::RunAsync(const string& ql_stmt, const StatementParameters& params,
                             StatementExecutedCallback cb, const bool reparsed) {
-  ParseTree::UniPtr parse_tree;
-  const Status s = Prepare(ql_stmt, &parse_tree, reparsed);
+  ParseTree::SharedPtrConst parse_tree;
+  const Status s = PrepareCached(ql_stmt, &parse_tree, reparsed);
   if (PREDICT_FALSE(!s.ok())) {
     return cb.Run(s, nullptr /* result */);
   }
-  const ParseTree* ptree = parse_tree.release();
-  ExecuteAsync(ql_stmt, *ptree, params,
+  ExecuteAsync(ql_stmt, *parse_tree, params,
                Bind(&QLProcessor::RunAsyncDone, Unretained(this), ql_stmt, Unretained(&params),
-                    Owned(ptree), cb));
+                    parse_tree, cb));
 }
 
 // RunAsync callback added to keep the parse tree in-scope while it is being run asynchronously.
 // When called, just forward the status and result to the actual callback cb.
 void QLProcessor::RunAsyncDone(const string& ql_stmt, const StatementParameters* params,
-                                const ParseTree *parse_tree, StatementExecutedCallback cb,
+                                const ParseTree::SharedPtrConst& parse_tree,
+                                StatementExecutedCallback cb,
                                 const Status& s, const ExecutedResult::SharedPtr& result) {
   if (s.IsQLError() && GetErrorCode(s) == ErrorCode::STALE_METADATA && !parse_tree->reparsed()) {
     return RunAsync(ql_stmt, *params, cb, true /* reparsed */);
   }
+  if (s.ok() && parse_tree_cache_ != nullptr) {
+    InvalidateParseTreeCache(*parse_tree);
+  }
   cb.Run(s, result);
 }
 
@@ -215,8 +260,8 @@ void QLProcessor::ExecuteBatch(const std::string& ql_stmt, const ParseTree& pars
 }
 
 void QLProcessor::RunBatch(const std::string& ql_stmt, const StatementParameters& params,
-                            ParseTree::UniPtr* parse_tree, bool reparsed) {
-  const Status s = Prepare(ql_stmt, parse_tree, reparsed);
+                            ParseTree::SharedPtrConst* parse_tree, bool reparsed) {
+  const Status s = PrepareCached(ql_stmt, parse_tree, reparsed);
   if (PREDICT_FALSE(!s.ok())) {
     return executor_.StatementExecuted(s);
   }
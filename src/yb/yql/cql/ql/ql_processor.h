@@ -23,6 +23,7 @@
 
 #include "yb/yql/cql/cqlserver/cql_rpcserver_env.h"
 
+#include "yb/yql/cql/ql/parse_tree_cache.h"
 #include "yb/yql/cql/ql/exec/executor.h"
 #include "yb/yql/cql/ql/parser/parser.h"
 #include "yb/yql/cql/ql/sem/analyzer.h"
@@ -66,7 +67,8 @@ class QLProcessor {
               QLMetrics* ql_metrics,
               const server::ClockPtr& clock,
               TransactionManagerProvider transaction_manager_provider,
-              cqlserver::CQLRpcServerEnv* cql_rpcserver_env = nullptr);
+              cqlserver::CQLRpcServerEnv* cql_rpcserver_env = nullptr,
+              ParseTreeCache* parse_tree_cache = nullptr);
   virtual ~QLProcessor();
 
   // Prepare a SQL statement (parse and analyze).
@@ -87,7 +89,7 @@ class QLProcessor {
   void ExecuteBatch(const std::string& ql_stmt, const ParseTree& parse_tree,
                     const StatementParameters& params);
   void RunBatch(const std::string& ql_stmt, const StatementParameters& params,
-                ParseTree::UniPtr* parse_tree, bool reparsed = false);
+                ParseTree::SharedPtrConst* parse_tree, bool reparsed = false);
   void ApplyBatch();
   void AbortBatch();
 
@@ -109,6 +111,9 @@ class QLProcessor {
   // SQL metrics.
   QLMetrics* const ql_metrics_;
 
+  // Server-wide cache of analyzed parse trees of unprepared statements (optional).
+  ParseTreeCache* const parse_tree_cache_;
+
  private:
   friend class QLTestBase;
 
@@ -119,8 +124,16 @@ class QLProcessor {
   // Semantically analyze a parse tree.
   CHECKED_STATUS Analyze(const string& ql_stmt, ParseTree::UniPtr* parse_tree);
 
+  // Prepare an unprepared statement to run. The parse tree is looked up in the parse tree cache
+  // first, and a newly analyzed one is added to the cache.
+  CHECKED_STATUS PrepareCached(const string& ql_stmt, ParseTree::SharedPtrConst* parse_tree,
+                               bool reparsed);
+
+  // Delete the cached parse trees that use the table altered or dropped by the given statement.
+  void InvalidateParseTreeCache(const ParseTree& parse_tree);
+
   void RunAsyncDone(const std::string& ql_stmt, const StatementParameters* params,
-                    const ParseTree *parse_tree, StatementExecutedCallback cb,
+                    const ParseTree::SharedPtrConst& parse_tree, StatementExecutedCallback cb,
                     const Status& s, const ExecutedResult::SharedPtr& result);
 };
 
@@ -15,6 +15,12 @@
 
 #include "yb/master/catalog_manager.h"
 #include "yb/master/master.h"
+#include "yb/rocksdb/db.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_peer.h"
+#include "yb/tserver/mini_tablet_server.h"
+#include "yb/tserver/tablet_server.h"
+#include "yb/tserver/ts_tablet_manager.h"
 #include "yb/yql/cql/ql/test/ql-test-base.h"
 
 namespace yb {
@@ -181,6 +187,59 @@ TEST_F(TestQLCreateTable, TestQLCreateTableWithTTL) {
   EXPECT_EQ(1000, properties_pb.default_time_to_live());
 }
 
+TEST_F(TestQLCreateTable, TestQLCreateTableWithCompression) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get an available processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("CREATE TABLE table_with_lz4 (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                      "compression = {'class' : 'org.apache.cassandra.io.compress.LZ4Compressor'};");
+  EXEC_VALID_STMT("CREATE TABLE table_without_compression (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                      "compression = {'sstable_compression' : ''};");
+  // This build of RocksDB has no ZSTD.
+  EXEC_INVALID_STMT("CREATE TABLE table_with_zstd (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                        "compression = {'class' : 'ZstdCompressor'};");
+  EXEC_INVALID_STMT("CREATE TABLE table_with_unknown (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                        "compression = {'class' : 'UnknownCompressor'};");
+
+  // Verify the compression was stored in syscatalog table.
+  master::CatalogManager *catalog_manager = cluster_->mini_master()->master()->catalog_manager();
+  const std::map<string, TableCompressionType> expected_compressions = {
+      {"table_with_lz4", TableCompressionType::LZ4_COMPRESSION},
+      {"table_without_compression", TableCompressionType::NO_COMPRESSION}
+  };
+  for (const auto& entry : expected_compressions) {
+    master::GetTableSchemaRequestPB request_pb;
+    master::GetTableSchemaResponsePB response_pb;
+    request_pb.mutable_table()->mutable_namespace_()->set_name(kDefaultKeyspaceName);
+    request_pb.mutable_table()->set_table_name(entry.first);
+    CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+    EXPECT_EQ(entry.second, response_pb.schema().table_properties().compression()) << entry.first;
+  }
+
+  // Verify the tablets opened RocksDB with the compression of their table.
+  const std::map<string, rocksdb::CompressionType> expected_rocksdb_compressions = {
+      {"table_with_lz4", rocksdb::kLZ4Compression},
+      {"table_without_compression", rocksdb::kNoCompression}
+  };
+  size_t num_checked_tablets = 0;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    std::vector<tablet::TabletPeerPtr> peers;
+    cluster_->mini_tablet_server(i)->server()->tablet_manager()->GetTabletPeers(&peers);
+    for (const auto& peer : peers) {
+      auto it = expected_rocksdb_compressions.find(peer->tablet_metadata()->table_name());
+      if (it == expected_rocksdb_compressions.end() || !peer->tablet()) {
+        continue;
+      }
+      EXPECT_EQ(it->second, peer->tablet()->TEST_db()->GetOptions().compression) << it->first;
+      ++num_checked_tablets;
+    }
+  }
+  EXPECT_GT(num_checked_tablets, 0);
+}
+
 TEST_F(TestQLCreateTable, TestQLCreateTableWithClusteringOrderBy) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
@@ -18,8 +18,17 @@
 
 #include "yb/yql/cql/ql/test/ql-test-base.h"
 
+#include "yb/yql/cql/ql/parse_tree_cache.h"
 #include "yb/yql/cql/ql/statement.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
+
+METRIC_DECLARE_entity(server);
+METRIC_DECLARE_counter(ql_parse_tree_cache_hits);
+METRIC_DECLARE_counter(ql_parse_tree_cache_misses);
+
+using namespace yb::size_literals;
 
 using std::string;
 using std::unique_ptr;
@@ -103,5 +112,63 @@ TEST_F(TestQLStatement, TestPKIndices) {
   LOG(INFO) << "Done.";
 }
 
+TEST_F(TestQLStatement, TestParseTreeCache) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  MetricRegistry registry;
+  scoped_refptr<MetricEntity> entity = METRIC_ENTITY_server.Instantiate(&registry, "test");
+  ParseTreeCache cache(1_MB, nullptr /* parent_mem_tracker */, entity);
+  auto hits = METRIC_ql_parse_tree_cache_hits.Instantiate(entity);
+  auto misses = METRIC_ql_parse_tree_cache_misses.Instantiate(entity);
+
+  // Get two processors sharing the cache and one without.
+  TestQLProcessor *processor = GetQLProcessor(&cache);
+  TestQLProcessor *processor2 = GetQLProcessor(&cache);
+  TestQLProcessor *ddl_processor = GetQLProcessor();
+
+  // DDL statements are not cached.
+  EXEC_VALID_STMT("create table t (h int primary key, c int);");
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(1, misses->value());
+
+  // DML statements are analyzed once and then shared by all processors.
+  EXEC_VALID_STMT("insert into t (h, c) values (1, 2);");
+  EXEC_VALID_STMT("select * from t where h = 1;");
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(3, misses->value());
+  CHECK_OK(processor2->Run("select * from t where h = 1;"));
+  EXPECT_EQ(1, hits->value());
+  ASSERT_EQ(1, processor2->row_block()->row_count());
+  EXPECT_EQ(2, processor2->row_block()->row(0).column(1).int32_value());
+
+  // The same statement in another keyspace is a different entry.
+  EXEC_VALID_STMT("create keyspace k;");
+  CHECK_OK(processor2->UseKeyspace("k"));
+  CHECK_OK(processor2->Run("create table t (h int primary key, c int, d int);"));
+  CHECK_OK(processor2->Run("select * from t where h = 1;"));
+  EXPECT_EQ(1, hits->value());
+  EXPECT_EQ(3, processor2->row_block()->schema().num_columns());
+  EXPECT_EQ(3, cache.size());
+
+  // ALTER TABLE deletes the statements on the altered table.
+  EXEC_VALID_STMT("alter table t add d int;");
+  EXPECT_EQ(1, cache.size());
+  EXEC_VALID_STMT("select * from t where h = 1;");
+  EXPECT_EQ(1, hits->value());
+  EXPECT_EQ(3, processor->row_block()->schema().num_columns());
+
+  // A schema change made without the cache is detected from the schema version.
+  CHECK_OK(ddl_processor->Run("alter table t drop d;"));
+  EXPECT_EQ(2, cache.size());
+  EXEC_VALID_STMT("select * from t where h = 1;");
+  EXPECT_EQ(1, hits->value());
+  EXPECT_EQ(2, processor->row_block()->schema().num_columns());
+  EXEC_VALID_STMT("select * from t where h = 1;");
+  EXPECT_EQ(2, hits->value());
+
+  LOG(INFO) << "Done.";
+}
+
 } // namespace ql
 } // namespace yb
@@ -59,13 +59,14 @@ static void CallUseKeyspace(const TestQLProcessor::UniPtr& processor, const stri
   ASSERT_OK(processor->UseKeyspace(keyspace_name));
 }
 
-TestQLProcessor *QLTestBase::GetQLProcessor() {
+TestQLProcessor *QLTestBase::GetQLProcessor(ParseTreeCache* parse_tree_cache) {
   if (client_ == nullptr) {
     CreateSimulatedCluster();
   }
 
   std::weak_ptr<rpc::Messenger> messenger;
-  ql_processors_.emplace_back(new TestQLProcessor(messenger, client_, metadata_cache_));
+  ql_processors_.emplace_back(
+      new TestQLProcessor(messenger, client_, metadata_cache_, parse_tree_cache));
   CallUseKeyspace(ql_processors_.back(), kDefaultKeyspaceName);
   return ql_processors_.back().get();
 }
@@ -93,9 +93,11 @@ class TestQLProcessor : public ClockHolder, public QLProcessor {
   // Constructors.
   TestQLProcessor(
       std::weak_ptr<rpc::Messenger> messenger, std::shared_ptr<client::YBClient> client,
-      std::shared_ptr<client::YBMetaDataCache> cache)
+      std::shared_ptr<client::YBMetaDataCache> cache,
+      ParseTreeCache* parse_tree_cache = nullptr)
       : QLProcessor(messenger, client, cache, nullptr /* ql_metrics */, clock_,
-                    TransactionManagerProvider()) { }
+                    TransactionManagerProvider(), nullptr /* cql_rpcserver_env */,
+                    parse_tree_cache) { }
   virtual ~TestQLProcessor() { }
 
   void RunAsyncDone(
@@ -194,8 +196,8 @@ class QLTestBase : public YBTest {
   // Create simulated cluster.
   void CreateSimulatedCluster(int num_tablet_servers = 1);
 
-  // Create ql processor.
-  TestQLProcessor *GetQLProcessor();
+  // Create ql processor, optionally sharing the given parse tree cache.
+  TestQLProcessor *GetQLProcessor(ParseTreeCache* parse_tree_cache = nullptr);
 
 
   //------------------------------------------------------------------------------------------------
@@ -44,6 +44,11 @@ DEFINE_uint64(redis_max_concurrent_commands, 1,
               "Max number of redis commands received from single connection, "
               "that could be processed concurrently");
 DEFINE_uint64(redis_max_batch, 500, "Max number of redis commands that forms batch");
+DEFINE_bool(redis_coalesce_pipelined_commands, true,
+            "Whether pipelined commands received from a connection while its calls are being "
+            "processed should be held in the read buffer and processed as one batch, instead of "
+            "as separate batches that wait in the queue. Writes of a batch are sent to each tablet "
+            "in a single write request.");
 DEFINE_int32(rpcz_max_redis_query_dump_size, 4_KB,
              "The maximum size of the Redis query string in the RPCZ dump.");
 DEFINE_uint64(redis_max_read_buffer_size, 128_MB,
@@ -97,11 +102,18 @@ Result<size_t> RedisConnectionContext::ProcessCalls(const rpc::ConnectionPtr& co
   // Do not form new call if we are in a middle of command.
   // It means that soon we should receive remaining data for this command and could wait.
   if (commands_in_batch_ > 0 && (end_of_batch_ == IoVecsFullSize(data) || read_buffer_full)) {
-    std::vector<char> call_data;
-    IoVecsToBuffer(data, begin_of_batch, end_of_batch_, &call_data);
-    RETURN_NOT_OK(HandleInboundCall(connection, commands_in_batch_, &call_data));
-    begin_of_batch = end_of_batch_;
-    commands_in_batch_ = 0;
+    if (FLAGS_redis_coalesce_pipelined_commands && !read_buffer_full &&
+        processing_limit_reached()) {
+      // The call would only wait in the queue, so keep the commands and form the call when one of
+      // the calls being processed completes, together with the commands received until then.
+      ParseReceivedWhenCallCompletes();
+    } else {
+      std::vector<char> call_data;
+      IoVecsToBuffer(data, begin_of_batch, end_of_batch_, &call_data);
+      RETURN_NOT_OK(HandleInboundCall(connection, commands_in_batch_, &call_data));
+      begin_of_batch = end_of_batch_;
+      commands_in_batch_ = 0;
+    }
   }
   parser.Consume(begin_of_batch);
   end_of_batch_ -= begin_of_batch;
@@ -44,6 +44,7 @@ DECLARE_uint64(redis_max_read_buffer_size);
 DECLARE_uint64(redis_max_queued_bytes);
 DECLARE_int64(redis_rpc_block_size);
 DECLARE_bool(redis_safe_batch);
+DECLARE_bool(redis_coalesce_pipelined_commands);
 DECLARE_bool(emulate_redis_responses);
 DECLARE_bool(enable_backpressure_mode_for_testing);
 DECLARE_int32(redis_service_yb_client_timeout_millis);
@@ -855,6 +856,56 @@ TEST_F_EX(TestRedisService, PipelinePartial, TestRedisServicePipelined) {
 
 namespace {
 
+class TestRedisServiceCoalescedPipeline : public TestRedisService {
+ public:
+  void SetUp() override {
+    FLAGS_redis_max_concurrent_commands = 1;
+    FLAGS_redis_coalesce_pipelined_commands = true;
+    TestRedisService::SetUp();
+  }
+};
+
+} // namespace
+
+// Sends pipelines in several parts, so that parts received while a previous part is being
+// processed are coalesced into one batch. Every key is written twice with a read in between and
+// read again at the end, so a reply or a write out of order results in a wrong response.
+TEST_F_EX(TestRedisService, CoalescedPipeline, TestRedisServiceCoalescedPipeline) {
+  constexpr int kRounds = 10;
+  for (int round = 0; round != kRounds; ++round) {
+    const std::string first = std::to_string(round * 2);
+    const std::string second = std::to_string(round * 2 + 1);
+    std::string command, response;
+    for (size_t i = 0; i != kPipelineKeys; ++i) {
+      command += yb::Format("set $0 $1\r\nget $0\r\nset $0 $2\r\n", i, first, second);
+      response += yb::Format("+OK\r\n$$$0\r\n$1\r\n+OK\r\n", first.length(), first);
+    }
+    for (size_t i = 0; i != kPipelineKeys; ++i) {
+      command += yb::Format("get $0\r\n", i);
+      response += yb::Format("$$$0\r\n$1\r\n", second.length(), second);
+    }
+    ASSERT_NO_FATALS(SendCommandAndExpectResponse(__LINE__, command, response, true /* partial */));
+  }
+
+  // Measure the throughput of write pipelines as deep as the ones of redis-benchmark -P 64.
+  constexpr size_t kPipelineDepth = 64;
+  constexpr int kPipelines = 500;
+  std::string command, response;
+  for (size_t i = 0; i != kPipelineDepth; ++i) {
+    command += yb::Format("set key$0 $1\r\n", i, ValueForKey(i));
+    response += "+OK\r\n";
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i != kPipelines; ++i) {
+    ASSERT_NO_FATALS(SendCommandAndExpectResponse(__LINE__, command, response));
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  LOG(INFO) << yb::Format("Pipelined writes: $0 ops/sec",
+                          kPipelineDepth * kPipelines / elapsed.count());
+}
+
+namespace {
+
 class BatchGenerator {
  public:
   explicit BatchGenerator(bool collisions) : collisions_(collisions), random_(293462970) {}